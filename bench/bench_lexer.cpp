@@ -0,0 +1,101 @@
+/**
+ * @file bench_lexer.cpp
+ * @brief Rendimiento del lexer (tokens/s y bytes/s) sobre distintos tipos de expresiones.
+ */
+
+#include "corpus.hpp"
+#include "parser/lexer.hpp"
+#include <benchmark/benchmark.h>
+
+namespace {
+
+constexpr std::size_t corpusSize = 256;
+
+/**
+ * @brief Registra bytes y tokens procesados para que Google Benchmark informe las tasas.
+ */
+void reportThroughput(benchmark::State& state, const std::vector<std::string>& corpus, std::size_t tokens) {
+    std::size_t bytes = 0;
+    for (const std::string& expression : corpus)
+    {
+        bytes += expression.size();
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    state.counters["tokens"] = benchmark::Counter(static_cast<double>(state.iterations() * tokens), benchmark::Counter::kIsRate);
+}
+
+template <typename Lex>
+void lexCorpus(benchmark::State& state, Lex lex) {
+    const std::vector<std::string> corpus = makeCorpus(static_cast<corpusKind>(state.range(0)), corpusSize);
+    std::size_t tokens = 0;
+    for (const std::string& expression : corpus)
+    {
+        tokens += tokenizeView(expression).size();
+    }
+
+    for (auto _ : state)
+    {
+        for (const std::string& expression : corpus)
+        {
+            benchmark::DoNotOptimize(lex(expression));
+        }
+    }
+    reportThroughput(state, corpus, tokens);
+}
+
+void BM_Tokenize(benchmark::State& state) {
+    lexCorpus(state, [](const std::string& expression) { return tokenize(expression); });
+}
+
+void BM_TokenizeView(benchmark::State& state) {
+    lexCorpus(state, [](const std::string& expression) { return tokenizeView(expression); });
+}
+
+void BM_TokenizeChecked(benchmark::State& state) {
+    lexCorpus(state, [](const std::string& expression) { return tokenizeChecked(expression); });
+}
+
+void BM_TokenizePacked(benchmark::State& state) {
+    lexCorpus(state, [](const std::string& expression) { return tokenizePacked(expression); });
+}
+
+/**
+ * @brief Una tecla en medio de una expresión larga: reanálisis incremental frente a completo.
+ */
+void BM_RelexKeystroke(benchmark::State& state) {
+    std::string expression = makeCorpus(corpusKind::Long, 1).front();
+    const std::size_t middle = expression.size() / 2;
+    std::string edited = expression;
+    edited.insert(middle, "1");
+    const lexResult previous = tokenizeChecked(expression);
+    const bool incremental = state.range(0) != 0;
+
+    for (auto _ : state)
+    {
+        if (incremental)
+        {
+            benchmark::DoNotOptimize(tokenizeIncremental(previous, edited, {middle, 0, 1}));
+        }
+        else
+        {
+            benchmark::DoNotOptimize(tokenizeChecked(edited));
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * edited.size()));
+}
+
+void corpusArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgName("corpus");
+    for (corpusKind kind : {corpusKind::Short, corpusKind::Long, corpusKind::NumberHeavy, corpusKind::IdentifierHeavy})
+    {
+        benchmark->Arg(static_cast<int>(kind));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_Tokenize)->Apply(corpusArguments);
+BENCHMARK(BM_TokenizeView)->Apply(corpusArguments);
+BENCHMARK(BM_TokenizeChecked)->Apply(corpusArguments);
+BENCHMARK(BM_TokenizePacked)->Apply(corpusArguments);
+BENCHMARK(BM_RelexKeystroke)->ArgName("incremental")->Arg(0)->Arg(1);
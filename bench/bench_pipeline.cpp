@@ -0,0 +1,538 @@
+/**
+ * @file bench_pipeline.cpp
+ * @brief Rendimiento de análisis, compilación y evaluación por familia de funciones.
+ */
+
+#include "corpus.hpp"
+#include "evaluator/bulk_compile.hpp"
+#include "evaluator/compiler.hpp"
+#include "evaluator/derivative.hpp"
+#include "evaluator/evaluator.hpp"
+#include "evaluator/expression_cache.hpp"
+#include "evaluator/jit.hpp"
+#include "evaluator/optimizer.hpp"
+#include "parser/lexer.hpp"
+#include "parser/parser.hpp"
+#include "tabulation/adaptive_sampler.hpp"
+#include "tabulation/grid.hpp"
+#include "tabulation/implicit_curve.hpp"
+#include "tabulation/lod_pyramid.hpp"
+#include "tabulation/root_finder.hpp"
+#include "tabulation/sweep.hpp"
+#include "tabulation/table_writer.hpp"
+#include "tabulation/tabulate.hpp"
+#include "tabulation/tile_cache.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/// Muestras por evaluación.
+constexpr std::size_t sampleCount = 1 << 16;
+
+/**
+ * @brief Una expresión representativa de cada familia de funciones.
+ */
+const char* const families[] = {
+    "3*x^3 - 2*x^2 + x - 7", // Polinomio
+    "sin(x)*cos(x) + tan(x/3)", // Trigonométricas
+    "ln(abs(x) + 1) + log(x*x + 2)", // Logaritmos
+    "atan(x) + asin(x/100) + acos(x/100)", // Trigonométricas inversas
+    "sqrt(abs(x)) + nroot(3, x) + x^0.5", // Raíces y potencias
+    "sec(x) + csc(x) + cot(x)", // Recíprocas
+};
+constexpr int familyCount = static_cast<int>(std::size(families));
+
+const char* const familyNames[] = {"polynomial", "trig", "log", "inverse_trig", "roots", "reciprocal"};
+
+std::vector<double> sampleColumn() {
+    std::vector<double> xs(sampleCount);
+    for (std::size_t i = 0; i < sampleCount; i++)
+    {
+        xs[i] = -50.0 + 100.0 * static_cast<double>(i) / static_cast<double>(sampleCount);
+    }
+    return xs;
+}
+
+void BM_Parse(benchmark::State& state) {
+    const std::vector<std::string> corpus = makeCorpus(static_cast<corpusKind>(state.range(0)), 256);
+    for (auto _ : state)
+    {
+        for (const std::string& expression : corpus)
+        {
+            benchmark::DoNotOptimize(parseExpression(expression));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+/**
+ * @brief Solo el parser, sobre tokens ya generados: tokenView frente a tokenStream.
+ */
+void BM_ParseTokens(benchmark::State& state) {
+    const std::vector<std::string> corpus = makeCorpus(static_cast<corpusKind>(state.range(0)), 256);
+    const bool packed = state.range(1) != 0;
+    std::vector<lexResult> views;
+    std::vector<packedLexResult> streams;
+    for (const std::string& expression : corpus)
+    {
+        views.push_back(tokenizeChecked(expression));
+        streams.push_back(tokenizePacked(expression));
+    }
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < corpus.size(); i++)
+        {
+            if (packed)
+            {
+                benchmark::DoNotOptimize(parseChecked(streams[i].tokens));
+            }
+            else
+            {
+                benchmark::DoNotOptimize(parseChecked(views[i].tokens));
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void BM_Compile(benchmark::State& state) {
+    const std::vector<std::string> corpus = makeCorpus(static_cast<corpusKind>(state.range(0)), 256);
+    std::vector<syntaxTree> trees;
+    for (const std::string& expression : corpus)
+    {
+        trees.push_back(parseExpression(expression));
+    }
+    for (auto _ : state)
+    {
+        for (const syntaxTree& tree : trees)
+        {
+            benchmark::DoNotOptimize(compile(optimize(tree)));
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * trees.size()));
+}
+
+/**
+ * @brief Compilar todo el corpus: en paralelo con compileBatch o una por una.
+ */
+void BM_CompileBatch(benchmark::State& state) {
+    const std::vector<std::string> corpus = makeCorpus(static_cast<corpusKind>(state.range(0)), 1024);
+    const bool parallel = state.range(1) != 0;
+    for (auto _ : state)
+    {
+        if (parallel)
+        {
+            benchmark::DoNotOptimize(compileBatch(std::span<const std::string>(corpus)));
+        }
+        else
+        {
+            for (const std::string& expression : corpus)
+            {
+                benchmark::DoNotOptimize(compileExpression(expression));
+            }
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * corpus.size()));
+}
+
+void BM_CacheHit(benchmark::State& state) {
+    expressionCache cache;
+    const std::string expression = families[1];
+    cache.get(expression);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache.get(expression));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+/**
+ * @brief Evaluación por lotes de una familia con una tabla de núcleos concreta.
+ */
+void BM_Evaluate(benchmark::State& state) {
+    const kernelTable* kernels = kernelsFor(static_cast<simdLevel>(state.range(1)));
+    if (kernels == nullptr)
+    {
+        state.SkipWithError("Conjunto de instrucciones no disponible");
+        return;
+    }
+    const bytecodeProgram program = compileExpression(families[state.range(0)]);
+    const std::vector<double> xs = sampleColumn();
+    std::vector<double> ys(sampleCount);
+    variableInputs inputs;
+    inputs.x = xs;
+
+    for (auto _ : state)
+    {
+        evaluateBatch(program, inputs, ys, *kernels);
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * sampleCount));
+    state.SetLabel(std::string(familyNames[state.range(0)]) + "/" + kernels->name);
+}
+
+/**
+ * @brief Valor y derivada de una familia: diferencias centrales (tres evaluaciones) frente a una pasada con duales.
+ */
+void BM_EvaluateDerivative(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[state.range(0)]);
+    const bool dual = state.range(1) != 0;
+    const std::vector<double> xs = sampleColumn();
+    std::vector<double> ys(sampleCount), slopes(sampleCount);
+    std::vector<double> shifted(sampleCount), above(sampleCount), below(sampleCount);
+    variableInputs inputs;
+    inputs.x = xs;
+
+    for (auto _ : state)
+    {
+        if (dual)
+        {
+            evaluateDerivative(program, inputs, 0, ys, slopes);
+        }
+        else
+        {
+            evaluateBatch(program, inputs, ys);
+            for (std::size_t i = 0; i < sampleCount; i++)
+            {
+                shifted[i] = xs[i] + 1e-6;
+            }
+            evaluateBatch(program, {shifted, {}, {}}, above);
+            for (std::size_t i = 0; i < sampleCount; i++)
+            {
+                shifted[i] = xs[i] - 1e-6;
+            }
+            evaluateBatch(program, {shifted, {}, {}}, below);
+            for (std::size_t i = 0; i < sampleCount; i++)
+            {
+                slopes[i] = (above[i] - below[i]) / 2e-6;
+            }
+        }
+        benchmark::DoNotOptimize(slopes.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * sampleCount));
+    state.SetLabel(familyNames[state.range(0)]);
+}
+
+void evaluateArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"family", "simd"});
+    for (int family = 0; family < familyCount; family++)
+    {
+        for (simdLevel level : {simdLevel::Scalar, simdLevel::SSE2, simdLevel::AVX2, simdLevel::AVX512, simdLevel::NEON})
+        {
+            if (kernelsFor(level) != nullptr)
+            {
+                benchmark->Args({family, static_cast<int>(level)});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Intérprete (jit = 0) frente a código nativo (jit = 1, si se compiló con PLOTSYS_JIT).
+ */
+void BM_EvaluateJit(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[state.range(0)]);
+    const std::vector<double> xs = sampleColumn();
+    std::vector<double> ys(sampleCount);
+    variableInputs inputs;
+    inputs.x = xs;
+    const jitProgram native(program);
+    const bool useJit = state.range(1) != 0;
+    if (useJit && !native.isNative())
+    {
+        state.SkipWithError("JIT no disponible (compilar con -DPLOTSYS_JIT=ON)");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        if (useJit)
+        {
+            native.evaluate(inputs, ys);
+        }
+        else
+        {
+            evaluateBatch(program, inputs, ys);
+        }
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * sampleCount));
+    state.SetLabel(familyNames[state.range(0)]);
+}
+
+void BM_TabulateParallel(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[1]);
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<double> xs(count), ys(count);
+    for (auto _ : state)
+    {
+        tabulateParallel(program, {-50.0, 50.0, count}, xs, ys);
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void BM_SampleAdaptive(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[state.range(0)]);
+    samplingOptions options{100.0 / 1920.0, 20.0 / 1080.0};
+    options.derivatives = state.range(1) != 0;
+    std::size_t points = 0;
+    for (auto _ : state)
+    {
+        std::vector<plotPoint> result = sampleAdaptive(program, -50.0, 50.0, options);
+        points = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["points"] = static_cast<double>(points);
+    state.SetLabel(familyNames[state.range(0)]);
+}
+
+/**
+ * @brief Desplazamiento de la vista de a un píxel: la caché de tiles frente a tabular todo.
+ */
+void BM_PanView(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[1]);
+    const bool cached = state.range(0) != 0;
+    tileCache tiles(program);
+    constexpr std::size_t pixels = 1920;
+    std::vector<double> xs(pixels), ys(pixels);
+    double start = -10.0;
+
+    for (auto _ : state)
+    {
+        start += 20.0 / pixels;
+        if (cached)
+        {
+            benchmark::DoNotOptimize(tiles.view(start, start + 20.0, pixels));
+        }
+        else
+        {
+            tabulate(program, {start, start + 20.0, pixels}, xs, ys);
+            benchmark::DoNotOptimize(ys.data());
+        }
+    }
+}
+
+/**
+ * @brief Malla cuadrada de f(x, y) por tiles, frente a evaluar la malla entera como dos columnas.
+ */
+void BM_TabulateGrid(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression("sin(x) * cos(y) + x * y / 10");
+    const std::size_t side = static_cast<std::size_t>(state.range(0));
+    const bool tiled = state.range(1) != 0;
+    const sampleRange axis{-10.0, 10.0, side};
+    std::vector<double> values(side * side);
+    std::vector<double> xs, ys;
+    for (auto _ : state)
+    {
+        if (tiled)
+        {
+            tabulateGrid(program, axis, axis, values);
+        }
+        else
+        {
+            xs.resize(side * side);
+            ys.resize(side * side);
+            for (std::size_t j = 0; j < side; j++)
+            {
+                for (std::size_t i = 0; i < side; i++)
+                {
+                    xs[j * side + i] = axis.at(i);
+                    ys[j * side + i] = axis.at(j);
+                }
+            }
+            evaluateBatch(program, {xs, ys, {}}, values);
+        }
+        benchmark::DoNotOptimize(values.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * side * side));
+}
+
+/**
+ * @brief Celdas de una curva implícita: malla densa contra quadtree con intervalos.
+ */
+void BM_ImplicitCurve(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression("sin(x) * cos(y) + x * y / 10 - 0.5");
+    const std::size_t side = static_cast<std::size_t>(state.range(0));
+    const bool pruned = state.range(1) != 0;
+    const sampleRange axis{-10.0, 10.0, side + 1};
+    std::vector<double> values((side + 1) * (side + 1));
+    for (auto _ : state)
+    {
+        if (pruned)
+        {
+            curveMask mask = locateImplicitCurve(program, -10.0, 10.0, -10.0, 10.0, side, side);
+            benchmark::DoNotOptimize(mask.cells.data());
+        }
+        else
+        {
+            tabulateGrid(program, axis, axis, values); // Esquinas de las celdas, para marching squares
+            benchmark::DoNotOptimize(values.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * side * side));
+}
+
+/**
+ * @brief Raíces y extremos de un lote de funciones oscilantes por encierros refinados en lote.
+ */
+void BM_FindCriticalPoints(benchmark::State& state) {
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<bytecodeProgram> programs;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        programs.push_back(compileExpression("sin(" + std::to_string(1 + i % 17) + " * x) + 0.3 * cos(x * " + std::to_string(2 + i % 5) + ")"));
+    }
+    std::size_t points = 0;
+    for (auto _ : state)
+    {
+        points = 0;
+        for (const std::vector<criticalPoint>& found : findCriticalPoints(std::span<const bytecodeProgram>(programs), -10.0, 10.0))
+        {
+            points += found.size();
+        }
+    }
+    state.counters["points"] = static_cast<double>(points);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+/**
+ * @brief Barrido de 64 cuadros de un parámetro, elevando lo que no depende de x
+ *        frente a evaluar cada cuadro con la columna del parámetro llena.
+ */
+void BM_ParameterSweep(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression("sin(y) * x^2 + cos(y^2) * x + sqrt(y^2 + 1) * log(y^2 + 2)");
+    const bool hoisted = state.range(0) != 0;
+    constexpr std::size_t frames = 64;
+    const sampleRange x{-10.0, 10.0, 1 << 16};
+    std::vector<double> parameters(frames);
+    for (std::size_t k = 0; k < frames; k++)
+    {
+        parameters[k] = 0.1 * static_cast<double>(k);
+    }
+    std::vector<double> output(frames * x.count);
+    std::vector<double> xs(x.count);
+    std::vector<double> ys(x.count);
+    for (std::size_t i = 0; i < x.count; i++)
+    {
+        xs[i] = x.at(i);
+    }
+    for (auto _ : state)
+    {
+        if (hoisted)
+        {
+            sweepParameter(program, 1, parameters, x, output);
+        }
+        else
+        {
+            for (std::size_t k = 0; k < frames; k++)
+            {
+                std::fill(ys.begin(), ys.end(), parameters[k]);
+                evaluateBatch(program, {xs, ys, {}}, std::span<double>(output).subspan(k * x.count, x.count));
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * frames * x.count));
+}
+
+/**
+ * @brief Envolvente de 2048 píxeles sobre una tabla de 2^24 muestras, con la
+ *        pirámide frente a recorrer todas las muestras de cada píxel.
+ */
+void BM_LodEnvelopes(benchmark::State& state) {
+    const bool pyramid = state.range(0) != 0;
+    const sampleRange range{-1000.0, 1000.0, 1 << 24};
+    const functionTable table = tabulate(compileExpression(families[1]), range);
+    lodPyramid levels;
+    levels.append(table.y);
+    std::vector<sampleEnvelope> pixels(2048);
+    for (auto _ : state)
+    {
+        if (pyramid)
+        {
+            levels.envelopes(0, range.count, pixels, table.y);
+        }
+        else
+        {
+            for (std::size_t p = 0; p < pixels.size(); p++)
+            {
+                const std::size_t begin = p * range.count / pixels.size();
+                const std::size_t end = (p + 1) * range.count / pixels.size();
+                const auto [lo, hi] = std::minmax_element(table.y.begin() + begin, table.y.begin() + end);
+                pixels[p] = {*lo, *hi};
+            }
+        }
+        benchmark::DoNotOptimize(pixels.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * pixels.size()));
+}
+
+/**
+ * @brief Una familia evaluada en double (precision = 0), Single (1) y Fast (2).
+ */
+void BM_EvaluatePrecision(benchmark::State& state) {
+    bytecodeProgram program = compileExpression(families[state.range(0)]);
+    program.precision = static_cast<evaluationPrecision>(state.range(1));
+    const std::vector<double> xs = sampleColumn();
+    std::vector<double> ys(sampleCount);
+    variableInputs inputs;
+    inputs.x = xs;
+
+    for (auto _ : state)
+    {
+        evaluateBatch(program, inputs, ys);
+        benchmark::DoNotOptimize(ys.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * sampleCount));
+    state.SetLabel(familyNames[state.range(0)]);
+}
+
+/**
+ * @brief Escritura de una tabla completa en /dev/null, en CSV o binario.
+ */
+void BM_WriteTable(benchmark::State& state) {
+    const bytecodeProgram program = compileExpression(families[1]);
+    const tableFormat format = state.range(0) != 0 ? tableFormat::Binary : tableFormat::CSV;
+    constexpr std::size_t count = 1 << 20;
+    const int descriptor = open("/dev/null", O_WRONLY);
+    for (auto _ : state)
+    {
+        writeTable(program, {-50.0, 50.0, count}, format, descriptor);
+    }
+    close(descriptor);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+
+void corpusArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgName("corpus");
+    for (corpusKind kind : {corpusKind::Short, corpusKind::Long, corpusKind::NumberHeavy, corpusKind::IdentifierHeavy})
+    {
+        benchmark->Arg(static_cast<int>(kind));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_Parse)->Apply(corpusArguments);
+BENCHMARK(BM_ParseTokens)->ArgNames({"corpus", "packed"})->ArgsProduct({benchmark::CreateDenseRange(0, 3, 1), {0, 1}});
+BENCHMARK(BM_Compile)->Apply(corpusArguments);
+BENCHMARK(BM_CompileBatch)->ArgNames({"corpus", "parallel"})->ArgsProduct({{0, 1}, {0, 1}})->UseRealTime();
+BENCHMARK(BM_CacheHit);
+BENCHMARK(BM_Evaluate)->Apply(evaluateArguments);
+BENCHMARK(BM_EvaluateDerivative)->ArgNames({"family", "dual"})->ArgsProduct({benchmark::CreateDenseRange(0, familyCount - 1, 1), {0, 1}});
+BENCHMARK(BM_EvaluateJit)->ArgNames({"family", "jit"})->ArgsProduct({benchmark::CreateDenseRange(0, familyCount - 1, 1), {0, 1}});
+BENCHMARK(BM_TabulateParallel)->Arg(1 << 16)->Arg(1 << 20)->UseRealTime();
+BENCHMARK(BM_SampleAdaptive)->ArgNames({"family", "derivatives"})->ArgsProduct({benchmark::CreateDenseRange(0, familyCount - 1, 1), {0, 1}});
+BENCHMARK(BM_PanView)->ArgName("cached")->Arg(0)->Arg(1);
+BENCHMARK(BM_TabulateGrid)->ArgNames({"side", "tiled"})->ArgsProduct({{1024, 4096}, {0, 1}})->UseRealTime();
+BENCHMARK(BM_ImplicitCurve)->ArgNames({"side", "pruned"})->ArgsProduct({{1024, 4096}, {0, 1}})->UseRealTime();
+BENCHMARK(BM_FindCriticalPoints)->ArgName("functions")->Arg(16)->Arg(1024)->UseRealTime();
+BENCHMARK(BM_ParameterSweep)->ArgName("hoisted")->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(BM_LodEnvelopes)->ArgName("pyramid")->Arg(0)->Arg(1);
+BENCHMARK(BM_EvaluatePrecision)->ArgNames({"family", "precision"})->ArgsProduct({benchmark::CreateDenseRange(0, familyCount - 1, 1), {0, 1, 2}});
+BENCHMARK(BM_WriteTable)->ArgName("binary")->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,79 @@
+/**
+ * @file corpus.hpp
+ * @brief Expresiones de prueba para los benchmarks, generadas de forma reproducible.
+ */
+#ifndef CORPUS_HPP
+#define CORPUS_HPP
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @enum corpusKind
+ * @brief Tipos de conjunto de expresiones.
+ */
+enum class corpusKind {
+    Short, ///< Expresiones cortas típicas escritas a mano
+    Long, ///< Polinomios y sumas largas (cientos de tokens)
+    NumberHeavy, ///< Mayoría de literales, con decimales y notación científica
+    IdentifierHeavy, ///< Funciones anidadas, constantes y variables
+};
+
+/**
+ * @brief Genera count expresiones válidas del tipo pedido (siempre las mismas).
+ */
+inline std::vector<std::string> makeCorpus(corpusKind kind, std::size_t count) {
+    static const char* shortExpressions[] = {
+        "sin(x)", "x^2 + 1", "cos(2*pi*x)", "ln(abs(x) + 1)", "sqrt(x^2 + y^2)",
+        "tan(x) / x", "e^(-x^2)", "log_base(2, x)", "nroot(3, x) - 1", "x % 3",
+    };
+    static const char* functions[] = {"sin", "cos", "tan", "sec", "csc", "cot", "asin", "acos", "atan", "ln", "log", "sqrt", "abs"};
+    static const char* atoms[] = {"x", "y", "z", "pi", "e"};
+
+    std::mt19937 random(12345);
+    std::vector<std::string> corpus;
+    corpus.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::string expression;
+        switch (kind)
+        {
+        case corpusKind::Short:
+            expression = shortExpressions[i % std::size(shortExpressions)];
+            break;
+        case corpusKind::Long:
+            for (int term = 0; term < 40; term++)
+            {
+                expression += term == 0 ? "" : (random() % 2 ? " + " : " - ");
+                expression += std::to_string(random() % 100) + "*x^" + std::to_string(term % 7);
+            }
+            break;
+        case corpusKind::NumberHeavy:
+            for (int term = 0; term < 24; term++)
+            {
+                expression += term == 0 ? "" : " + ";
+                expression += std::to_string(random() % 1000) + "." + std::to_string(random() % 100000);
+                if (term % 3 == 0)
+                {
+                    expression += "e-" + std::to_string(random() % 20);
+                }
+            }
+            break;
+        case corpusKind::IdentifierHeavy:
+            for (int term = 0; term < 8; term++)
+            {
+                expression += term == 0 ? "" : " * ";
+                expression += std::string(functions[random() % std::size(functions)]) + "(";
+                expression += std::string(functions[random() % std::size(functions)]) + "(";
+                expression += std::string(atoms[random() % std::size(atoms)]) + " + " + atoms[random() % std::size(atoms)] + "))";
+            }
+            break;
+        }
+        corpus.push_back(std::move(expression));
+    }
+    return corpus;
+}
+
+#endif // CORPUS_HPP
@@ -0,0 +1,42 @@
+/**
+ * @file bulk_compile.cpp
+ * @brief Implementación de la compilación en paralelo.
+ */
+
+#include "bulk_compile.hpp"
+#include "../support/arena.hpp"
+#include <algorithm>
+
+namespace {
+
+/// Expresiones por tarea: suficientes para que repartir cueste poco frente a compilar.
+constexpr std::size_t expressionsPerTask = 16;
+
+/// Bytes de la arena de cada tarea, que se reutiliza entre sus expresiones.
+constexpr std::size_t taskArenaBytes = 32 * 1024;
+
+template <typename text>
+std::vector<compiledExpression> compileAll(std::span<const text> expressions, threadPool& pool) {
+    std::vector<compiledExpression> results(expressions.size());
+    const std::size_t tasks = (expressions.size() + expressionsPerTask - 1) / expressionsPerTask;
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        scratchArena<taskArenaBytes> arena;
+        const std::size_t end = std::min(expressions.size(), (task + 1) * expressionsPerTask);
+        for (std::size_t i = task * expressionsPerTask; i < end; i++)
+        {
+            results[i] = compileExpressionChecked(expressions[i], arena.get());
+            arena.reset();
+        }
+    });
+    return results;
+}
+
+} // namespace
+
+std::vector<compiledExpression> compileBatch(std::span<const std::string_view> expressions, threadPool& pool) {
+    return compileAll(expressions, pool);
+}
+
+std::vector<compiledExpression> compileBatch(std::span<const std::string> expressions, threadPool& pool) {
+    return compileAll(expressions, pool);
+}
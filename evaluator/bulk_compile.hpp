@@ -0,0 +1,34 @@
+/**
+ * @file bulk_compile.hpp
+ * @brief Compilación en paralelo de muchas expresiones a la vez.
+ *
+ * Las tablas del lexer (keywordTable, charClassTable) son constantes de
+ * tiempo de compilación y cada compilación usa solo su propia arena, así que
+ * las expresiones se compilan en los hilos del grupo sin ningún estado
+ * compartido ni cerrojos.
+ */
+#ifndef BULK_COMPILE_HPP
+#define BULK_COMPILE_HPP
+
+#include "compiler.hpp"
+#include "../support/thread_pool.hpp"
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Compila todas las expresiones en paralelo.
+ *
+ * @param expressions Expresiones a compilar.
+ * @param pool Grupo de hilos a usar.
+ * @return std::vector<compiledExpression> Un resultado por expresión, en el mismo orden.
+ */
+std::vector<compiledExpression> compileBatch(std::span<const std::string_view> expressions, threadPool& pool = threadPool::shared());
+
+/**
+ * @brief Igual que la versión con std::string_view, para listas de std::string.
+ */
+std::vector<compiledExpression> compileBatch(std::span<const std::string> expressions, threadPool& pool = threadPool::shared());
+
+#endif // BULK_COMPILE_HPP
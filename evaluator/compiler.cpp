@@ -0,0 +1,214 @@
+/**
+ * @file compiler.cpp
+ * @brief Implementación del compilador de árbol sintáctico a bytecode.
+ *
+ * Recorre los nodos en postorden (el orden en que ya están guardados) y
+ * asigna a cada uno un registro. Se calcula de antemano el último uso de
+ * cada nodo para liberar su registro y reutilizarlo, de modo que el
+ * evaluador por lotes necesite pocas columnas de memoria intermedia.
+ */
+
+#include "compiler.hpp"
+#include "optimizer.hpp"
+#include "../parser/parser.hpp"
+#include "../support/arena.hpp"
+#include "../support/metrics.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+/// Bytes de la arena en la pila de compileExpression; alcanza para expresiones de miles de caracteres.
+constexpr std::size_t compileArenaBytes = 32 * 1024;
+
+constexpr std::uint32_t noUse = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * @brief Clave de una constante según sus bits, para distinguir 0.0 de -0.0.
+ */
+std::uint64_t constantKey(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    return bits;
+}
+
+std::uint16_t checkedRegister(std::size_t index) {
+    if (index > std::numeric_limits<std::uint16_t>::max())
+    {
+        throw std::runtime_error("[Compiler Error]: La expresión necesita demasiados registros.");
+    }
+    return static_cast<std::uint16_t>(index);
+}
+
+} // namespace
+
+/**
+ * @brief Compila un árbol sintáctico a un programa de registros.
+ *
+ * @param tree Árbol plano en postorden producido por el parser.
+ * @param scratch Memoria para las tablas auxiliares.
+ * @return bytecodeProgram Programa listo para evaluar.
+ */
+bytecodeProgram compile(const syntaxTree& tree, std::pmr::memory_resource* scratch) {
+    stageTimer timer(metricStage::Compile);
+    bytecodeProgram program;
+    const std::pmr::vector<astNode>& nodes = tree.nodes;
+    if (nodes.empty())
+    {
+        program.constants.push_back(0.0);
+        program.result = variableRegisterCount;
+        program.registerCount = program.firstTemporary();
+        return program;
+    }
+
+    // Primera pasada: constantes (deduplicadas), variables y último uso de cada nodo.
+    std::pmr::vector<std::uint32_t> lastUse(nodes.size(), noUse, scratch);
+    std::pmr::unordered_map<std::uint64_t, std::uint16_t> constantRegisters(scratch);
+    std::pmr::vector<std::uint16_t> location(nodes.size(), 0, scratch);
+
+    // Reserva exacta del programa: sus dos listas son las únicas que sobreviven a la compilación.
+    std::size_t constantNodes = 0;
+    std::size_t operationNodes = 0;
+    for (const astNode& node : nodes)
+    {
+        constantNodes += node.op == opCode::Constant;
+        operationNodes += operandCount(node.op) > 0;
+    }
+    program.constants.reserve(constantNodes);
+    program.code.reserve(operationNodes);
+
+    for (std::uint32_t i = 0; i < nodes.size(); i++)
+    {
+        const astNode& node = nodes[i];
+        int operands = operandCount(node.op);
+        if (operands >= 1)
+        {
+            lastUse[node.left] = i;
+        }
+        if (operands == 2)
+        {
+            lastUse[node.right] = i;
+        }
+
+        if (node.op == opCode::Constant)
+        {
+            auto found = constantRegisters.find(constantKey(node.value));
+            if (found == constantRegisters.end())
+            {
+                std::uint16_t reg = checkedRegister(variableRegisterCount + program.constants.size());
+                program.constants.push_back(node.value);
+                found = constantRegisters.emplace(constantKey(node.value), reg).first;
+            }
+            location[i] = found->second;
+        }
+        else if (node.op == opCode::Variable)
+        {
+            location[i] = node.variable;
+            program.variableMask |= static_cast<std::uint8_t>(1u << node.variable);
+        }
+    }
+
+    // Segunda pasada: una instrucción por operación, reutilizando registros libres.
+    std::uint16_t firstTemporary = program.firstTemporary();
+    std::uint32_t nextTemporary = firstTemporary;
+    std::pmr::vector<std::uint16_t> freeRegisters(scratch);
+
+    auto release = [&](std::uint32_t operand, std::uint32_t user) {
+        if (lastUse[operand] == user && location[operand] >= firstTemporary)
+        {
+            freeRegisters.push_back(location[operand]);
+            lastUse[operand] = noUse; // Evita liberarlo dos veces si ambos operandos coinciden
+        }
+    };
+
+    for (std::uint32_t i = 0; i < nodes.size(); i++)
+    {
+        const astNode& node = nodes[i];
+        int operands = operandCount(node.op);
+        if (operands == 0)
+        {
+            continue;
+        }
+
+        std::uint16_t left = location[node.left];
+        std::uint16_t right = operands == 2 ? location[node.right] : 0;
+
+        // Los operandos que mueren aquí liberan su registro antes de elegir el destino:
+        // las operaciones trabajan elemento a elemento, así que escribir encima es seguro.
+        release(node.left, i);
+        if (operands == 2)
+        {
+            release(node.right, i);
+        }
+
+        std::uint16_t target;
+        if (!freeRegisters.empty())
+        {
+            target = freeRegisters.back();
+            freeRegisters.pop_back();
+        }
+        else
+        {
+            target = checkedRegister(nextTemporary++);
+        }
+
+        location[i] = target;
+        program.code.push_back({node.op, target, left, right});
+    }
+
+    program.result = location[tree.root];
+    program.registerCount = checkedRegister(nextTemporary);
+    return program;
+}
+
+/**
+ * @brief Analiza y compila una expresión en un solo paso.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param scratch Arena para los datos temporales (nullptr = arena interna).
+ * @return bytecodeProgram Programa listo para evaluar.
+ */
+bytecodeProgram compileExpression(std::string_view expression, std::pmr::memory_resource* scratch) {
+    if (scratch == nullptr)
+    {
+        scratchArena<compileArenaBytes> arena;
+        return compileExpression(expression, arena.get());
+    }
+    syntaxTree tree = parseExpression(expression, scratch);
+    return compile(optimize(tree, scratch), scratch);
+}
+
+/**
+ * @brief Analiza y compila una expresión informando los errores sin excepciones.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param scratch Arena para los datos temporales (nullptr = arena interna).
+ * @return compiledExpression Programa o errores de la expresión.
+ */
+compiledExpression compileExpressionChecked(std::string_view expression, std::pmr::memory_resource* scratch) {
+    if (scratch == nullptr)
+    {
+        scratchArena<compileArenaBytes> arena;
+        return compileExpressionChecked(expression, arena.get());
+    }
+
+    compiledExpression result;
+    parseResult parsed = parseExpressionChecked(expression, scratch);
+    if (!parsed.ok())
+    {
+        result.diagnostics.assign(parsed.diagnostics.begin(), parsed.diagnostics.end());
+        result.error = diagnosticMessage(parsed.diagnostics.front().kind);
+        return result;
+    }
+    try
+    {
+        result.program = compile(optimize(parsed.tree, scratch), scratch);
+    }
+    catch (const std::runtime_error& failure)
+    {
+        result.error = failure.what();
+    }
+    return result;
+}
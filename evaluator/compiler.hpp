@@ -0,0 +1,74 @@
+/**
+ * @file compiler.hpp
+ * @brief Traducción del árbol sintáctico plano a bytecode de registros.
+ */
+#ifndef COMPILER_HPP
+#define COMPILER_HPP
+
+#include "program.hpp"
+#include "../parser/ast.hpp"
+#include "../parser/diagnostic.hpp"
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Compila un árbol sintáctico a un programa de registros.
+ *
+ * Las constantes repetidas comparten registro y los registros intermedios
+ * se reutilizan en cuanto su valor deja de necesitarse.
+ *
+ * @param tree Árbol plano en postorden producido por el parser o por optimize().
+ * @param scratch Memoria para las tablas auxiliares (el programa usa el asignador normal).
+ * @return bytecodeProgram Programa listo para evaluar.
+ * @throws std::runtime_error Si la expresión necesita más registros de los soportados.
+ */
+bytecodeProgram compile(const syntaxTree& tree, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+/**
+ * @brief Analiza, simplifica (ver optimize()) y compila una expresión en un solo paso.
+ *
+ * Tokens, nodos y tablas auxiliares viven en una arena: en scratch si se
+ * indica, o si no en una arena en la pila que solo recurre al asignador
+ * global para expresiones muy largas. Así, en general, las únicas reservas
+ * de memoria son las del programa resultante.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param scratch Arena para los datos temporales (nullptr = arena interna).
+ * @return bytecodeProgram Programa listo para evaluar.
+ * @throws std::runtime_error Si la expresión tiene errores léxicos o sintácticos.
+ */
+bytecodeProgram compileExpression(std::string_view expression, std::pmr::memory_resource* scratch = nullptr);
+
+/**
+ * @struct compiledExpression
+ * @brief Resultado de compilar una expresión sin excepciones.
+ */
+struct compiledExpression {
+    std::optional<bytecodeProgram> program; ///< Programa, si la expresión es válida
+    std::vector<diagnostic> diagnostics; ///< Errores léxicos o sintácticos con su ubicación
+    std::string error; ///< Mensaje del primer error; vacío si compiló
+
+    /**
+     * @brief Indica si la expresión compiló.
+     */
+    bool ok() const { return program.has_value(); }
+};
+
+/**
+ * @brief Igual que compileExpression, pero informa los errores en lugar de lanzarlos.
+ *
+ * Los diagnósticos son los de parseExpressionChecked(): todos los errores
+ * léxicos o, si no los hay, el primer error sintáctico. Si la expresión es
+ * válida pero no se puede compilar (demasiados registros), diagnostics queda
+ * vacío y error tiene el mensaje del compilador.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param scratch Arena para los datos temporales (nullptr = arena interna).
+ * @return compiledExpression Programa o errores de la expresión.
+ */
+compiledExpression compileExpressionChecked(std::string_view expression, std::pmr::memory_resource* scratch = nullptr);
+
+#endif // COMPILER_HPP
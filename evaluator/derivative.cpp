@@ -0,0 +1,450 @@
+/**
+ * @file derivative.cpp
+ * @brief Implementación de la diferenciación automática por columnas.
+ *
+ * Igual que en evaluator.cpp, cada registro es una columna de
+ * evaluationChunk valores, ahora acompañada de una columna de derivadas. Las
+ * funciones auxiliares de cada regla (cos para la derivada de sin, tan para
+ * la de sec, ...) también se calculan con los núcleos vectorizados.
+ *
+ * Antes de evaluar se marca qué registros dependen de la variable: las
+ * instrucciones que no dependen de ella solo calculan el valor, y en las
+ * binarias se omite el término del operando constante. El compilador
+ * reutiliza registros, así que si el destino es uno de los operandos el valor
+ * y la derivada se calculan en columnas auxiliares y después se copian.
+ */
+
+#include "derivative.hpp"
+#include "../support/metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct dualStep
+ * @brief Columnas que intervienen en la derivada de una instrucción.
+ */
+struct dualStep {
+    const double* a; ///< Valor del operando izquierdo
+    const double* da; ///< Derivada del operando izquierdo
+    const double* b; ///< Valor del operando derecho (solo binarias)
+    const double* db; ///< Derivada del operando derecho (solo binarias)
+    const double* r; ///< Valor del resultado
+    double* t; ///< Derivada del resultado
+    double* h; ///< Columna auxiliar
+    std::size_t count;
+    bool leftVaries; ///< El operando izquierdo depende de la variable
+    bool rightVaries; ///< El operando derecho depende de la variable
+};
+
+/**
+ * @brief Un término de la regla de la cadena: slope(i) * d.
+ *
+ * Si alguno de los factores es 0 el término es 0 aunque el otro no sea
+ * finito: sqrt en 0 con un operando constante, o acot(1/x) cuando x ya se
+ * fue a infinito en una instrucción anterior.
+ */
+template <typename function>
+double term(double d, function slope, std::size_t i) {
+    if (d == 0.0)
+    {
+        return 0.0;
+    }
+    const double factor = slope(i);
+    return factor == 0.0 ? 0.0 : factor * d;
+}
+
+/**
+ * @brief Recalcula con term() las derivadas que dieron NaN.
+ *
+ * Los bucles principales multiplican sin condiciones para que se puedan
+ * vectorizar; 0 * inf solo puede dar NaN, así que basta revisar esas muestras.
+ */
+template <typename function>
+void repair(const dualStep& step, function exact) {
+    for (std::size_t i = 0; i < step.count; i++)
+    {
+        if (std::isnan(step.t[i]))
+        {
+            step.t[i] = exact(i);
+        }
+    }
+}
+
+/**
+ * @brief Aplica la regla de la cadena t = f'(a) * da, donde slope(i) da f'(a[i]).
+ */
+template <typename function>
+void chain(const dualStep& step, function slope) {
+    for (std::size_t i = 0; i < step.count; i++)
+    {
+        step.t[i] = slope(i) * step.da[i];
+    }
+    repair(step, [&](std::size_t i) { return term(step.da[i], slope, i); });
+}
+
+/**
+ * @brief Calcula en la columna auxiliar una función de a con su núcleo.
+ */
+void helper(const kernelTable& kernels, opCode op, const dualStep& step) {
+    kernels.unary[static_cast<std::size_t>(op)](step.a, step.h, step.count);
+}
+
+void unaryTangent(const kernelTable& kernels, opCode op, const dualStep& step) {
+    const double* a = step.a;
+    const double* r = step.r;
+    const double* h = step.h;
+    switch (op)
+    {
+    case opCode::Negate:
+        // Pendiente constante distinta de 0: el producto ya es exacto, no hace falta repair().
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.t[i] = -step.da[i];
+        }
+        break;
+    case opCode::Abs: chain(step, [a](std::size_t i) { return a[i] > 0.0 ? 1.0 : a[i] < 0.0 ? -1.0 : 0.0; }); break;
+    case opCode::Sin:
+        helper(kernels, opCode::Cos, step);
+        chain(step, [h](std::size_t i) { return h[i]; });
+        break;
+    case opCode::Cos:
+        helper(kernels, opCode::Sin, step);
+        chain(step, [h](std::size_t i) { return -h[i]; });
+        break;
+    case opCode::Tan: chain(step, [r](std::size_t i) { return 1.0 + r[i] * r[i]; }); break;
+    case opCode::Cot: chain(step, [r](std::size_t i) { return -(1.0 + r[i] * r[i]); }); break;
+    case opCode::Sec:
+        helper(kernels, opCode::Tan, step);
+        chain(step, [r, h](std::size_t i) { return r[i] * h[i]; });
+        break;
+    case opCode::Csc:
+        helper(kernels, opCode::Cot, step);
+        chain(step, [r, h](std::size_t i) { return -r[i] * h[i]; });
+        break;
+    case opCode::Asin:
+    case opCode::Acos:
+    {
+        // 1 / sqrt(1 - a^2), con signo negativo para acos.
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.h[i] = 1.0 - a[i] * a[i];
+        }
+        kernels.unary[static_cast<std::size_t>(opCode::Sqrt)](step.h, step.h, step.count);
+        const double sign = op == opCode::Asin ? 1.0 : -1.0;
+        chain(step, [h, sign](std::size_t i) { return sign / h[i]; });
+        break;
+    }
+    case opCode::Asec:
+    case opCode::Acsc:
+    {
+        // acos(1/a)' = 1 / (|a| sqrt(a^2 - 1)), con signo negativo para asin(1/a).
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.h[i] = a[i] * a[i] - 1.0;
+        }
+        kernels.unary[static_cast<std::size_t>(opCode::Sqrt)](step.h, step.h, step.count);
+        const double sign = op == opCode::Asec ? 1.0 : -1.0;
+        chain(step, [a, h, sign](std::size_t i) { return sign / (std::fabs(a[i]) * h[i]); });
+        break;
+    }
+    case opCode::Atan: chain(step, [a](std::size_t i) { return 1.0 / (1.0 + a[i] * a[i]); }); break;
+    case opCode::Acot: chain(step, [a](std::size_t i) { return -1.0 / (1.0 + a[i] * a[i]); }); break;
+    case opCode::Log: chain(step, [a](std::size_t i) { return 1.0 / (a[i] * std::numbers::ln10); }); break;
+    case opCode::Ln: chain(step, [a](std::size_t i) { return 1.0 / a[i]; }); break;
+    case opCode::Sqrt: chain(step, [r](std::size_t i) { return 0.5 / r[i]; }); break;
+    default: std::fill(step.t, step.t + step.count, std::nan("")); break;
+    }
+}
+
+/**
+ * @brief Suma los términos de la derivada de una operación de dos operandos.
+ *
+ * left(i) y right(i) son las derivadas parciales respecto a a y b. El
+ * término de un operando que no depende de la variable ni se calcula: así
+ * x^2 no paga un logaritmo por muestra.
+ */
+template <typename leftSlope, typename rightSlope>
+void chain2(const dualStep& step, leftSlope left, rightSlope right) {
+    if (!step.rightVaries)
+    {
+        chain(step, left);
+    }
+    else if (!step.leftVaries)
+    {
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.t[i] = right(i) * step.db[i];
+        }
+        repair(step, [&](std::size_t i) { return term(step.db[i], right, i); });
+    }
+    else
+    {
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.t[i] = left(i) * step.da[i] + right(i) * step.db[i];
+        }
+        repair(step, [&](std::size_t i) { return term(step.da[i], left, i) + term(step.db[i], right, i); });
+    }
+}
+
+void binaryTangent(const kernelTable& kernels, opCode op, const dualStep& step) {
+    const double* a = step.a;
+    const double* b = step.b;
+    const double* r = step.r;
+    const double* h = step.h;
+    switch (op)
+    {
+    case opCode::Add:
+    case opCode::Subtract:
+    {
+        // Pendientes constantes: la suma ya es exacta (inf - inf es NaN también con term()).
+        const double sign = op == opCode::Add ? 1.0 : -1.0;
+        for (std::size_t i = 0; i < step.count; i++)
+        {
+            step.t[i] = step.da[i] + sign * step.db[i];
+        }
+        break;
+    }
+    case opCode::Multiply: chain2(step, [b](std::size_t i) { return b[i]; }, [a](std::size_t i) { return a[i]; }); break;
+    case opCode::Divide: chain2(step, [b](std::size_t i) { return 1.0 / b[i]; }, [b, r](std::size_t i) { return -r[i] / b[i]; }); break;
+    case opCode::Modulo:
+        // fmod(a, b) = a - trunc(a / b) * b
+        chain2(step, [](std::size_t) { return 1.0; }, [a, b](std::size_t i) { return -std::trunc(a[i] / b[i]); });
+        break;
+    case opCode::Power:
+    {
+        // d(a^b) = b a^(b-1) da + a^b ln(a) db
+        if (step.leftVaries)
+        {
+            for (std::size_t i = 0; i < step.count; i++)
+            {
+                step.h[i] = b[i] - 1.0;
+            }
+            kernels.binary[static_cast<std::size_t>(opCode::Power)](a, step.h, step.h, step.count);
+        }
+        chain2(step, [b, h](std::size_t i) { return b[i] * h[i]; }, [a, r](std::size_t i) { return r[i] == 0.0 ? 0.0 : r[i] * std::log(a[i]); });
+        break;
+    }
+    case opCode::LogBase:
+    {
+        // r = ln(b) / ln(a): dr = (db / b - r da / a) / ln(a)
+        helper(kernels, opCode::Ln, step);
+        chain2(step, [a, r, h](std::size_t i) { return -r[i] / (a[i] * h[i]); }, [b, h](std::size_t i) { return 1.0 / (b[i] * h[i]); });
+        break;
+    }
+    case opCode::Nroot:
+        // r = b^(1/a) (raíz real): dr/db = r / (a b) y dr/da = -r ln|b| / a^2
+        chain2(step, [b, r, a](std::size_t i) { return r[i] == 0.0 ? 0.0 : -r[i] * std::log(std::fabs(b[i])) / (a[i] * a[i]); },
+            [b, r, a](std::size_t i) {
+                return b[i] != 0.0 ? r[i] / (a[i] * b[i]) : std::pow(0.0, 1.0 / a[i] - 1.0) / a[i];
+            });
+        break;
+    default: std::fill(step.t, step.t + step.count, std::nan("")); break;
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Evalúa f y su derivada parcial respecto a una variable en todas las muestras.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param variable Variable respecto a la que se deriva (0 = x, 1 = y, 2 = z).
+ * @param values Columna donde se escribe f en cada muestra.
+ * @param derivatives Columna donde se escribe la derivada.
+ */
+void evaluateDerivative(const bytecodeProgram& program, const variableInputs& inputs, std::size_t variable, std::span<double> values,
+    std::span<double> derivatives) {
+    evaluateDerivative(program, inputs, variable, values, derivatives, activeKernels());
+}
+
+/**
+ * @brief Evalúa f y su derivada con una tabla de núcleos concreta.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param variable Variable respecto a la que se deriva (0 = x, 1 = y, 2 = z).
+ * @param values Columna donde se escribe f en cada muestra.
+ * @param derivatives Columna donde se escribe la derivada.
+ * @param kernels Núcleos a usar.
+ */
+void evaluateDerivative(const bytecodeProgram& program, const variableInputs& inputs, std::size_t variable, std::span<double> values,
+    std::span<double> derivatives, const kernelTable& kernels) {
+    if (variable >= variableRegisterCount)
+    {
+        throw std::runtime_error("[Evaluator Error]: Solo se puede derivar respecto a x, y o z.");
+    }
+    if (values.size() != derivatives.size())
+    {
+        throw std::runtime_error("[Evaluator Error]: La columna de derivadas no coincide con el tamaño de la salida.");
+    }
+    if (!program.usesVariable(variable))
+    {
+        // f no depende de la variable: la derivada es 0 en todas partes.
+        evaluateBatch(program, inputs, values, kernels);
+        std::fill(derivatives.begin(), derivatives.end(), 0.0);
+        return;
+    }
+
+    const std::size_t count = values.size();
+    const std::span<const double>* columns[variableRegisterCount] = {&inputs.x, &inputs.y, &inputs.z};
+    for (std::size_t v = 0; v < variableRegisterCount; v++)
+    {
+        if (program.usesVariable(v) && columns[v]->size() != count)
+        {
+            throw std::runtime_error("[Evaluator Error]: La columna de una variable no coincide con el tamaño de la salida.");
+        }
+    }
+    if (!inputs.constants.empty() && inputs.constants.size() != program.constants.size())
+    {
+        throw std::runtime_error("[Evaluator Error]: La cantidad de constantes no coincide con la del programa.");
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    stageTimer timer(metricStage::Evaluate);
+
+    // Qué registros dependen de la variable: de los demás la derivada es 0 y no se calcula.
+    std::vector<char> varies(program.registerCount, 0);
+    varies[variable] = 1;
+    std::vector<char> targetVaries(program.code.size());
+    for (std::size_t s = 0; s < program.code.size(); s++)
+    {
+        const instruction& instr = program.code[s];
+        const bool depends = varies[instr.left] || (operandCount(instr.op) == 2 && varies[instr.right]);
+        targetVaries[s] = depends;
+        varies[instr.target] = depends;
+    }
+
+    // Memoria de trabajo: valor y derivada por registro, más columnas de unos,
+    // ceros (derivadas de lo que no depende de la variable) y tres auxiliares.
+    const std::size_t firstTemporary = program.firstTemporary();
+    const std::size_t chunk = std::min(count, evaluationChunk);
+    const std::size_t temporaries = program.registerCount - firstTemporary;
+    std::vector<double> scratch((program.constants.size() + 2 * temporaries + 5) * chunk, 0.0);
+    double* next = scratch.data();
+    auto column = [&next, chunk]() {
+        double* start = next;
+        next += chunk;
+        return start;
+    };
+
+    std::vector<double*> registers(program.registerCount, nullptr);
+    std::vector<double*> tangents(program.registerCount, nullptr);
+    std::vector<double*> ownTangents(program.registerCount, nullptr);
+    double* zeros = column();
+    double* ones = column();
+    std::fill(ones, ones + chunk, 1.0);
+    double* resultColumn = column();
+    double* tangentColumn = column();
+    double* helperColumn = column();
+
+    for (std::size_t v = 0; v < variableRegisterCount; v++)
+    {
+        tangents[v] = v == variable ? ones : zeros;
+    }
+    const std::span<const double> constants = inputs.constants.empty() ? std::span<const double>(program.constants) : inputs.constants;
+    for (std::size_t c = 0; c < constants.size(); c++)
+    {
+        double* constant = column();
+        std::fill(constant, constant + chunk, constants[c]);
+        registers[variableRegisterCount + c] = constant;
+        tangents[variableRegisterCount + c] = zeros;
+    }
+    for (std::size_t r = firstTemporary; r < program.registerCount; r++)
+    {
+        registers[r] = column();
+        ownTangents[r] = column();
+    }
+
+    const double* inputColumns[variableRegisterCount] = {inputs.x.data(), inputs.y.data(), inputs.z.data()};
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+        const std::size_t length = std::min(chunk, count - start);
+        for (std::size_t v = 0; v < variableRegisterCount; v++)
+        {
+            if (program.usesVariable(v))
+            {
+                registers[v] = const_cast<double*>(inputColumns[v] + start);
+            }
+        }
+
+        for (std::size_t s = 0; s < program.code.size(); s++)
+        {
+            const instruction& instr = program.code[s];
+            const std::size_t op = static_cast<std::size_t>(instr.op);
+            const bool binary = operandCount(instr.op) == 2;
+            if (!targetVaries[s])
+            {
+                // No depende de la variable: solo el valor, como en evaluateBatch.
+                if (binary)
+                {
+                    kernels.binary[op](registers[instr.left], registers[instr.right], registers[instr.target], length);
+                }
+                else
+                {
+                    kernels.unary[op](registers[instr.left], registers[instr.target], length);
+                }
+                tangents[instr.target] = zeros;
+                continue;
+            }
+
+            // Si el destino es un operando, el valor y la derivada van primero a columnas auxiliares.
+            const bool aliased = instr.target == instr.left || (binary && instr.target == instr.right);
+            double* value = aliased ? resultColumn : registers[instr.target];
+            double* slope = aliased ? tangentColumn : ownTangents[instr.target];
+            dualStep step{registers[instr.left], tangents[instr.left], nullptr, nullptr, value, slope, helperColumn, length,
+                tangents[instr.left] != zeros, false};
+            if (binary)
+            {
+                step.b = registers[instr.right];
+                step.db = tangents[instr.right];
+                step.rightVaries = tangents[instr.right] != zeros;
+                kernels.binary[op](step.a, step.b, value, length);
+                binaryTangent(kernels, instr.op, step);
+            }
+            else
+            {
+                kernels.unary[op](step.a, value, length);
+                unaryTangent(kernels, instr.op, step);
+            }
+            if (aliased)
+            {
+                std::copy(resultColumn, resultColumn + length, registers[instr.target]);
+                std::copy(tangentColumn, tangentColumn + length, ownTangents[instr.target]);
+            }
+            tangents[instr.target] = ownTangents[instr.target];
+        }
+
+        const double* result = registers[program.result];
+        const double* derivative = tangents[program.result];
+        std::copy(result, result + length, values.data() + start);
+        std::copy(derivative, derivative + length, derivatives.data() + start);
+    }
+    recordEvaluated(values);
+}
+
+/**
+ * @brief Evalúa f y su derivada en un solo punto.
+ *
+ * @param program Programa compilado.
+ * @param variable Variable respecto a la que se deriva.
+ * @param x Valor de x.
+ * @param y Valor de y.
+ * @param z Valor de z.
+ * @return dualValue Valor y derivada.
+ */
+dualValue derivativeAt(const bytecodeProgram& program, std::size_t variable, double x, double y, double z) {
+    variableInputs inputs{{&x, 1}, {&y, 1}, {&z, 1}, {}};
+
+    dualValue result{0.0, 0.0};
+    evaluateDerivative(program, inputs, variable, std::span<double>(&result.value, 1), std::span<double>(&result.derivative, 1));
+    return result;
+}
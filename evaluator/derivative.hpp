@@ -0,0 +1,76 @@
+/**
+ * @file derivative.hpp
+ * @brief Evaluación por lotes con diferenciación automática hacia adelante.
+ *
+ * Cada registro lleva, además de su valor, la derivada respecto a una
+ * variable (números duales): al ejecutar una instrucción se aplica la regla
+ * de la cadena columna por columna. El valor y la derivada salen de una sola
+ * pasada, sin diferencias finitas ni evaluaciones extra, y la derivada es
+ * exacta salvo el redondeo.
+ *
+ * Se evalúa siempre en double, sin importar program.precision: los valores
+ * se calculan con los mismos núcleos que evaluateBatch en double, así que
+ * coinciden bit a bit con los de un programa con precisión Double (o con
+ * evaluateBatch sobre la misma tabla de núcleos).
+ */
+#ifndef DERIVATIVE_HPP
+#define DERIVATIVE_HPP
+
+#include "evaluator.hpp"
+#include "program.hpp"
+#include <cstddef>
+#include <span>
+
+/**
+ * @struct dualValue
+ * @brief Valor de f y de su derivada en un punto.
+ */
+struct dualValue {
+    double value; ///< f en el punto
+    double derivative; ///< Derivada de f respecto a la variable elegida
+};
+
+/**
+ * @brief Evalúa f y su derivada parcial respecto a una variable en todas las muestras.
+ *
+ * Usa activeKernels() también para programas en Single o Fast.
+ * Convenciones en los puntos no derivables: |x| tiene derivada 0 en x = 0.
+ * Donde f no está definida la derivada queda en NaN o infinito.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param variable Variable respecto a la que se deriva (0 = x, 1 = y, 2 = z).
+ * @param values Columna donde se escribe f en cada muestra.
+ * @param derivatives Columna donde se escribe la derivada (mismo tamaño que values).
+ * @throws std::runtime_error Si falta una variable, la variable no existe o los tamaños no coinciden.
+ */
+void evaluateDerivative(const bytecodeProgram& program, const variableInputs& inputs, std::size_t variable, std::span<double> values,
+    std::span<double> derivatives);
+
+/**
+ * @brief Evalúa f y su derivada con una tabla de núcleos concreta.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param variable Variable respecto a la que se deriva (0 = x, 1 = y, 2 = z).
+ * @param values Columna donde se escribe f en cada muestra.
+ * @param derivatives Columna donde se escribe la derivada (mismo tamaño que values).
+ * @param kernels Núcleos a usar.
+ * @throws std::runtime_error Si falta una variable, la variable no existe o los tamaños no coinciden.
+ */
+void evaluateDerivative(const bytecodeProgram& program, const variableInputs& inputs, std::size_t variable, std::span<double> values,
+    std::span<double> derivatives, const kernelTable& kernels);
+
+/**
+ * @brief Evalúa f y su derivada en un solo punto.
+ *
+ * @param program Programa compilado.
+ * @param variable Variable respecto a la que se deriva (0 = x, 1 = y, 2 = z).
+ * @param x Valor de x.
+ * @param y Valor de y.
+ * @param z Valor de z.
+ * @return dualValue Valor y derivada.
+ */
+dualValue derivativeAt(const bytecodeProgram& program, std::size_t variable, double x, double y = 0.0, double z = 0.0);
+
+#endif // DERIVATIVE_HPP
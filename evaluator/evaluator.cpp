@@ -0,0 +1,214 @@
+/**
+ * @file evaluator.cpp
+ * @brief Implementación del evaluador por lotes.
+ *
+ * Cada registro del programa se materializa como un puntero a una columna de
+ * evaluationChunk valores: las variables apuntan directamente a la entrada,
+ * las constantes a una columna rellenada una sola vez y los intermedios a
+ * memoria de trabajo. Así cada instrucción es un bucle simple sobre arreglos
+ * contiguos que el compilador puede vectorizar.
+ *
+ * En las precisiones Single y Fast las columnas son de float: las variables
+ * se convierten bloque por bloque y el resultado vuelve a double al copiarlo
+ * a la salida.
+ */
+
+#include "evaluator.hpp"
+#include "../support/metrics.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Ejecuta una instrucción sobre count muestras con los núcleos dados (de double o de float).
+ */
+template <class Table, class Value>
+void runInstruction(const Table& kernels, const instruction& step, Value* const* registers, std::size_t count) {
+    const std::size_t op = static_cast<std::size_t>(step.op);
+    if (operandCount(step.op) == 2)
+    {
+        kernels.binary[op](registers[step.left], registers[step.right], registers[step.target], count);
+    }
+    else
+    {
+        kernels.unary[op](registers[step.left], registers[step.target], count);
+    }
+}
+
+/**
+ * @brief Comprueba que estén todas las columnas que el programa necesita.
+ */
+void checkInputs(const bytecodeProgram& program, const variableInputs& inputs, std::size_t count) {
+    const std::span<const double>* columns[variableRegisterCount] = {&inputs.x, &inputs.y, &inputs.z};
+    for (std::size_t v = 0; v < variableRegisterCount; v++)
+    {
+        if (program.usesVariable(v) && columns[v]->size() != count)
+        {
+            throw std::runtime_error("[Evaluator Error]: La columna de una variable no coincide con el tamaño de la salida.");
+        }
+    }
+    if (!inputs.constants.empty() && inputs.constants.size() != program.constants.size())
+    {
+        throw std::runtime_error("[Evaluator Error]: La cantidad de constantes no coincide con la del programa.");
+    }
+}
+
+/**
+ * @brief Valores de las constantes: los de la entrada si los trae, si no los del programa.
+ */
+std::span<const double> constantValues(const bytecodeProgram& program, const variableInputs& inputs) {
+    return inputs.constants.empty() ? std::span<const double>(program.constants) : inputs.constants;
+}
+
+} // namespace
+
+/**
+ * @brief Evalúa el programa en todas las muestras, columna por columna.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output) {
+    if (program.precision != evaluationPrecision::Double)
+    {
+        evaluateBatch(program, inputs, output, activeFloatKernels(program.precision == evaluationPrecision::Fast));
+        return;
+    }
+    evaluateBatch(program, inputs, output, activeKernels());
+}
+
+/**
+ * @brief Evalúa el programa con una tabla de núcleos concreta.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ * @param kernels Núcleos a usar (por ejemplo, scalarKernels() como referencia).
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output, const kernelTable& kernels) {
+    const std::size_t count = output.size();
+    checkInputs(program, inputs, count);
+    if (count == 0)
+    {
+        return;
+    }
+    stageTimer timer(metricStage::Evaluate);
+
+    // Memoria de trabajo: una columna por constante y por registro intermedio.
+    const std::size_t firstTemporary = program.firstTemporary();
+    const std::size_t chunk = std::min(count, evaluationChunk);
+    std::vector<double> scratch((program.registerCount - variableRegisterCount) * chunk);
+    std::vector<double*> registers(program.registerCount, nullptr);
+
+    const std::span<const double> constants = constantValues(program, inputs);
+    for (std::size_t c = 0; c < constants.size(); c++)
+    {
+        double* column = scratch.data() + c * chunk;
+        std::fill(column, column + chunk, constants[c]);
+        registers[variableRegisterCount + c] = column;
+    }
+    for (std::size_t r = firstTemporary; r < program.registerCount; r++)
+    {
+        registers[r] = scratch.data() + (r - variableRegisterCount) * chunk;
+    }
+
+    const double* columns[variableRegisterCount] = {inputs.x.data(), inputs.y.data(), inputs.z.data()};
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+        const std::size_t length = std::min(chunk, count - start);
+
+        // Las variables apuntan directamente a la entrada, sin copiarla. Ninguna
+        // instrucción escribe en ellas: los destinos siempre son intermedios.
+        for (std::size_t v = 0; v < variableRegisterCount; v++)
+        {
+            if (program.usesVariable(v))
+            {
+                registers[v] = const_cast<double*>(columns[v] + start);
+            }
+        }
+
+        for (const instruction& step : program.code)
+        {
+            runInstruction(kernels, step, registers.data(), length);
+        }
+
+        const double* result = registers[program.result];
+        std::copy(result, result + length, output.data() + start);
+    }
+    recordEvaluated(output);
+}
+
+/**
+ * @brief Evalúa el programa en float con una tabla de núcleos concreta.
+ *
+ * @param program Programa compilado (se ignora su campo precision).
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ * @param kernels Núcleos en float a usar.
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output, const floatKernelTable& kernels) {
+    const std::size_t count = output.size();
+    checkInputs(program, inputs, count);
+    if (count == 0)
+    {
+        return;
+    }
+    stageTimer timer(metricStage::Evaluate);
+
+    // Aquí también las variables tienen columna propia: la entrada es de double.
+    const std::size_t chunk = std::min(count, evaluationChunk);
+    std::vector<float> scratch(program.registerCount * chunk);
+    std::vector<float*> registers(program.registerCount, nullptr);
+    for (std::size_t r = 0; r < program.registerCount; r++)
+    {
+        registers[r] = scratch.data() + r * chunk;
+    }
+    const std::span<const double> constants = constantValues(program, inputs);
+    for (std::size_t c = 0; c < constants.size(); c++)
+    {
+        float* column = registers[variableRegisterCount + c];
+        std::fill(column, column + chunk, static_cast<float>(constants[c]));
+    }
+
+    const double* columns[variableRegisterCount] = {inputs.x.data(), inputs.y.data(), inputs.z.data()};
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+        const std::size_t length = std::min(chunk, count - start);
+        for (std::size_t v = 0; v < variableRegisterCount; v++)
+        {
+            if (program.usesVariable(v))
+            {
+                std::copy(columns[v] + start, columns[v] + start + length, registers[v]);
+            }
+        }
+
+        for (const instruction& step : program.code)
+        {
+            runInstruction(kernels, step, registers.data(), length);
+        }
+
+        const float* result = registers[program.result];
+        std::copy(result, result + length, output.data() + start);
+    }
+    recordEvaluated(output);
+}
+
+/**
+ * @brief Evalúa el programa en un solo punto.
+ *
+ * @param program Programa compilado.
+ * @param x Valor de x.
+ * @param y Valor de y.
+ * @param z Valor de z.
+ * @return double Valor de la expresión.
+ */
+double evaluateAt(const bytecodeProgram& program, double x, double y, double z) {
+    variableInputs inputs{{&x, 1}, {&y, 1}, {&z, 1}, {}};
+
+    double result = 0.0;
+    evaluateBatch(program, inputs, std::span<double>(&result, 1));
+    return result;
+}
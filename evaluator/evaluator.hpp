@@ -0,0 +1,92 @@
+/**
+ * @file evaluator.hpp
+ * @brief Evaluación por lotes de un programa compilado sobre muchas muestras.
+ */
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#include "program.hpp"
+#include "kernels.hpp"
+#include <cstddef>
+#include <span>
+
+/// Cantidad de muestras que se procesan por instrucción antes de pasar a la siguiente.
+constexpr std::size_t evaluationChunk = 256;
+
+/**
+ * @struct variableInputs
+ * @brief Columnas de entrada para las variables x, y, z.
+ *
+ * Solo hace falta proporcionar las variables que usa el programa; cada
+ * columna proporcionada debe tener tantos elementos como la salida.
+ *
+ * evaluateBatch, jitProgram::evaluate y evaluateDerivative aceptan además
+ * otros valores para las constantes del programa: así un mismo programa se
+ * evalúa con constantes distintas (por ejemplo, un cuadro de un barrido)
+ * sin copiarlo.
+ */
+struct variableInputs {
+    std::span<const double> x; ///< Valores de x
+    std::span<const double> y; ///< Valores de y
+    std::span<const double> z; ///< Valores de z
+    std::span<const double> constants; ///< Si no está vacío, reemplaza a program.constants (mismo tamaño)
+};
+
+/**
+ * @brief Evalúa el programa en todas las muestras, columna por columna.
+ *
+ * La evaluación avanza por bloques de evaluationChunk muestras; dentro de
+ * cada bloque se ejecuta cada instrucción sobre todas las muestras antes de
+ * pasar a la siguiente.
+ *
+ * Usa la tabla de núcleos activa (la mejor versión SIMD disponible), en
+ * double o en float según program.precision. Con Single o Fast los valores
+ * se redondean a float al entrar y el resultado vuelve a double.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ * @throws std::runtime_error Si falta una variable o los tamaños no coinciden.
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output);
+
+/**
+ * @brief Evalúa el programa con una tabla de núcleos concreta.
+ *
+ * Siempre en double, sin mirar program.precision.
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ * @param kernels Núcleos a usar (por ejemplo, scalarKernels() como referencia).
+ * @throws std::runtime_error Si falta una variable o los tamaños no coinciden.
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output, const kernelTable& kernels);
+
+/**
+ * @brief Evalúa el programa en float con una tabla de núcleos concreta.
+ *
+ * Las entradas se redondean a float, cada instrucción se ejecuta en float y
+ * el resultado se guarda en double. No mira program.precision: sirve para
+ * comparar tablas (por ejemplo, scalarFloatKernels() como referencia).
+ *
+ * @param program Programa compilado.
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ * @param kernels Núcleos en float a usar.
+ * @throws std::runtime_error Si falta una variable o los tamaños no coinciden.
+ */
+void evaluateBatch(const bytecodeProgram& program, const variableInputs& inputs, std::span<double> output, const floatKernelTable& kernels);
+
+/**
+ * @brief Evalúa el programa en un solo punto.
+ *
+ * @param program Programa compilado.
+ * @param x Valor de x.
+ * @param y Valor de y.
+ * @param z Valor de z.
+ * @return double Valor de la expresión.
+ */
+double evaluateAt(const bytecodeProgram& program, double x, double y = 0.0, double z = 0.0);
+
+#endif // EVALUATOR_HPP
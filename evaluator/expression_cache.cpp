@@ -0,0 +1,96 @@
+/**
+ * @file expression_cache.cpp
+ * @brief Implementación de la caché LRU de expresiones compiladas.
+ */
+
+#include "expression_cache.hpp"
+#include "compiler.hpp"
+#include "../parser/lexer.hpp"
+#include <array>
+#include <memory_resource>
+
+expressionCache::expressionCache(std::size_t capacity)
+    : capacity(capacity == 0 ? 1 : capacity) {
+    index.reserve(this->capacity);
+}
+
+std::string expressionCache::normalize(std::string_view expression) {
+    // Los tokens de una expresión corta caben en la pila; las largas piden más al heap.
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    const lexResult lexed = tokenizeChecked(expression, errorPolicy::StopAtFirst, &arena);
+    if (!lexed.ok())
+    {
+        return std::string(expression);
+    }
+    std::string result;
+    result.reserve(expression.size() + lexed.tokens.size());
+    for (const tokenView& token : lexed.tokens)
+    {
+        if (!result.empty())
+        {
+            result.push_back(' ');
+        }
+        result.append(token.text);
+    }
+    return result;
+}
+
+/**
+ * @brief Devuelve el programa de la expresión, compilándolo si no está guardado.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @return std::shared_ptr<const bytecodeProgram> Programa compilado.
+ */
+std::shared_ptr<const bytecodeProgram> expressionCache::get(std::string_view expression) {
+    std::string key = normalize(expression);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = index.find(key);
+        if (found != index.end())
+        {
+            counters.hits++;
+            recent.splice(recent.begin(), recent, found->second);
+            return found->second->program;
+        }
+        counters.misses++;
+    }
+
+    // Se compila el texto original, sin el cerrojo para no frenar a los demás hilos.
+    auto program = std::make_shared<const bytecodeProgram>(compileExpression(expression));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        return found->second->program; // Otro hilo la guardó mientras compilábamos
+    }
+    if (recent.size() >= capacity)
+    {
+        index.erase(recent.back().key);
+        recent.pop_back();
+        counters.evictions++;
+    }
+    recent.push_front({std::move(key), program});
+    index.emplace(recent.front().key, recent.begin());
+    return program;
+}
+
+cacheStats expressionCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    cacheStats result = counters;
+    result.size = recent.size();
+    return result;
+}
+
+void expressionCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    recent.clear();
+    counters = cacheStats{};
+}
+
+expressionCache& expressionCache::shared() {
+    static expressionCache cache;
+    return cache;
+}
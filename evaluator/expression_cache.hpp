@@ -0,0 +1,102 @@
+/**
+ * @file expression_cache.hpp
+ * @brief Caché LRU de expresiones compiladas, indexada por los tokens del texto.
+ *
+ * Las interfaces que reenvían una y otra vez las mismas expresiones pagan
+ * así un análisis léxico y una búsqueda en una tabla hash en lugar de
+ * analizar y compilar de nuevo. La clave es la secuencia de tokens, así que
+ * "sin( x )" y "sin(x)" comparten entrada pero "2e - 1" (un error) y "2e-1"
+ * no.
+ */
+#ifndef EXPRESSION_CACHE_HPP
+#define EXPRESSION_CACHE_HPP
+
+#include "program.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @struct cacheStats
+ * @brief Contadores de uso de la caché.
+ */
+struct cacheStats {
+    std::uint64_t hits = 0; ///< Búsquedas resueltas sin compilar
+    std::uint64_t misses = 0; ///< Búsquedas que tuvieron que compilar
+    std::uint64_t evictions = 0; ///< Entradas descartadas por falta de espacio
+    std::size_t size = 0; ///< Entradas guardadas actualmente
+};
+
+/**
+ * @class expressionCache
+ * @brief Programas compilados recientemente, con capacidad limitada.
+ *
+ * Es seguro usarla desde varios hilos. La compilación se hace fuera del
+ * cerrojo, así que dos hilos que piden a la vez una expresión nueva pueden
+ * compilarla ambos; se guarda la primera que termina.
+ */
+class expressionCache {
+public:
+    /**
+     * @brief Crea una caché vacía.
+     * @param capacity Cantidad máxima de expresiones guardadas (al menos 1).
+     */
+    explicit expressionCache(std::size_t capacity = 256);
+
+    expressionCache(const expressionCache&) = delete;
+    expressionCache& operator=(const expressionCache&) = delete;
+
+    /**
+     * @brief Devuelve el programa de la expresión, compilándolo si no está guardado.
+     *
+     * El programa devuelto sigue siendo válido aunque luego se descarte de la caché.
+     *
+     * @param expression Expresión matemática como cadena.
+     * @return std::shared_ptr<const bytecodeProgram> Programa compilado.
+     * @throws std::runtime_error Si la expresión tiene errores (no se guarda nada).
+     */
+    std::shared_ptr<const bytecodeProgram> get(std::string_view expression);
+
+    /**
+     * @brief Contadores acumulados desde la creación o el último clear().
+     */
+    cacheStats stats() const;
+
+    /**
+     * @brief Descarta todas las entradas y reinicia los contadores.
+     */
+    void clear();
+
+    /**
+     * @brief Forma canónica del texto: sus tokens separados por un espacio.
+     *
+     * Dos textos tienen la misma forma solo si el lexer los divide en los
+     * mismos tokens. Si el texto tiene errores léxicos se devuelve tal cual
+     * (get() no guarda nada en ese caso).
+     */
+    static std::string normalize(std::string_view expression);
+
+    /**
+     * @brief Caché compartida por defecto, creada al primer uso.
+     */
+    static expressionCache& shared();
+
+private:
+    struct entry {
+        std::string key;
+        std::shared_ptr<const bytecodeProgram> program;
+    };
+
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    std::list<entry> recent; ///< Entradas de la más a la menos usada
+    std::unordered_map<std::string_view, std::list<entry>::iterator> index; ///< Clave apunta a entry::key
+    cacheStats counters;
+};
+
+#endif // EXPRESSION_CACHE_HPP
@@ -0,0 +1,494 @@
+/**
+ * @file interval.cpp
+ * @brief Implementación de la aritmética de intervalos para cada operación.
+ *
+ * Cada operación sigue la semántica de scalar_ops.hpp: los puntos donde la
+ * versión escalar da NaN no aportan valores al intervalo y encienden la marca
+ * partial, que también se enciende con cualquier cota infinita.
+ */
+
+#include "interval.hpp"
+#include "scalar_ops.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+/// Ulps de margen para + - * / y sqrt, que redondean correctamente.
+constexpr int arithmeticUlps = 1;
+
+/// Ulps de margen para las funciones de biblioteca y sus versiones SIMD.
+constexpr int libraryUlps = 4;
+
+/// Más allá de esta magnitud no se intenta ubicar los extremos y polos de las funciones periódicas.
+constexpr double periodicLimit = 1e9;
+
+/**
+ * @brief Agranda el intervalo ulps pasos hacia afuera en cada extremo finito.
+ */
+interval widened(interval value, int ulps) {
+    if (value.isEmpty())
+    {
+        return value;
+    }
+    for (int step = 0; step < ulps; step++)
+    {
+        value.lo = std::nextafter(value.lo, -infinity);
+        value.hi = std::nextafter(value.hi, infinity);
+    }
+    return value;
+}
+
+/**
+ * @brief Intervalo de una función monótona creciente: [f(lo), f(hi)].
+ *
+ * Los extremos infinitos se evalúan como en IEEE (atan(inf) = pi/2).
+ */
+template <typename function>
+interval increasing(interval a, function f) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    return widened({f(a.lo), f(a.hi), a.partial}, libraryUlps);
+}
+
+template <typename function>
+interval decreasing(interval a, function f) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    return widened({f(a.hi), f(a.lo), a.partial}, libraryUlps);
+}
+
+/**
+ * @brief Recorta el intervalo al dominio [low, high]; marca partial si sobraba algo.
+ */
+interval clipped(interval a, double low, double high) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    if (a.lo < low || a.hi > high)
+    {
+        a.partial = true;
+    }
+    a.lo = std::max(a.lo, low);
+    a.hi = std::min(a.hi, high);
+    if (a.isEmpty())
+    {
+        return interval::empty();
+    }
+    return a;
+}
+
+/**
+ * @brief Indica si [lo, hi] contiene algún punto offset + k * period (con un margen de seguridad).
+ */
+bool containsPeriodic(double lo, double hi, double offset, double period) {
+    const double slack = 1e-9;
+    const double first = std::ceil((lo - offset) / period - slack);
+    const double last = std::floor((hi - offset) / period + slack);
+    return first <= last;
+}
+
+/**
+ * @brief Si el intervalo es muy ancho o está muy lejos del origen, no se ubican extremos.
+ */
+bool periodicUnknown(interval a) {
+    return !(a.hi - a.lo < 2.0 * std::numbers::pi) || std::fabs(a.lo) > periodicLimit || std::fabs(a.hi) > periodicLimit;
+}
+
+interval sine(interval a) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    if (periodicUnknown(a))
+    {
+        return {-1.0, 1.0, a.partial};
+    }
+    const double s = std::sin(a.lo);
+    const double t = std::sin(a.hi);
+    interval result = widened({std::min(s, t), std::max(s, t), a.partial}, libraryUlps);
+    if (containsPeriodic(a.lo, a.hi, std::numbers::pi / 2, 2 * std::numbers::pi))
+    {
+        result.hi = 1.0;
+    }
+    if (containsPeriodic(a.lo, a.hi, -std::numbers::pi / 2, 2 * std::numbers::pi))
+    {
+        result.lo = -1.0;
+    }
+    result.lo = std::max(result.lo, -1.0);
+    result.hi = std::min(result.hi, 1.0);
+    return result;
+}
+
+interval cosine(interval a) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    if (periodicUnknown(a))
+    {
+        return {-1.0, 1.0, a.partial};
+    }
+    const double s = std::cos(a.lo);
+    const double t = std::cos(a.hi);
+    interval result = widened({std::min(s, t), std::max(s, t), a.partial}, libraryUlps);
+    if (containsPeriodic(a.lo, a.hi, 0.0, 2 * std::numbers::pi))
+    {
+        result.hi = 1.0;
+    }
+    if (containsPeriodic(a.lo, a.hi, std::numbers::pi, 2 * std::numbers::pi))
+    {
+        result.lo = -1.0;
+    }
+    result.lo = std::max(result.lo, -1.0);
+    result.hi = std::min(result.hi, 1.0);
+    return result;
+}
+
+/**
+ * @brief tan o cot: monótonas entre polos separados por pi.
+ *
+ * @param poleOffset Posición de un polo (pi/2 para tan, 0 para cot).
+ * @param rising Si la función crece entre polos (tan) o decrece (cot).
+ */
+template <typename function>
+interval betweenPoles(interval a, double poleOffset, bool rising, function f) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    if (!(a.hi - a.lo < std::numbers::pi) || std::fabs(a.lo) > periodicLimit || std::fabs(a.hi) > periodicLimit
+        || containsPeriodic(a.lo, a.hi, poleOffset, std::numbers::pi))
+    {
+        return interval::entire(true);
+    }
+    return rising ? increasing(a, f) : decreasing(a, f);
+}
+
+interval add(interval a, interval b) {
+    if (a.isEmpty() || b.isEmpty())
+    {
+        return interval::empty();
+    }
+    // inf + (-inf) solo aparece con cotas infinitas opuestas: la recta entera.
+    double lo = a.lo + b.lo;
+    double hi = a.hi + b.hi;
+    return widened({std::isnan(lo) ? -infinity : lo, std::isnan(hi) ? infinity : hi, a.partial || b.partial}, arithmeticUlps);
+}
+
+interval negate(interval a) {
+    return {-a.hi, -a.lo, a.partial};
+}
+
+/**
+ * @brief Producto de dos cotas; 0 * inf es NaN y no aporta más que el 0 (el operando infinito ya es partial).
+ */
+double boundProduct(double a, double b) {
+    const double product = a * b;
+    return std::isnan(product) ? 0.0 : product;
+}
+
+interval multiply(interval a, interval b) {
+    if (a.isEmpty() || b.isEmpty())
+    {
+        return interval::empty();
+    }
+    const double p[4] = {boundProduct(a.lo, b.lo), boundProduct(a.lo, b.hi), boundProduct(a.hi, b.lo), boundProduct(a.hi, b.hi)};
+    return widened({*std::min_element(p, p + 4), *std::max_element(p, p + 4), a.partial || b.partial}, arithmeticUlps);
+}
+
+/**
+ * @brief 1 / a, con 1/0 = inf como en IEEE.
+ *
+ * El signo del cero no se sigue (x * -1 puede dar -0 y 1/-0 = -inf), así que
+ * un intervalo que toca el 0 da la recta entera.
+ */
+interval reciprocal(interval a) {
+    if (a.isEmpty())
+    {
+        return a;
+    }
+    if (a.contains(0.0))
+    {
+        return interval::entire(true);
+    }
+    return widened({1.0 / a.hi, 1.0 / a.lo, a.partial}, arithmeticUlps);
+}
+
+interval divide(interval a, interval b) {
+    if (a.isEmpty() || b.isEmpty())
+    {
+        return interval::empty();
+    }
+    if (a.lo == 0.0 && a.hi == 0.0)
+    {
+        // 0 / b vale 0 salvo en b = 0, donde da NaN.
+        return {0.0, 0.0, a.partial || b.partial || b.contains(0.0)};
+    }
+    return multiply(a, reciprocal(b));
+}
+
+interval absolute(interval a) {
+    if (a.isEmpty() || a.lo >= 0.0)
+    {
+        return a;
+    }
+    if (a.hi <= 0.0)
+    {
+        return negate(a);
+    }
+    return {0.0, std::max(-a.lo, a.hi), a.partial};
+}
+
+interval modulo(interval a, interval b) {
+    if (a.isEmpty() || b.isEmpty())
+    {
+        return interval::empty();
+    }
+    const bool partial = a.partial || b.partial || b.contains(0.0) || std::isinf(a.lo) || std::isinf(a.hi);
+    const double limit = std::max(std::fabs(b.lo), std::fabs(b.hi));
+
+    // Divisor fijo y dividendo dentro de un mismo período: fmod es continua y creciente ahí.
+    // El cociente redondeado puede ocultar un salto justo después de a.lo, así
+    // que además los extremos de fmod deben quedar en orden.
+    if (b.lo == b.hi && b.lo != 0.0 && std::isfinite(a.lo) && std::isfinite(a.hi) && (a.lo >= 0.0 || a.hi <= 0.0))
+    {
+        const double period = std::fabs(b.lo);
+        const double lo = std::fmod(a.lo, period);
+        const double hi = std::fmod(a.hi, period);
+        if (std::trunc(a.lo / period) == std::trunc(a.hi / period) && lo <= hi)
+        {
+            return widened({lo, hi, partial}, arithmeticUlps);
+        }
+    }
+    // |fmod(a, b)| < |b| y |fmod(a, b)| <= |a|, con el signo de a.
+    const double low = a.lo >= 0.0 ? 0.0 : -std::min(-a.lo, limit);
+    const double high = a.hi <= 0.0 ? 0.0 : std::min(a.hi, limit);
+    return {low, high, partial};
+}
+
+/**
+ * @brief Logaritmo natural o en base 10: log(0) = -inf y los negativos dan NaN.
+ */
+template <typename function>
+interval logarithm(interval a, function f) {
+    if (a.isEmpty() || a.hi < 0.0)
+    {
+        return interval::empty();
+    }
+    const bool partial = a.partial || a.lo < 0.0;
+    const double lo = a.lo <= 0.0 ? -infinity : f(a.lo);
+    const double hi = a.hi == 0.0 ? -infinity : f(a.hi);
+    return widened({lo, hi, partial}, libraryUlps);
+}
+
+/**
+ * @brief x^n con n entero: se usa la paridad para no perder el signo.
+ */
+interval integerPower(interval a, double n) {
+    if (n < 0.0)
+    {
+        return reciprocal(integerPower(a, -n));
+    }
+    auto power = [n](double value) { return std::pow(value, n); };
+    if (std::fmod(n, 2.0) != 0.0 || a.lo >= 0.0)
+    {
+        return increasing(a, power); // Impar, o par sobre valores no negativos
+    }
+    if (a.hi <= 0.0)
+    {
+        return decreasing(a, power);
+    }
+    return widened({0.0, std::max(power(a.lo), power(a.hi)), a.partial}, libraryUlps);
+}
+
+interval power(interval a, interval b) {
+    // pow(x, 0) = 1 y pow(1, y) = 1 incluso si el otro argumento es NaN.
+    if (b.lo == 0.0 && b.hi == 0.0)
+    {
+        return {1.0, 1.0, a.partial};
+    }
+    if (a.isEmpty() || b.isEmpty())
+    {
+        const bool one = a.isEmpty() ? b.contains(0.0) : a.contains(1.0);
+        return one ? interval{1.0, 1.0, true} : interval::empty();
+    }
+    if (b.lo == b.hi && std::isinf(b.lo) && a.lo < 0.0)
+    {
+        // pow(x, ±inf) solo depende de |x| (da 0, 1 o inf), también con base negativa.
+        return power(absolute(a), b);
+    }
+    if (b.lo == b.hi && std::isfinite(b.lo) && std::trunc(b.lo) == b.lo)
+    {
+        return integerPower(a, b.lo);
+    }
+    if (a.lo < 0.0 && b.lo != b.hi)
+    {
+        // Con base negativa solo los exponentes enteros dan un valor real; no se acota mejor.
+        return interval::entire(true);
+    }
+    // Exponente fijo no entero o base no negativa.
+    interval base = clipped(a, 0.0, infinity);
+    if (base.isEmpty())
+    {
+        return a.lo == -infinity ? interval::entire(true) : interval::empty();
+    }
+    // Para base >= 0, pow es monótona en cada argumento: los extremos están en las esquinas.
+    const double corners[4] = {std::pow(base.lo, b.lo), std::pow(base.lo, b.hi), std::pow(base.hi, b.lo), std::pow(base.hi, b.hi)};
+    interval result{*std::min_element(corners, corners + 4), *std::max_element(corners, corners + 4), base.partial || b.partial};
+    if (a.lo == -infinity)
+    {
+        // pow(-inf, y) no es NaN: vale 0 o inf según el signo de y.
+        result.lo = std::min(result.lo, 0.0);
+        result.hi = infinity;
+    }
+    if (base.lo == 0.0 && b.lo < 0.0)
+    {
+        result = interval::entire(true); // pow(-0, y) con y negativo puede dar -inf
+    }
+    return widened(result, libraryUlps);
+}
+
+/**
+ * @brief nroot(n, x): realRoot de scalar_ops.hpp.
+ */
+interval root(interval n, interval x) {
+    if (n.isEmpty() || x.isEmpty())
+    {
+        return power(x, reciprocal(n)); // pow(1, NaN) y pow(NaN, 0) valen 1
+    }
+    if (n.lo == n.hi && std::isinf(n.lo))
+    {
+        // 1/n = ±0: -1 con x negativo y 1 en el resto, también donde x da NaN.
+        return {x.lo < 0.0 ? -1.0 : 1.0, (x.hi >= 0.0 || x.partial) ? 1.0 : -1.0, x.partial};
+    }
+    if (n.lo == n.hi && std::trunc(n.lo) == n.lo && std::fmod(n.lo, 2.0) != 0.0)
+    {
+        // Índice entero impar: raíz real creciente (o decreciente si el índice es negativo) en toda la recta.
+        const double index = n.lo;
+        auto f = [index](double value) { return realRoot(index, value); };
+        if (index > 0.0)
+        {
+            return increasing(x, f);
+        }
+        if (x.contains(0.0))
+        {
+            return reciprocal(root(interval::point(-index), x));
+        }
+        return decreasing(x, f);
+    }
+    if (x.lo < 0.0 && n.lo != n.hi)
+    {
+        return interval::entire(true);
+    }
+    return power(x, reciprocal(n));
+}
+
+interval applyUnaryInterval(opCode op, interval a) {
+    switch (op)
+    {
+    case opCode::Negate: return negate(a);
+    case opCode::Abs: return absolute(a);
+    case opCode::Sin: return sine(a);
+    case opCode::Cos: return cosine(a);
+    case opCode::Tan: return betweenPoles(a, std::numbers::pi / 2, true, [](double v) { return std::tan(v); });
+    case opCode::Cot: return betweenPoles(a, 0.0, false, [](double v) { return std::cos(v) / std::sin(v); });
+    case opCode::Sec: return reciprocal(cosine(a));
+    case opCode::Csc: return reciprocal(sine(a));
+    case opCode::Asin: return increasing(clipped(a, -1.0, 1.0), [](double v) { return std::asin(v); });
+    case opCode::Acos: return decreasing(clipped(a, -1.0, 1.0), [](double v) { return std::acos(v); });
+    case opCode::Atan: return increasing(a, [](double v) { return std::atan(v); });
+    case opCode::Asec: return decreasing(clipped(reciprocal(a), -1.0, 1.0), [](double v) { return std::acos(v); });
+    case opCode::Acsc: return increasing(clipped(reciprocal(a), -1.0, 1.0), [](double v) { return std::asin(v); });
+    case opCode::Acot: return increasing(reciprocal(a), [](double v) { return std::atan(v); });
+    case opCode::Log: return logarithm(a, [](double v) { return std::log10(v); });
+    case opCode::Ln: return logarithm(a, [](double v) { return std::log(v); });
+    case opCode::Sqrt:
+    {
+        interval domain = clipped(a, 0.0, infinity);
+        return domain.isEmpty() ? domain : widened({std::sqrt(domain.lo), std::sqrt(domain.hi), domain.partial}, arithmeticUlps);
+    }
+    default: return interval::entire(true);
+    }
+}
+
+interval applyBinaryInterval(opCode op, interval a, interval b) {
+    switch (op)
+    {
+    case opCode::Add: return add(a, b);
+    case opCode::Subtract: return add(a, negate(b));
+    case opCode::Multiply: return multiply(a, b);
+    case opCode::Divide: return divide(a, b);
+    case opCode::Modulo: return modulo(a, b);
+    case opCode::Power: return power(a, b);
+    case opCode::LogBase: return divide(logarithm(b, [](double v) { return std::log(v); }), logarithm(a, [](double v) { return std::log(v); }));
+    case opCode::Nroot: return root(a, b);
+    default: return interval::entire(true);
+    }
+}
+
+/**
+ * @brief Un extremo vacío en cualquier operando deja vacío el resultado de las funciones de una entrada.
+ */
+interval keepEmpty(interval a, interval result) {
+    return a.isEmpty() ? interval::empty() : result;
+}
+
+} // namespace
+
+void evaluateIntervals(const bytecodeProgram& program, std::span<const intervalInputs> boxes, std::span<interval> output) {
+    if (boxes.size() != output.size())
+    {
+        throw std::runtime_error("[Evaluator Error]: La salida no tiene el tamaño de la entrada.");
+    }
+
+    std::vector<interval> registers(program.registerCount);
+    for (std::size_t c = 0; c < program.constants.size(); c++)
+    {
+        const double constant = program.constants[c];
+        registers[variableRegisterCount + c] = {constant, constant, !std::isfinite(constant)};
+    }
+
+    for (std::size_t i = 0; i < boxes.size(); i++)
+    {
+        registers[0] = boxes[i].x;
+        registers[1] = boxes[i].y;
+        registers[2] = boxes[i].z;
+        for (const instruction& step : program.code)
+        {
+            const interval left = registers[step.left];
+            interval value;
+            bool partial = left.partial;
+            if (operandCount(step.op) == 2)
+            {
+                const interval right = registers[step.right];
+                value = applyBinaryInterval(step.op, left, right);
+                partial = partial || right.partial;
+            }
+            else
+            {
+                value = keepEmpty(left, applyUnaryInterval(step.op, left));
+            }
+            // Un NaN o infinito intermedio puede acabar en un valor finito (1/inf = 0); la marca se conserva.
+            value.partial = value.partial || partial || std::isinf(value.lo) || std::isinf(value.hi);
+            registers[step.target] = value;
+        }
+        output[i] = registers[program.result];
+    }
+}
+
+interval evaluateInterval(const bytecodeProgram& program, const intervalInputs& box) {
+    interval result;
+    evaluateIntervals(program, std::span<const intervalInputs>(&box, 1), std::span<interval>(&result, 1));
+    return result;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file interval.hpp
+ * @brief Evaluación con aritmética de intervalos: cotas de f sobre una caja completa.
+ *
+ * Una sola evaluación sobre x en [a, b] (y lo mismo para y, z) devuelve un
+ * intervalo que contiene todos los valores que toma f en la caja,
+ * incluidos picos angostos y la cercanía de polos que un muestreo por puntos
+ * puede saltarse. Con eso se descartan regiones enteras de una gráfica o de
+ * una curva implícita f(x, y) = 0 de una vez: si 0 no está en el intervalo,
+ * la curva no pasa por la caja.
+ *
+ * Las cotas se redondean hacia afuera unos ulps para cubrir el redondeo de
+ * las operaciones y de las funciones de biblioteca (y de los núcleos SIMD).
+ * Las cotas son seguras pero no siempre ajustadas: una expresión que repite
+ * una variable (x - x) da un intervalo más ancho que el verdadero.
+ */
+#ifndef INTERVAL_HPP
+#define INTERVAL_HPP
+
+#include "program.hpp"
+#include <cstddef>
+#include <limits>
+#include <span>
+
+/**
+ * @struct interval
+ * @brief Conjunto [lo, hi] de valores, con una marca de dominio parcial.
+ *
+ * Como en IEEE, los infinitos son valores (log(0) = -inf y luego 1/-inf = 0),
+ * así que las cotas pueden serlo. Si lo > hi el intervalo está vacío: f da NaN
+ * en toda la caja (por ejemplo sqrt sobre [-2, -1]).
+ */
+struct interval {
+    double lo = 0.0; ///< Cota inferior
+    double hi = 0.0; ///< Cota superior
+    bool partial = false; ///< En parte de la caja f puede dar NaN o infinito (polo, fuera del dominio)
+
+    /**
+     * @brief Intervalo de un solo punto.
+     */
+    static constexpr interval point(double value) { return {value, value, false}; }
+
+    /**
+     * @brief Intervalo sin valores (f da NaN en toda la caja).
+     */
+    static constexpr interval empty() {
+        return {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), true};
+    }
+
+    /**
+     * @brief Toda la recta real.
+     */
+    static constexpr interval entire(bool partial = false) {
+        return {-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), partial};
+    }
+
+    constexpr bool isEmpty() const { return !(lo <= hi); }
+    constexpr bool contains(double value) const { return lo <= value && value <= hi; }
+};
+
+/**
+ * @struct intervalInputs
+ * @brief Caja de entrada: un intervalo por variable.
+ *
+ * Solo se leen los intervalos de las variables que usa el programa.
+ */
+struct intervalInputs {
+    interval x; ///< Valores de x
+    interval y; ///< Valores de y
+    interval z; ///< Valores de z
+};
+
+/**
+ * @brief Acota f sobre una caja.
+ *
+ * @param program Programa compilado.
+ * @param box Intervalo de cada variable usada.
+ * @return interval Intervalo que contiene todos los valores de f en la caja (salvo NaN).
+ */
+interval evaluateInterval(const bytecodeProgram& program, const intervalInputs& box);
+
+/**
+ * @brief Acota f sobre muchas cajas, reutilizando la memoria de trabajo.
+ *
+ * @param program Programa compilado.
+ * @param boxes Cajas de entrada.
+ * @param output Un intervalo por caja (mismo tamaño que boxes).
+ * @throws std::runtime_error Si los tamaños no coinciden.
+ */
+void evaluateIntervals(const bytecodeProgram& program, std::span<const intervalInputs> boxes, std::span<interval> output);
+
+#endif // INTERVAL_HPP
@@ -0,0 +1,551 @@
+/**
+ * @file jit.cpp
+ * @brief Generador de código x86-64 para programas de bytecode.
+ *
+ * La función generada procesa un bloque de muestras con la misma
+ * distribución de registros que el intérprete (un puntero a columna por
+ * registro del programa):
+ *
+ *     void bloque(double* const* registros, std::size_t cantidad);
+ *
+ * Las secuencias de operaciones aritméticas se fusionan en un bucle que
+ * avanza de a dos muestras (SSE2, parte de la base de x86-64) con un resto
+ * escalar; dentro del bucle cada valor intermedio ocupa un registro xmm y
+ * solo se escriben en memoria los que se leen después de la secuencia.
+ * Las demás operaciones son llamadas a los núcleos de la tabla activa.
+ */
+
+#include "jit.hpp"
+#include "../support/metrics.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(PLOTSYS_JIT) && defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define PLOTSYS_JIT_ENABLED 1
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Comprueba que estén todas las columnas que el programa necesita.
+ */
+void checkInputs(const bytecodeProgram& program, const variableInputs& inputs, std::size_t count) {
+    const std::span<const double>* columns[variableRegisterCount] = {&inputs.x, &inputs.y, &inputs.z};
+    for (std::size_t v = 0; v < variableRegisterCount; v++)
+    {
+        if (program.usesVariable(v) && columns[v]->size() != count)
+        {
+            throw std::runtime_error("[Evaluator Error]: La columna de una variable no coincide con el tamaño de la salida.");
+        }
+    }
+    if (!inputs.constants.empty() && inputs.constants.size() != program.constants.size())
+    {
+        throw std::runtime_error("[Evaluator Error]: La cantidad de constantes no coincide con la del programa.");
+    }
+}
+
+#ifdef PLOTSYS_JIT_ENABLED
+
+using blockFunction = void (*)(double* const* registers, std::size_t count);
+
+// Registros de propósito general según su codificación.
+constexpr int rax = 0, rcx = 1, rdx = 2, rbx = 3, rsi = 6, rdi = 7, r12 = 12, r13 = 13, r14 = 14;
+
+/// Registros xmm disponibles para valores; xmm14 y xmm15 guardan las máscaras de abs y negación.
+constexpr int valueRegisters = 14;
+constexpr int absMaskRegister = 14;
+constexpr int signMaskRegister = 15;
+
+alignas(16) constexpr std::uint64_t absMask[2] = {0x7FFFFFFFFFFFFFFFull, 0x7FFFFFFFFFFFFFFFull};
+alignas(16) constexpr std::uint64_t signMask[2] = {0x8000000000000000ull, 0x8000000000000000ull};
+
+/**
+ * @brief Indica si la operación se genera en línea (exacta, igual que el núcleo).
+ */
+bool isInline(opCode op) {
+    switch (op)
+    {
+    case opCode::Add:
+    case opCode::Subtract:
+    case opCode::Multiply:
+    case opCode::Divide:
+    case opCode::Negate:
+    case opCode::Abs:
+    case opCode::Sqrt:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @class assembler
+ * @brief Emite las pocas instrucciones x86-64 que necesita el generador.
+ */
+class assembler {
+public:
+    std::vector<std::uint8_t> bytes;
+
+    void byte(std::uint8_t value) { bytes.push_back(value); }
+
+    void dword(std::uint32_t value) {
+        for (int i = 0; i < 4; i++)
+        {
+            byte(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void qword(std::uint64_t value) {
+        for (int i = 0; i < 8; i++)
+        {
+            byte(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void prologue() {
+        byte(0x53); // push rbx
+        for (std::uint8_t r : {0x54, 0x55, 0x56, 0x57})
+        {
+            byte(0x41); // push r12..r15
+            byte(r);
+        }
+        move(rbx, rdi);
+        move(r12, rsi);
+    }
+
+    void epilogue() {
+        for (std::uint8_t r : {0x5F, 0x5E, 0x5D, 0x5C})
+        {
+            byte(0x41); // pop r15..r12
+            byte(r);
+        }
+        byte(0x5B); // pop rbx
+        byte(0xC3); // ret
+    }
+
+    /// mov dst, src
+    void move(int dst, int src) {
+        byte(static_cast<std::uint8_t>(0x48 | (src >= 8 ? 4 : 0) | (dst >= 8 ? 1 : 0)));
+        byte(0x89);
+        byte(static_cast<std::uint8_t>(0xC0 | (src & 7) << 3 | (dst & 7)));
+    }
+
+    /// mov dst, [rbx + 8 * reg]: puntero a la columna de un registro del programa
+    void loadColumn(int dst, std::uint16_t reg) {
+        byte(static_cast<std::uint8_t>(0x48 | (dst >= 8 ? 4 : 0)));
+        byte(0x8B);
+        byte(static_cast<std::uint8_t>(0x80 | (dst & 7) << 3 | rbx));
+        dword(8u * reg);
+    }
+
+    /// mov rax, imm64
+    void loadAddress(const void* address) {
+        byte(0x48);
+        byte(0xB8);
+        qword(reinterpret_cast<std::uint64_t>(address));
+    }
+
+    void callAddress(const void* address) {
+        loadAddress(address);
+        byte(0xFF); // call rax
+        byte(0xD0);
+    }
+
+    /// Instrucción SSE entre registros xmm.
+    void sse(std::uint8_t prefix, std::uint8_t opcode, int dst, int src) {
+        byte(prefix);
+        std::uint8_t rex = static_cast<std::uint8_t>(0x40 | (dst >= 8 ? 4 : 0) | (src >= 8 ? 1 : 0));
+        if (rex != 0x40)
+        {
+            byte(rex);
+        }
+        byte(0x0F);
+        byte(opcode);
+        byte(static_cast<std::uint8_t>(0xC0 | (dst & 7) << 3 | (src & 7)));
+    }
+
+    /// Instrucción SSE con memoria [rax + r13 * 8]: el elemento actual de una columna.
+    void sseElement(std::uint8_t prefix, std::uint8_t opcode, int xmm) {
+        byte(prefix);
+        byte(static_cast<std::uint8_t>(0x42 | (xmm >= 8 ? 4 : 0)));
+        byte(0x0F);
+        byte(opcode);
+        byte(static_cast<std::uint8_t>((xmm & 7) << 3 | 4));
+        byte(0xE8); // SIB: escala 8, índice r13, base rax
+    }
+
+    /// movupd xmm, [rax]
+    void loadVector(int xmm) {
+        byte(0x66);
+        if (xmm >= 8)
+        {
+            byte(0x44);
+        }
+        byte(0x0F);
+        byte(0x10);
+        byte(static_cast<std::uint8_t>((xmm & 7) << 3));
+    }
+
+    /// Salto condicional con destino por resolver; devuelve la posición a corregir.
+    std::size_t jump(std::uint8_t condition) {
+        byte(0x0F);
+        byte(condition);
+        dword(0);
+        return bytes.size();
+    }
+
+    void patch(std::size_t after, std::size_t target) {
+        std::uint32_t relative = static_cast<std::uint32_t>(static_cast<std::int64_t>(target) - static_cast<std::int64_t>(after));
+        std::memcpy(bytes.data() + after - 4, &relative, 4);
+    }
+
+    void jumpTo(std::uint8_t condition, std::size_t target) {
+        patch(jump(condition), target);
+    }
+};
+
+constexpr std::uint8_t jumpBelow = 0x82;
+constexpr std::uint8_t jumpAboveEqual = 0x83;
+
+/**
+ * @class codeGenerator
+ * @brief Traduce un programa a la función de bloque.
+ */
+class codeGenerator {
+public:
+    codeGenerator(const bytecodeProgram& program, const kernelTable& kernels)
+        : program(program), kernels(kernels) {}
+
+    std::vector<std::uint8_t> generate() {
+        out.prologue();
+        const std::vector<instruction>& code = program.code;
+        std::size_t i = 0;
+        while (i < code.size())
+        {
+            if (isInline(code[i].op))
+            {
+                std::size_t end = runEnd(i);
+                emitRun(i, end);
+                i = end;
+            }
+            else
+            {
+                emitCall(code[i]);
+                i++;
+            }
+        }
+        out.epilogue();
+        return std::move(out.bytes);
+    }
+
+private:
+    const bytecodeProgram& program;
+    const kernelTable& kernels;
+    assembler out;
+
+    /**
+     * @brief Fin de la secuencia aritmética que empieza en begin, limitada por los xmm disponibles.
+     */
+    std::size_t runEnd(std::size_t begin) const {
+        std::vector<std::uint16_t> held;
+        auto isHeld = [&held](std::uint16_t reg) { return std::find(held.begin(), held.end(), reg) != held.end(); };
+
+        int used = 0;
+        std::size_t i = begin;
+        for (; i < program.code.size() && isInline(program.code[i].op); i++)
+        {
+            const instruction& step = program.code[i];
+            const bool binary = operandCount(step.op) == 2;
+            int cost = 1;
+            cost += isHeld(step.left) ? 0 : 1;
+            cost += binary && step.right != step.left && !isHeld(step.right) ? 1 : 0;
+            if (used + cost > valueRegisters)
+            {
+                break;
+            }
+            used += cost;
+            held.push_back(step.left);
+            if (binary)
+            {
+                held.push_back(step.right);
+            }
+            held.push_back(step.target);
+        }
+        return i;
+    }
+
+    /**
+     * @brief Indica si el valor de reg al terminar la instrucción end - 1 se lee después.
+     */
+    bool liveAfter(std::uint16_t reg, std::size_t end) const {
+        for (std::size_t i = end; i < program.code.size(); i++)
+        {
+            const instruction& step = program.code[i];
+            if (step.left == reg || (operandCount(step.op) == 2 && step.right == reg))
+            {
+                return true;
+            }
+            if (step.target == reg)
+            {
+                return false;
+            }
+        }
+        return reg == program.result;
+    }
+
+    void emitCall(const instruction& step) {
+        const std::size_t op = static_cast<std::size_t>(step.op);
+        out.loadColumn(rdi, step.left);
+        if (operandCount(step.op) == 2)
+        {
+            out.loadColumn(rsi, step.right);
+            out.loadColumn(rdx, step.target);
+            out.move(rcx, r12);
+            out.callAddress(reinterpret_cast<const void*>(kernels.binary[op]));
+        }
+        else
+        {
+            out.loadColumn(rsi, step.target);
+            out.move(rdx, r12);
+            out.callAddress(reinterpret_cast<const void*>(kernels.unary[op]));
+        }
+    }
+
+    /**
+     * @brief Cuerpo de la secuencia para un paso de dos muestras (packed) o de una.
+     */
+    void emitBody(std::size_t begin, std::size_t end, const std::vector<std::uint16_t>& stored, bool packed) {
+        const std::uint8_t movePrefix = packed ? 0x66 : 0xF2; // movupd / movsd
+        const std::uint8_t mathPrefix = packed ? 0x66 : 0xF2; // ...pd / ...sd
+
+        std::vector<std::pair<std::uint16_t, int>> where; // Registro del programa -> xmm con su valor actual
+        int next = 0;
+        auto locate = [&where](std::uint16_t reg) {
+            for (auto it = where.rbegin(); it != where.rend(); ++it)
+            {
+                if (it->first == reg)
+                {
+                    return it->second;
+                }
+            }
+            return -1;
+        };
+        auto operand = [&](std::uint16_t reg) {
+            int xmm = locate(reg);
+            if (xmm < 0)
+            {
+                xmm = next++;
+                out.loadColumn(rax, reg);
+                out.sseElement(movePrefix, 0x10, xmm);
+                where.emplace_back(reg, xmm);
+            }
+            return xmm;
+        };
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const instruction& step = program.code[i];
+            const int a = operand(step.left);
+            const int b = operandCount(step.op) == 2 ? operand(step.right) : -1;
+            const int t = next++;
+            switch (step.op)
+            {
+            case opCode::Add: out.sse(0x66, 0x28, t, a); out.sse(mathPrefix, 0x58, t, b); break;
+            case opCode::Multiply: out.sse(0x66, 0x28, t, a); out.sse(mathPrefix, 0x59, t, b); break;
+            case opCode::Subtract: out.sse(0x66, 0x28, t, a); out.sse(mathPrefix, 0x5C, t, b); break;
+            case opCode::Divide: out.sse(0x66, 0x28, t, a); out.sse(mathPrefix, 0x5E, t, b); break;
+            case opCode::Sqrt: out.sse(mathPrefix, 0x51, t, a); break;
+            case opCode::Abs: out.sse(0x66, 0x28, t, a); out.sse(0x66, 0x54, t, absMaskRegister); break;
+            case opCode::Negate: out.sse(0x66, 0x28, t, a); out.sse(0x66, 0x57, t, signMaskRegister); break;
+            default: break;
+            }
+            where.emplace_back(step.target, t);
+        }
+
+        for (std::uint16_t reg : stored)
+        {
+            out.loadColumn(rax, reg);
+            out.sseElement(movePrefix, 0x11, locate(reg));
+        }
+    }
+
+    void emitRun(std::size_t begin, std::size_t end) {
+        // Solo se escriben los valores que se leen fuera de la secuencia.
+        std::vector<std::uint16_t> stored;
+        for (std::size_t i = begin; i < end; i++)
+        {
+            std::uint16_t target = program.code[i].target;
+            if (std::find(stored.begin(), stored.end(), target) == stored.end() && liveAfter(target, end))
+            {
+                stored.push_back(target);
+            }
+        }
+
+        out.loadAddress(absMask);
+        out.loadVector(absMaskRegister);
+        out.loadAddress(signMask);
+        out.loadVector(signMaskRegister);
+
+        // r13 = índice de la muestra, r14 = fin de la parte de a dos.
+        out.byte(0x45); out.byte(0x31); out.byte(0xED); // xor r13d, r13d
+        out.move(r14, r12);
+        out.byte(0x49); out.byte(0x83); out.byte(0xE6); out.byte(0xFE); // and r14, -2
+        out.byte(0x4D); out.byte(0x39); out.byte(0xF5); // cmp r13, r14
+        std::size_t skipLoop = out.jump(jumpAboveEqual);
+
+        std::size_t loop = out.bytes.size();
+        emitBody(begin, end, stored, true);
+        out.byte(0x49); out.byte(0x83); out.byte(0xC5); out.byte(0x02); // add r13, 2
+        out.byte(0x4D); out.byte(0x39); out.byte(0xF5); // cmp r13, r14
+        out.jumpTo(jumpBelow, loop);
+
+        out.patch(skipLoop, out.bytes.size());
+        out.byte(0x4D); out.byte(0x39); out.byte(0xE5); // cmp r13, r12
+        std::size_t skipTail = out.jump(jumpAboveEqual);
+        emitBody(begin, end, stored, false);
+        out.patch(skipTail, out.bytes.size());
+    }
+};
+
+/**
+ * @brief Copia el código a memoria ejecutable; nullptr si el sistema no lo permite.
+ */
+void* makeExecutable(const std::vector<std::uint8_t>& bytes, std::size_t& size) {
+    size = bytes.size();
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    std::memcpy(memory, bytes.data(), size);
+    if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0)
+    {
+        munmap(memory, size);
+        return nullptr;
+    }
+    return memory;
+}
+
+#endif // PLOTSYS_JIT_ENABLED
+
+} // namespace
+
+bool jitProgram::available() {
+#ifdef PLOTSYS_JIT_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+jitProgram::jitProgram(const bytecodeProgram& program)
+    : program(program) {
+#ifdef PLOTSYS_JIT_ENABLED
+    if (!program.code.empty() && program.precision == evaluationPrecision::Double)
+    {
+        code = makeExecutable(codeGenerator(program, activeKernels()).generate(), codeSize);
+    }
+#endif
+}
+
+jitProgram::~jitProgram() {
+    release();
+}
+
+jitProgram::jitProgram(jitProgram&& other) noexcept
+    : program(std::move(other.program)), code(other.code), codeSize(other.codeSize) {
+    other.code = nullptr;
+    other.codeSize = 0;
+}
+
+jitProgram& jitProgram::operator=(jitProgram&& other) noexcept {
+    if (this != &other)
+    {
+        release();
+        program = std::move(other.program);
+        code = other.code;
+        codeSize = other.codeSize;
+        other.code = nullptr;
+        other.codeSize = 0;
+    }
+    return *this;
+}
+
+void jitProgram::release() {
+#ifdef PLOTSYS_JIT_ENABLED
+    if (code != nullptr)
+    {
+        munmap(code, codeSize);
+    }
+#endif
+    code = nullptr;
+    codeSize = 0;
+}
+
+/**
+ * @brief Evalúa en todas las muestras con el código nativo, o con el intérprete si no lo hay.
+ *
+ * @param inputs Columnas de las variables usadas por el programa.
+ * @param output Columna donde se escribe f en cada muestra.
+ */
+void jitProgram::evaluate(const variableInputs& inputs, std::span<double> output) const {
+#ifdef PLOTSYS_JIT_ENABLED
+    if (code == nullptr)
+    {
+        evaluateBatch(program, inputs, output);
+        return;
+    }
+
+    const std::size_t count = output.size();
+    checkInputs(program, inputs, count);
+    if (count == 0)
+    {
+        return;
+    }
+    stageTimer timer(metricStage::Evaluate);
+
+    // Misma distribución de columnas que el intérprete (ver evaluator.cpp).
+    const std::size_t firstTemporary = program.firstTemporary();
+    const std::size_t chunk = std::min(count, evaluationChunk);
+    std::vector<double> scratch((program.registerCount - variableRegisterCount) * chunk);
+    std::vector<double*> registers(program.registerCount, nullptr);
+    const std::span<const double> constants = inputs.constants.empty() ? std::span<const double>(program.constants) : inputs.constants;
+    for (std::size_t c = 0; c < constants.size(); c++)
+    {
+        double* column = scratch.data() + c * chunk;
+        std::fill(column, column + chunk, constants[c]);
+        registers[variableRegisterCount + c] = column;
+    }
+    for (std::size_t r = firstTemporary; r < program.registerCount; r++)
+    {
+        registers[r] = scratch.data() + (r - variableRegisterCount) * chunk;
+    }
+
+    const blockFunction block = reinterpret_cast<blockFunction>(code);
+    const double* columns[variableRegisterCount] = {inputs.x.data(), inputs.y.data(), inputs.z.data()};
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+        const std::size_t length = std::min(chunk, count - start);
+        for (std::size_t v = 0; v < variableRegisterCount; v++)
+        {
+            if (program.usesVariable(v))
+            {
+                registers[v] = const_cast<double*>(columns[v] + start);
+            }
+        }
+
+        block(registers.data(), length);
+
+        const double* result = registers[program.result];
+        std::copy(result, result + length, output.data() + start);
+    }
+    recordEvaluated(output);
+#else
+    checkInputs(program, inputs, output.size());
+    evaluateBatch(program, inputs, output);
+#endif
+}
@@ -0,0 +1,86 @@
+/**
+ * @file jit.hpp
+ * @brief Traducción opcional del bytecode a código máquina x86-64.
+ *
+ * El evaluador por lotes recorre el programa instrucción por instrucción
+ * en cada bloque de muestras. El JIT elimina ese despacho y además fusiona
+ * las secuencias de operaciones aritméticas (+ - * /, negación, abs, sqrt)
+ * en un único bucle cuyos intermedios viven en registros xmm, sin pasar
+ * por memoria. El resto de operaciones llama directamente al núcleo SIMD
+ * activo, igual que el intérprete, así que los resultados coinciden bit a bit.
+ *
+ * Solo está disponible si se compila con PLOTSYS_JIT definido, en x86-64 con
+ * la convención de llamadas System V (Linux, macOS) y si el sistema permite
+ * memoria ejecutable, y solo para programas con precisión Double. En
+ * cualquier otro caso jitProgram evalúa con el intérprete, de modo que el
+ * código que lo usa no necesita distinguir. Ese respaldo es evaluateBatch()
+ * y respeta program.precision: con Single o Fast se evalúa en float con la
+ * tabla activa, así que el resultado es el del intérprete en esa precisión,
+ * no el de double.
+ */
+#ifndef JIT_HPP
+#define JIT_HPP
+
+#include "evaluator.hpp"
+#include "program.hpp"
+#include <cstddef>
+#include <span>
+
+/**
+ * @class jitProgram
+ * @brief Programa compilado a código nativo, con el intérprete como respaldo.
+ */
+class jitProgram {
+public:
+    /**
+     * @brief Genera el código nativo del programa (si el JIT está disponible).
+     *
+     * Las operaciones no aritméticas usan la tabla de núcleos activa en este momento.
+     *
+     * @param program Programa compilado; se guarda una copia.
+     */
+    explicit jitProgram(const bytecodeProgram& program);
+
+    ~jitProgram();
+
+    jitProgram(const jitProgram&) = delete;
+    jitProgram& operator=(const jitProgram&) = delete;
+    jitProgram(jitProgram&& other) noexcept;
+    jitProgram& operator=(jitProgram&& other) noexcept;
+
+    /**
+     * @brief Indica si se generó código nativo o se usa el intérprete.
+     */
+    bool isNative() const { return code != nullptr; }
+
+    /**
+     * @brief Programa del que se generó el código.
+     */
+    const bytecodeProgram& bytecode() const { return program; }
+
+    /**
+     * @brief Evalúa en todas las muestras; mismo contrato que evaluateBatch().
+     *
+     * Sin código nativo llama a evaluateBatch(), que con precisión Single o
+     * Fast usa el intérprete en float.
+     *
+     * @param inputs Columnas de las variables usadas por el programa.
+     * @param output Columna donde se escribe f en cada muestra.
+     * @throws std::runtime_error Si falta una variable o los tamaños no coinciden.
+     */
+    void evaluate(const variableInputs& inputs, std::span<double> output) const;
+
+    /**
+     * @brief Indica si esta compilación incluye el JIT y el procesador lo admite.
+     */
+    static bool available();
+
+private:
+    bytecodeProgram program; ///< Registros, constantes y respaldo interpretado
+    void* code = nullptr; ///< Código ejecutable, o nullptr si se interpreta
+    std::size_t codeSize = 0; ///< Bytes reservados para el código
+
+    void release();
+};
+
+#endif // JIT_HPP
@@ -0,0 +1,214 @@
+/**
+ * @file kernels.cpp
+ * @brief Núcleos escalares de referencia y selección de la tabla SIMD en tiempo de ejecución.
+ */
+
+#include "kernels.hpp"
+#include "scalar_ops.hpp"
+#include <cstdlib>
+#include <string_view>
+
+// Cada tabla vive en su propio archivo, compilado con las opciones de su conjunto
+// de instrucciones. Devuelven nullptr si el archivo se compiló sin soporte.
+const kernelTable* sse2KernelTable();
+const kernelTable* avx2KernelTable();
+const kernelTable* avx512KernelTable();
+const kernelTable* neonKernelTable();
+const floatKernelTable* sse2FloatKernelTable(bool relaxed);
+const floatKernelTable* avx2FloatKernelTable(bool relaxed);
+const floatKernelTable* avx512FloatKernelTable(bool relaxed);
+const floatKernelTable* neonFloatKernelTable(bool relaxed);
+
+namespace {
+
+template <opCode op>
+void scalarUnary(const double* a, double* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++)
+    {
+        out[i] = applyUnary(op, a[i]);
+    }
+}
+
+template <opCode op>
+void scalarBinary(const double* a, const double* b, double* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++)
+    {
+        out[i] = applyBinary(op, a[i], b[i]);
+    }
+}
+
+template <opCode op>
+void scalarFloatUnary(const float* a, float* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++)
+    {
+        out[i] = static_cast<float>(applyUnary(op, a[i]));
+    }
+}
+
+template <opCode op>
+void scalarFloatBinary(const float* a, const float* b, float* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++)
+    {
+        out[i] = static_cast<float>(applyBinary(op, a[i], b[i]));
+    }
+}
+
+template <opCode... ops>
+void fillUnary(kernelTable& table) {
+    ((table.unary[static_cast<std::size_t>(ops)] = scalarUnary<ops>), ...);
+}
+
+template <opCode... ops>
+void fillBinary(kernelTable& table) {
+    ((table.binary[static_cast<std::size_t>(ops)] = scalarBinary<ops>), ...);
+}
+
+template <opCode... ops>
+void fillUnary(floatKernelTable& table) {
+    ((table.unary[static_cast<std::size_t>(ops)] = scalarFloatUnary<ops>), ...);
+}
+
+template <opCode... ops>
+void fillBinary(floatKernelTable& table) {
+    ((table.binary[static_cast<std::size_t>(ops)] = scalarFloatBinary<ops>), ...);
+}
+
+/**
+ * @brief Tabla (de double o de float) con los núcleos escalares de todas las operaciones.
+ */
+template <class Table>
+Table buildScalarTable(const char* name) {
+    Table table{};
+    table.name = name;
+    fillUnary<opCode::Negate, opCode::Sin, opCode::Cos, opCode::Tan, opCode::Sec, opCode::Csc, opCode::Cot,
+        opCode::Asin, opCode::Acos, opCode::Atan, opCode::Asec, opCode::Acsc, opCode::Acot,
+        opCode::Log, opCode::Ln, opCode::Sqrt, opCode::Abs>(table);
+    fillBinary<opCode::Add, opCode::Subtract, opCode::Multiply, opCode::Divide, opCode::Modulo,
+        opCode::Power, opCode::LogBase, opCode::Nroot>(table);
+    return table;
+}
+
+/**
+ * @brief Indica si el procesador soporta el conjunto de instrucciones.
+ */
+bool cpuSupports(simdLevel level) {
+    switch (level)
+    {
+    case simdLevel::Scalar:
+        return true;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    case simdLevel::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case simdLevel::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case simdLevel::AVX512:
+        return __builtin_cpu_supports("avx512f");
+#elif defined(_M_X64)
+    case simdLevel::SSE2:
+        return true;
+#endif
+    case simdLevel::NEON:
+        return neonKernelTable() != nullptr; // Parte de la base de AArch64
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Nivel pedido mediante la variable de entorno PLOTSYS_SIMD, si existe.
+ */
+bool requestedLevel(simdLevel& level) {
+    const char* value = std::getenv("PLOTSYS_SIMD");
+    if (value == nullptr)
+    {
+        return false;
+    }
+    std::string_view name(value);
+    if (name == "scalar") level = simdLevel::Scalar;
+    else if (name == "sse2") level = simdLevel::SSE2;
+    else if (name == "avx2") level = simdLevel::AVX2;
+    else if (name == "avx512") level = simdLevel::AVX512;
+    else if (name == "neon") level = simdLevel::NEON;
+    else return false;
+    return true;
+}
+
+/**
+ * @brief Conjunto de instrucciones del evaluador: el pedido en PLOTSYS_SIMD o el mejor disponible.
+ */
+simdLevel selectLevel() {
+    simdLevel forced;
+    if (requestedLevel(forced) && kernelsFor(forced) != nullptr)
+    {
+        return forced;
+    }
+
+    for (simdLevel level : {simdLevel::AVX512, simdLevel::AVX2, simdLevel::SSE2, simdLevel::NEON})
+    {
+        if (kernelsFor(level) != nullptr)
+        {
+            return level;
+        }
+    }
+    return simdLevel::Scalar;
+}
+
+simdLevel activeLevel() {
+    static const simdLevel level = selectLevel();
+    return level;
+}
+
+} // namespace
+
+const kernelTable& scalarKernels() {
+    static const kernelTable table = buildScalarTable<kernelTable>("scalar");
+    return table;
+}
+
+const kernelTable* kernelsFor(simdLevel level) {
+    if (!cpuSupports(level))
+    {
+        return nullptr;
+    }
+    switch (level)
+    {
+    case simdLevel::Scalar: return &scalarKernels();
+    case simdLevel::SSE2: return sse2KernelTable();
+    case simdLevel::AVX2: return avx2KernelTable();
+    case simdLevel::AVX512: return avx512KernelTable();
+    case simdLevel::NEON: return neonKernelTable();
+    }
+    return nullptr;
+}
+
+const kernelTable& activeKernels() {
+    static const kernelTable& table = *kernelsFor(activeLevel());
+    return table;
+}
+
+const floatKernelTable& scalarFloatKernels() {
+    static const floatKernelTable table = buildScalarTable<floatKernelTable>("scalar-float");
+    return table;
+}
+
+const floatKernelTable* floatKernelsFor(simdLevel level, bool relaxed) {
+    if (!cpuSupports(level))
+    {
+        return nullptr;
+    }
+    switch (level)
+    {
+    case simdLevel::Scalar: return &scalarFloatKernels();
+    case simdLevel::SSE2: return sse2FloatKernelTable(relaxed);
+    case simdLevel::AVX2: return avx2FloatKernelTable(relaxed);
+    case simdLevel::AVX512: return avx512FloatKernelTable(relaxed);
+    case simdLevel::NEON: return neonFloatKernelTable(relaxed);
+    }
+    return nullptr;
+}
+
+const floatKernelTable& activeFloatKernels(bool relaxed) {
+    static const floatKernelTable& exact = *floatKernelsFor(activeLevel(), false);
+    static const floatKernelTable& fast = *floatKernelsFor(activeLevel(), true);
+    return relaxed ? fast : exact;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file kernels.hpp
+ * @brief Núcleos de cálculo por columnas, con versiones vectorizadas (SIMD).
+ *
+ * Cada operación del bytecode tiene un núcleo que la aplica a n valores
+ * contiguos. Hay una tabla de núcleos por conjunto de instrucciones; al
+ * iniciar se elige la mejor que soporte el procesador:
+ * AVX-512 > AVX2+FMA > SSE2 (x86-64) o NEON (ARM64), y si ninguna está
+ * disponible, la versión escalar basada en <cmath>.
+ *
+ * La variable de entorno PLOTSYS_SIMD (scalar, sse2, avx2, avx512, neon)
+ * fuerza una tabla concreta, útil para comparar rendimiento y resultados.
+ *
+ * Precisión de los caminos vectorizados, medida contra <cmath> (incluyendo
+ * argumentos pegados a múltiplos de pi/2):
+ * - + - * / negación, abs, sqrt y %: exactos (redondeo IEEE, igual que el escalar).
+ * - sin, cos: error <= 2 ulp para |x| <= 1e6 (más allá se usa <cmath>).
+ * - sec, csc: error <= 2 ulp; tan, cot: error <= 3 ulp (se obtienen de sin y cos).
+ * - ln: error <= 1 ulp; log (base 10): error <= 2 ulp; log_base: error <= 4
+ *   ulp (cociente de dos ln).
+ * - atan, acot: error <= 1 ulp; asin, acos, asec, acsc: error <= 3 ulp (vía
+ *   atan, y asec y acsc a partir de 1/x redondeado, como el escalar).
+ * - ^ y nroot: error <= 1 ulp (pow de fdlibm); las potencias enteras
+ *   representables salen exactas. Solo en las tablas de 4 carriles o más:
+ *   con dos (SSE2, NEON) el cálculo vectorial es más lento que <cmath>.
+ * Valores fuera del dominio del polinomio (cero, negativos, subnormales,
+ * infinitos, NaN) se resuelven con <cmath> en el carril correspondiente, y
+ * también % con |a/b| >= 2^51 y las potencias cuyo resultado desbordaría o
+ * sería subnormal.
+ *
+ * Además hay tablas en float (floatKernelTable) para las precisiones Single
+ * y Fast de evaluationPrecision, con el doble de carriles por registro:
+ * - Single: vectoriza + - * /, negación, abs, sqrt, las trigonométricas, ln,
+ *   log, atan y acot, con los polinomios de precisión simple de Cephes; error
+ *   <= 2 ulp de float en sin, cos y log para |x| <= 8192, <= 3 ulp en atan,
+ *   <= 1 ulp en ln y <= 4 ulp en tan, cot, sec, csc y acot. Los carriles
+ *   especiales (y las operaciones sin versión vectorial) se calculan en
+ *   double y se redondean a float.
+ * - Fast: además vectoriza ^, nroot, log_base, asin, acos, asec y acsc (vía
+ *   exp, ln y atan, con error relativo de hasta |y ln x| * 2^-23 en x^y y
+ *   <= 4 ulp en las funciones de arco). En nroot(n, x) el exponente 1/n se
+ *   redondea a float: el margen es 1.5 veces el de ^ y, con x negativo, la
+ *   paridad de 1/n redondeado decide el signo o el NaN. Resuelve ceros,
+ *   negativos e infinitos de ln con selecciones en el propio carril y solo
+ *   pasa a <cmath> en las trigonométricas para |x| > 2^21; entre 8192 y 2^21
+ *   el error de sin y cos pasa a ser absoluto (hasta 0.06 sin FMA), y tan,
+ *   cot, sec y csc lo amplifican. No distingue -0 de 0 en ^, csc ni cot, y
+ *   las exponenciales por debajo de 1e-37 dan 0.
+ *
+ * plotsys_differential (fuzz/) compara cada tabla con la escalar dentro de
+ * estos márgenes.
+ */
+#ifndef KERNELS_HPP
+#define KERNELS_HPP
+
+#include "../parser/ast.hpp"
+#include <cstddef>
+
+/// Cantidad de operaciones distintas (tamaño de las tablas de núcleos).
+constexpr std::size_t opCodeCount = static_cast<std::size_t>(opCode::Nroot) + 1;
+
+/// Núcleo de una operación de un operando: out[i] = f(a[i]). out puede ser igual a a.
+using unaryKernel = void (*)(const double* a, double* out, std::size_t count);
+
+/// Núcleo de una operación de dos operandos: out[i] = f(a[i], b[i]). out puede ser igual a a o b.
+using binaryKernel = void (*)(const double* a, const double* b, double* out, std::size_t count);
+
+/**
+ * @struct kernelTable
+ * @brief Núcleos de cada operación para un conjunto de instrucciones.
+ *
+ * Las entradas se indexan con el valor de opCode; las que no aplican
+ * (operaciones binarias en unary y viceversa) quedan en nullptr.
+ */
+struct kernelTable {
+    const char* name; ///< Nombre del conjunto de instrucciones (ej: "avx2")
+    unaryKernel unary[opCodeCount]; ///< Núcleos de un operando
+    binaryKernel binary[opCodeCount]; ///< Núcleos de dos operandos
+};
+
+/// Núcleo en float de una operación de un operando (ver unaryKernel).
+using unaryFloatKernel = void (*)(const float* a, float* out, std::size_t count);
+
+/// Núcleo en float de una operación de dos operandos (ver binaryKernel).
+using binaryFloatKernel = void (*)(const float* a, const float* b, float* out, std::size_t count);
+
+/**
+ * @struct floatKernelTable
+ * @brief Núcleos en float de cada operación para un conjunto de instrucciones.
+ */
+struct floatKernelTable {
+    const char* name; ///< Nombre del conjunto de instrucciones y la precisión (ej: "avx2-fast")
+    unaryFloatKernel unary[opCodeCount]; ///< Núcleos de un operando
+    binaryFloatKernel binary[opCodeCount]; ///< Núcleos de dos operandos
+};
+
+/**
+ * @enum simdLevel
+ * @brief Conjuntos de instrucciones para los que existe una tabla de núcleos.
+ */
+enum class simdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON,
+};
+
+/**
+ * @brief Tabla escalar de referencia (siempre disponible).
+ */
+const kernelTable& scalarKernels();
+
+/**
+ * @brief Tabla para un conjunto de instrucciones concreto.
+ *
+ * @param level Conjunto de instrucciones pedido.
+ * @return const kernelTable* La tabla, o nullptr si no fue compilada o el procesador no la soporta.
+ */
+const kernelTable* kernelsFor(simdLevel level);
+
+/**
+ * @brief Tabla que usa el evaluador por defecto (la mejor disponible).
+ *
+ * Se elige una sola vez, en la primera llamada.
+ */
+const kernelTable& activeKernels();
+
+/**
+ * @brief Tabla escalar en float: cada operación se calcula en double y se redondea.
+ */
+const floatKernelTable& scalarFloatKernels();
+
+/**
+ * @brief Tabla en float para un conjunto de instrucciones concreto.
+ *
+ * @param level Conjunto de instrucciones pedido.
+ * @param relaxed true para la precisión Fast, false para Single.
+ * @return const floatKernelTable* La tabla, o nullptr si no fue compilada o el procesador no la soporta.
+ */
+const floatKernelTable* floatKernelsFor(simdLevel level, bool relaxed);
+
+/**
+ * @brief Tabla en float que usa el evaluador, del mismo nivel que activeKernels().
+ *
+ * @param relaxed true para la precisión Fast, false para Single.
+ */
+const floatKernelTable& activeFloatKernels(bool relaxed);
+
+#endif // KERNELS_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file kernels_avx2.cpp
+ * @brief Tabla de núcleos para AVX2 + FMA (4 doubles u 8 floats por registro).
+ *
+ * Este archivo debe compilarse con -mavx2 -mfma; sin esas opciones solo
+ * aporta una tabla vacía y el selector sigue con el siguiente nivel.
+ */
+
+#include "kernels.hpp"
+
+#if defined(__AVX2__) && defined(__FMA__)
+
+#include "simd_math.hpp"
+#include "simd_math_float.hpp"
+#include <immintrin.h>
+
+namespace {
+
+struct avx2Lane {
+    using reg = __m256d;
+    using mask = __m256d;
+    static constexpr std::size_t width = 4;
+    static constexpr bool fusedFma = true;
+
+    static reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+    static reg set(double v) { return _mm256_set1_pd(v); }
+    static reg setBits(std::uint64_t bits) { return _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm256_fmadd_pd(a, b, c); }
+    static reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+
+    static reg bitAnd(reg a, reg b) { return _mm256_and_pd(a, b); }
+    static reg bitOr(reg a, reg b) { return _mm256_or_pd(a, b); }
+    static reg bitXor(reg a, reg b) { return _mm256_xor_pd(a, b); }
+    template <int n> static reg shiftLeft(reg a) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static mask notLessEqual(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_NLE_UQ); }
+    static mask maskOr(mask a, mask b) { return _mm256_or_pd(a, b); }
+    static mask maskAnd(mask a, mask b) { return _mm256_and_pd(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_pd(b, a, m); }
+    static int maskBits(mask m) { return _mm256_movemask_pd(m); }
+};
+
+struct avx2FloatLane {
+    using reg = __m256;
+    using mask = __m256;
+    static constexpr std::size_t width = 8;
+
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    static reg set(float v) { return _mm256_set1_ps(v); }
+    static reg setBits(std::uint32_t bits) { return _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm256_fmadd_ps(a, b, c); }
+    static reg sqrt(reg a) { return _mm256_sqrt_ps(a); }
+
+    static reg bitAnd(reg a, reg b) { return _mm256_and_ps(a, b); }
+    static reg bitOr(reg a, reg b) { return _mm256_or_ps(a, b); }
+    static reg bitXor(reg a, reg b) { return _mm256_xor_ps(a, b); }
+    template <int n> static reg shiftLeft(reg a) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm256_castsi256_ps(_mm256_srli_epi32(_mm256_castps_si256(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static mask notLessEqual(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_NLE_UQ); }
+    static mask equal(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static mask maskOr(mask a, mask b) { return _mm256_or_ps(a, b); }
+    static mask maskAnd(mask a, mask b) { return _mm256_and_ps(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_ps(b, a, m); }
+    static int maskBits(mask m) { return _mm256_movemask_ps(m); }
+};
+
+} // namespace
+
+const kernelTable* avx2KernelTable() {
+    static const kernelTable table = simdMath::makeKernelTable<avx2Lane>("avx2");
+    return &table;
+}
+
+const floatKernelTable* avx2FloatKernelTable(bool relaxed) {
+    static const floatKernelTable single = simdMathFloat::makeFloatKernelTable<avx2FloatLane>("avx2-single", false);
+    static const floatKernelTable fast = simdMathFloat::makeFloatKernelTable<avx2FloatLane>("avx2-fast", true);
+    return relaxed ? &fast : &single;
+}
+
+#else
+
+const kernelTable* avx2KernelTable() {
+    return nullptr;
+}
+
+const floatKernelTable* avx2FloatKernelTable(bool) {
+    return nullptr;
+}
+
+#endif
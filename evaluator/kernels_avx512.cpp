@@ -0,0 +1,124 @@
+/**
+ * @file kernels_avx512.cpp
+ * @brief Tabla de núcleos para AVX-512F (8 doubles o 16 floats por registro).
+ *
+ * Este archivo debe compilarse con -mavx512f; sin esa opción solo aporta
+ * una tabla vacía y el selector sigue con el siguiente nivel. Solo usa
+ * instrucciones de AVX-512F (las operaciones de bits van por enteros).
+ */
+
+#include "kernels.hpp"
+
+#if defined(__AVX512F__)
+
+#include "simd_math.hpp"
+#include "simd_math_float.hpp"
+#include <immintrin.h>
+
+// GCC 12 avisa de que "__Y" se usa (o puede usarse) sin inicializar dentro
+// de los propios intrínsecos de avx512fintrin.h, en los _mm512_undefined_*
+// (falso positivo, corregido en GCC 13). El aviso se emite en la
+// cadena de inlining de los métodos de las lanes, así que se silencia solo
+// en sus definiciones.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+
+namespace {
+
+struct avx512Lane {
+    using reg = __m512d;
+    using mask = __mmask8;
+    static constexpr std::size_t width = 8;
+    static constexpr bool fusedFma = true;
+
+    static reg load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm512_storeu_pd(p, v); }
+    static reg set(double v) { return _mm512_set1_pd(v); }
+    static reg setBits(std::uint64_t bits) { return _mm512_castsi512_pd(_mm512_set1_epi64(static_cast<long long>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm512_fmadd_pd(a, b, c); }
+    static reg sqrt(reg a) { return _mm512_sqrt_pd(a); }
+
+    static __m512i bits(reg a) { return _mm512_castpd_si512(a); }
+    static reg bitAnd(reg a, reg b) { return _mm512_castsi512_pd(_mm512_and_epi64(bits(a), bits(b))); }
+    static reg bitOr(reg a, reg b) { return _mm512_castsi512_pd(_mm512_or_epi64(bits(a), bits(b))); }
+    static reg bitXor(reg a, reg b) { return _mm512_castsi512_pd(_mm512_xor_epi64(bits(a), bits(b))); }
+    template <int n> static reg shiftLeft(reg a) { return _mm512_castsi512_pd(_mm512_slli_epi64(bits(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm512_castsi512_pd(_mm512_srli_epi64(bits(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static mask notLessEqual(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_NLE_UQ); }
+    static mask maskOr(mask a, mask b) { return static_cast<mask>(a | b); }
+    static mask maskAnd(mask a, mask b) { return static_cast<mask>(a & b); }
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_blend_pd(m, b, a); }
+    static int maskBits(mask m) { return static_cast<int>(m); }
+};
+
+struct avx512FloatLane {
+    using reg = __m512;
+    using mask = __mmask16;
+    static constexpr std::size_t width = 16;
+
+    static reg load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm512_storeu_ps(p, v); }
+    static reg set(float v) { return _mm512_set1_ps(v); }
+    static reg setBits(std::uint32_t bits) { return _mm512_castsi512_ps(_mm512_set1_epi32(static_cast<int>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm512_fmadd_ps(a, b, c); }
+    static reg sqrt(reg a) { return _mm512_sqrt_ps(a); }
+
+    static __m512i bits(reg a) { return _mm512_castps_si512(a); }
+    static reg bitAnd(reg a, reg b) { return _mm512_castsi512_ps(_mm512_and_epi32(bits(a), bits(b))); }
+    static reg bitOr(reg a, reg b) { return _mm512_castsi512_ps(_mm512_or_epi32(bits(a), bits(b))); }
+    static reg bitXor(reg a, reg b) { return _mm512_castsi512_ps(_mm512_xor_epi32(bits(a), bits(b))); }
+    template <int n> static reg shiftLeft(reg a) { return _mm512_castsi512_ps(_mm512_slli_epi32(bits(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm512_castsi512_ps(_mm512_srli_epi32(bits(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static mask notLessEqual(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_NLE_UQ); }
+    static mask equal(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static mask maskOr(mask a, mask b) { return static_cast<mask>(a | b); }
+    static mask maskAnd(mask a, mask b) { return static_cast<mask>(a & b); }
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_blend_ps(m, b, a); }
+    static int maskBits(mask m) { return static_cast<int>(m); }
+};
+
+} // namespace
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 13
+#pragma GCC diagnostic pop
+#endif
+
+const kernelTable* avx512KernelTable() {
+    static const kernelTable table = simdMath::makeKernelTable<avx512Lane>("avx512");
+    return &table;
+}
+
+const floatKernelTable* avx512FloatKernelTable(bool relaxed) {
+    static const floatKernelTable single = simdMathFloat::makeFloatKernelTable<avx512FloatLane>("avx512-single", false);
+    static const floatKernelTable fast = simdMathFloat::makeFloatKernelTable<avx512FloatLane>("avx512-fast", true);
+    return relaxed ? &fast : &single;
+}
+
+#else
+
+const kernelTable* avx512KernelTable() {
+    return nullptr;
+}
+
+const floatKernelTable* avx512FloatKernelTable(bool) {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file kernels_neon.cpp
+ * @brief Tabla de núcleos para NEON de ARM64 (2 doubles o 4 floats por registro).
+ *
+ * NEON con doubles forma parte de la base de AArch64; en otras
+ * arquitecturas este archivo solo aporta una tabla vacía.
+ */
+
+#include "kernels.hpp"
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+
+#include "simd_math.hpp"
+#include "simd_math_float.hpp"
+#include <arm_neon.h>
+
+namespace {
+
+struct neonLane {
+    using reg = float64x2_t;
+    using mask = uint64x2_t;
+    static constexpr std::size_t width = 2;
+    static constexpr bool fusedFma = true;
+
+    static reg load(const double* p) { return vld1q_f64(p); }
+    static void store(double* p, reg v) { vst1q_f64(p, v); }
+    static reg set(double v) { return vdupq_n_f64(v); }
+    static reg setBits(std::uint64_t bits) { return vreinterpretq_f64_u64(vdupq_n_u64(bits)); }
+
+    static reg add(reg a, reg b) { return vaddq_f64(a, b); }
+    static reg sub(reg a, reg b) { return vsubq_f64(a, b); }
+    static reg mul(reg a, reg b) { return vmulq_f64(a, b); }
+    static reg div(reg a, reg b) { return vdivq_f64(a, b); }
+    static reg fma(reg a, reg b, reg c) { return vfmaq_f64(c, a, b); }
+    static reg sqrt(reg a) { return vsqrtq_f64(a); }
+
+    static uint64x2_t bits(reg a) { return vreinterpretq_u64_f64(a); }
+    static reg bitAnd(reg a, reg b) { return vreinterpretq_f64_u64(vandq_u64(bits(a), bits(b))); }
+    static reg bitOr(reg a, reg b) { return vreinterpretq_f64_u64(vorrq_u64(bits(a), bits(b))); }
+    static reg bitXor(reg a, reg b) { return vreinterpretq_f64_u64(veorq_u64(bits(a), bits(b))); }
+    template <int n> static reg shiftLeft(reg a) { return vreinterpretq_f64_u64(vshlq_n_u64(bits(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return vreinterpretq_f64_u64(vshrq_n_u64(bits(a), n)); }
+
+    static mask less(reg a, reg b) { return vcltq_f64(a, b); }
+    static mask notLessEqual(reg a, reg b) { return veorq_u64(vcleq_f64(a, b), vdupq_n_u64(~0ull)); }
+    static mask maskOr(mask a, mask b) { return vorrq_u64(a, b); }
+    static mask maskAnd(mask a, mask b) { return vandq_u64(a, b); }
+    static reg select(mask m, reg a, reg b) { return vbslq_f64(m, a, b); }
+    static int maskBits(mask m) {
+        return static_cast<int>(vgetq_lane_u64(m, 0) & 1u) | static_cast<int>((vgetq_lane_u64(m, 1) & 1u) << 1);
+    }
+};
+
+struct neonFloatLane {
+    using reg = float32x4_t;
+    using mask = uint32x4_t;
+    static constexpr std::size_t width = 4;
+
+    static reg load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, reg v) { vst1q_f32(p, v); }
+    static reg set(float v) { return vdupq_n_f32(v); }
+    static reg setBits(std::uint32_t bits) { return vreinterpretq_f32_u32(vdupq_n_u32(bits)); }
+
+    static reg add(reg a, reg b) { return vaddq_f32(a, b); }
+    static reg sub(reg a, reg b) { return vsubq_f32(a, b); }
+    static reg mul(reg a, reg b) { return vmulq_f32(a, b); }
+    static reg div(reg a, reg b) { return vdivq_f32(a, b); }
+    static reg fma(reg a, reg b, reg c) { return vfmaq_f32(c, a, b); }
+    static reg sqrt(reg a) { return vsqrtq_f32(a); }
+
+    static uint32x4_t bits(reg a) { return vreinterpretq_u32_f32(a); }
+    static reg bitAnd(reg a, reg b) { return vreinterpretq_f32_u32(vandq_u32(bits(a), bits(b))); }
+    static reg bitOr(reg a, reg b) { return vreinterpretq_f32_u32(vorrq_u32(bits(a), bits(b))); }
+    static reg bitXor(reg a, reg b) { return vreinterpretq_f32_u32(veorq_u32(bits(a), bits(b))); }
+    template <int n> static reg shiftLeft(reg a) { return vreinterpretq_f32_u32(vshlq_n_u32(bits(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return vreinterpretq_f32_u32(vshrq_n_u32(bits(a), n)); }
+
+    static mask less(reg a, reg b) { return vcltq_f32(a, b); }
+    static mask notLessEqual(reg a, reg b) { return vmvnq_u32(vcleq_f32(a, b)); }
+    static mask equal(reg a, reg b) { return vceqq_f32(a, b); }
+    static mask maskOr(mask a, mask b) { return vorrq_u32(a, b); }
+    static mask maskAnd(mask a, mask b) { return vandq_u32(a, b); }
+    static reg select(mask m, reg a, reg b) { return vbslq_f32(m, a, b); }
+    static int maskBits(mask m) {
+        return static_cast<int>(vgetq_lane_u32(m, 0) & 1u) | static_cast<int>((vgetq_lane_u32(m, 1) & 1u) << 1)
+            | static_cast<int>((vgetq_lane_u32(m, 2) & 1u) << 2) | static_cast<int>((vgetq_lane_u32(m, 3) & 1u) << 3);
+    }
+};
+
+} // namespace
+
+const kernelTable* neonKernelTable() {
+    static const kernelTable table = simdMath::makeKernelTable<neonLane>("neon");
+    return &table;
+}
+
+const floatKernelTable* neonFloatKernelTable(bool relaxed) {
+    static const floatKernelTable single = simdMathFloat::makeFloatKernelTable<neonFloatLane>("neon-single", false);
+    static const floatKernelTable fast = simdMathFloat::makeFloatKernelTable<neonFloatLane>("neon-fast", true);
+    return relaxed ? &fast : &single;
+}
+
+#else
+
+const kernelTable* neonKernelTable() {
+    return nullptr;
+}
+
+const floatKernelTable* neonFloatKernelTable(bool) {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file kernels_sse2.cpp
+ * @brief Tabla de núcleos para SSE2 (2 doubles o 4 floats por registro).
+ *
+ * SSE2 forma parte de la base de x86-64, por lo que no requiere opciones
+ * especiales de compilación. SSE2 no tiene FMA: fma se calcula como a*b + c.
+ */
+
+#include "kernels.hpp"
+
+#if defined(__SSE2__)
+
+#include "simd_math.hpp"
+#include "simd_math_float.hpp"
+#include <emmintrin.h>
+
+namespace {
+
+struct sse2Lane {
+    using reg = __m128d;
+    using mask = __m128d;
+    static constexpr std::size_t width = 2;
+    static constexpr bool fusedFma = false;
+
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+    static reg set(double v) { return _mm_set1_pd(v); }
+    static reg setBits(std::uint64_t bits) { return _mm_castsi128_pd(_mm_set1_epi64x(static_cast<long long>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static reg sqrt(reg a) { return _mm_sqrt_pd(a); }
+
+    static reg bitAnd(reg a, reg b) { return _mm_and_pd(a, b); }
+    static reg bitOr(reg a, reg b) { return _mm_or_pd(a, b); }
+    static reg bitXor(reg a, reg b) { return _mm_xor_pd(a, b); }
+    template <int n> static reg shiftLeft(reg a) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+    static mask notLessEqual(reg a, reg b) { return _mm_cmpnle_pd(a, b); }
+    static mask maskOr(mask a, mask b) { return _mm_or_pd(a, b); }
+    static mask maskAnd(mask a, mask b) { return _mm_and_pd(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static int maskBits(mask m) { return _mm_movemask_pd(m); }
+};
+
+struct sse2FloatLane {
+    using reg = __m128;
+    using mask = __m128;
+    static constexpr std::size_t width = 4;
+
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg set(float v) { return _mm_set1_ps(v); }
+    static reg setBits(std::uint32_t bits) { return _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(bits))); }
+
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+    static reg fma(reg a, reg b, reg c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static reg sqrt(reg a) { return _mm_sqrt_ps(a); }
+
+    static reg bitAnd(reg a, reg b) { return _mm_and_ps(a, b); }
+    static reg bitOr(reg a, reg b) { return _mm_or_ps(a, b); }
+    static reg bitXor(reg a, reg b) { return _mm_xor_ps(a, b); }
+    template <int n> static reg shiftLeft(reg a) { return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(a), n)); }
+    template <int n> static reg shiftRight(reg a) { return _mm_castsi128_ps(_mm_srli_epi32(_mm_castps_si128(a), n)); }
+
+    static mask less(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+    static mask notLessEqual(reg a, reg b) { return _mm_cmpnle_ps(a, b); }
+    static mask equal(reg a, reg b) { return _mm_cmpeq_ps(a, b); }
+    static mask maskOr(mask a, mask b) { return _mm_or_ps(a, b); }
+    static mask maskAnd(mask a, mask b) { return _mm_and_ps(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static int maskBits(mask m) { return _mm_movemask_ps(m); }
+};
+
+} // namespace
+
+const kernelTable* sse2KernelTable() {
+    static const kernelTable table = simdMath::makeKernelTable<sse2Lane>("sse2");
+    return &table;
+}
+
+const floatKernelTable* sse2FloatKernelTable(bool relaxed) {
+    static const floatKernelTable single = simdMathFloat::makeFloatKernelTable<sse2FloatLane>("sse2-single", false);
+    static const floatKernelTable fast = simdMathFloat::makeFloatKernelTable<sse2FloatLane>("sse2-fast", true);
+    return relaxed ? &fast : &single;
+}
+
+#else
+
+const kernelTable* sse2KernelTable() {
+    return nullptr;
+}
+
+const floatKernelTable* sse2FloatKernelTable(bool) {
+    return nullptr;
+}
+
+#endif
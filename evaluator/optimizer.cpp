@@ -0,0 +1,262 @@
+/**
+ * @file optimizer.cpp
+ * @brief Implementación de la simplificación del árbol sintáctico.
+ *
+ * Se reconstruye el árbol en una sola pasada en postorden: cada nodo se
+ * simplifica con sus operandos ya simplificados y se inserta mediante
+ * "hash consing", es decir, si ya existe un nodo idéntico se reutiliza.
+ * Al final se descartan los nodos que quedaron sin uso.
+ */
+
+#include "optimizer.hpp"
+#include "scalar_ops.hpp"
+#include "../support/metrics.hpp"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * @struct nodeKey
+ * @brief Identidad estructural de un nodo, con el valor comparado por bits.
+ */
+struct nodeKey {
+    opCode op;
+    std::uint8_t variable;
+    std::uint32_t left;
+    std::uint32_t right;
+    std::uint64_t bits;
+
+    bool operator==(const nodeKey&) const = default;
+};
+
+struct nodeKeyHash {
+    std::size_t operator()(const nodeKey& key) const {
+        std::uint64_t hash = key.bits * 0x9E3779B97F4A7C15ull;
+        hash ^= (static_cast<std::uint64_t>(key.left) << 32 | key.right) + 0x632BE59BD9B4E019ull + (hash << 6) + (hash >> 2);
+        hash ^= static_cast<std::uint64_t>(key.op) << 8 | key.variable;
+        return static_cast<std::size_t>(hash ^ (hash >> 29));
+    }
+};
+
+bool isCommutative(opCode op) {
+    return op == opCode::Add || op == opCode::Multiply;
+}
+
+/**
+ * @class treeBuilder
+ * @brief Árbol en construcción que nunca guarda dos nodos idénticos.
+ */
+class treeBuilder {
+public:
+    treeBuilder(std::size_t capacity, std::pmr::memory_resource* memory)
+        : nodes(memory), known(memory) {
+        nodes.reserve(capacity);
+        known.reserve(capacity);
+    }
+
+    std::pmr::vector<astNode> nodes;
+
+    const astNode& at(std::uint32_t index) const { return nodes[index]; }
+
+    bool isConstant(std::uint32_t index, double value) const {
+        return nodes[index].op == opCode::Constant && nodes[index].value == value;
+    }
+
+    /**
+     * @brief Indica si el nodo es el cero con el signo dado (0 == -0 no basta).
+     */
+    bool isZero(std::uint32_t index, bool negative) const {
+        return isConstant(index, 0.0) && std::signbit(nodes[index].value) == negative;
+    }
+
+    std::uint32_t constant(double value) {
+        return insert({opCode::Constant, 0, 0, 0, value});
+    }
+
+    std::uint32_t variable(std::uint8_t index) {
+        return insert({opCode::Variable, index, 0, 0, 0.0});
+    }
+
+    std::uint32_t unary(opCode op, std::uint32_t operand) {
+        const astNode& a = nodes[operand];
+        if (a.op == opCode::Constant)
+        {
+            return constant(applyUnary(op, a.value));
+        }
+        if (op == opCode::Negate && a.op == opCode::Negate)
+        {
+            return a.left;
+        }
+        return insert({op, 0, operand, 0, 0.0});
+    }
+
+    std::uint32_t binary(opCode op, std::uint32_t left, std::uint32_t right) {
+        const astNode& a = nodes[left];
+        const astNode& b = nodes[right];
+        if (a.op == opCode::Constant && b.op == opCode::Constant)
+        {
+            return constant(applyBinary(op, a.value, b.value));
+        }
+
+        switch (op)
+        {
+        // Con ceros solo valen las formas exactas también para x = ±0:
+        // -0 + 0 = +0, así que x + 0 y 0 - x se conservan.
+        case opCode::Add:
+            if (isZero(right, true)) return left;
+            if (isZero(left, true)) return right;
+            break;
+        case opCode::Subtract:
+            if (isZero(right, false)) return left;
+            if (isZero(left, true)) return unary(opCode::Negate, right);
+            break;
+        case opCode::Multiply:
+            if (isConstant(right, 1.0)) return left;
+            if (isConstant(left, 1.0)) return right;
+            if (isConstant(right, -1.0)) return unary(opCode::Negate, left);
+            if (isConstant(left, -1.0)) return unary(opCode::Negate, right);
+            break;
+        case opCode::Divide:
+            if (isConstant(right, 1.0)) return left;
+            break;
+        case opCode::Power:
+            return power(left, right);
+        default:
+            break;
+        }
+
+        if (isCommutative(op) && right < left)
+        {
+            std::swap(left, right); // Forma canónica: a+b y b+a son el mismo nodo
+        }
+        return insert({op, 0, left, right, 0.0});
+    }
+
+private:
+    std::pmr::unordered_map<nodeKey, std::uint32_t, nodeKeyHash> known;
+
+    std::uint32_t insert(const astNode& node) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &node.value, sizeof bits);
+        nodeKey key{node.op, node.variable, node.left, node.right, bits};
+        auto found = known.find(key);
+        if (found != known.end())
+        {
+            return found->second;
+        }
+        nodes.push_back(node);
+        std::uint32_t index = static_cast<std::uint32_t>(nodes.size() - 1);
+        known.emplace(key, index);
+        return index;
+    }
+
+    /**
+     * @brief Potencia con exponente constante pequeño reescrita como productos.
+     */
+    std::uint32_t power(std::uint32_t base, std::uint32_t exponent) {
+        if (isConstant(exponent, 0.0) || isConstant(base, 1.0))
+        {
+            return constant(1.0);
+        }
+        if (isConstant(exponent, 1.0))
+        {
+            return base;
+        }
+        if (isConstant(exponent, 2.0) || isConstant(exponent, 3.0) || isConstant(exponent, 4.0))
+        {
+            const double n = nodes[exponent].value;
+            std::uint32_t square = binary(opCode::Multiply, base, base);
+            if (n == 2.0)
+            {
+                return square;
+            }
+            return n == 3.0 ? binary(opCode::Multiply, square, base) : binary(opCode::Multiply, square, square);
+        }
+        return insert({opCode::Power, 0, base, exponent, 0.0});
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Simplifica un árbol sintáctico.
+ *
+ * @param tree Árbol plano en postorden producido por el parser.
+ * @param memory Memoria para el árbol resultante y las tablas auxiliares.
+ * @return syntaxTree Árbol equivalente, sin nodos inalcanzables.
+ */
+syntaxTree optimize(const syntaxTree& tree, std::pmr::memory_resource* memory) {
+    stageTimer timer(metricStage::Optimize);
+    syntaxTree result{std::pmr::vector<astNode>(memory)};
+    if (tree.nodes.empty())
+    {
+        return result;
+    }
+
+    treeBuilder builder(tree.nodes.size(), memory);
+    std::pmr::vector<std::uint32_t> mapped(tree.nodes.size(), 0, memory);
+    for (std::uint32_t i = 0; i < tree.nodes.size(); i++)
+    {
+        const astNode& node = tree.nodes[i];
+        switch (operandCount(node.op))
+        {
+        case 0:
+            mapped[i] = node.op == opCode::Constant ? builder.constant(node.value) : builder.variable(node.variable);
+            break;
+        case 1:
+            mapped[i] = builder.unary(node.op, mapped[node.left]);
+            break;
+        default:
+            mapped[i] = builder.binary(node.op, mapped[node.left], mapped[node.right]);
+            break;
+        }
+    }
+
+    // Los operandos plegados o eliminados quedan sin uso: se conservan solo los alcanzables.
+    const std::pmr::vector<astNode>& nodes = builder.nodes;
+    std::uint32_t root = mapped[tree.root];
+    std::pmr::vector<bool> reachable(nodes.size(), false, memory);
+    reachable[root] = true;
+    for (std::uint32_t i = root + 1; i-- > 0;)
+    {
+        if (!reachable[i])
+        {
+            continue;
+        }
+        int operands = operandCount(nodes[i].op);
+        if (operands >= 1)
+        {
+            reachable[nodes[i].left] = true;
+        }
+        if (operands == 2)
+        {
+            reachable[nodes[i].right] = true;
+        }
+    }
+
+    std::pmr::vector<std::uint32_t> compacted(nodes.size(), 0, memory);
+    result.nodes.reserve(root + 1);
+    for (std::uint32_t i = 0; i <= root; i++)
+    {
+        if (!reachable[i])
+        {
+            continue;
+        }
+        astNode node = nodes[i];
+        int operands = operandCount(node.op);
+        if (operands >= 1)
+        {
+            node.left = compacted[node.left];
+        }
+        if (operands == 2)
+        {
+            node.right = compacted[node.right];
+        }
+        compacted[i] = static_cast<std::uint32_t>(result.nodes.size());
+        result.nodes.push_back(node);
+    }
+    result.root = compacted[root];
+    return result;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file optimizer.hpp
+ * @brief Simplificación del árbol sintáctico antes de compilarlo.
+ *
+ * Todo lo que se resuelve aquí se ahorra en cada muestra del bucle de
+ * evaluación: subárboles constantes como 2*pi/3 o sqrt(2), identidades
+ * como x*1 y subexpresiones repetidas.
+ */
+#ifndef OPTIMIZER_HPP
+#define OPTIMIZER_HPP
+
+#include "../parser/ast.hpp"
+#include <memory_resource>
+
+/**
+ * @brief Simplifica un árbol sintáctico.
+ *
+ * - Pliega los subárboles que no dependen de x, y ni z, usando la misma
+ *   semántica que el evaluador (scalar_ops.hpp).
+ * - Elimina identidades: x-0, x*1, 1*x, x/1, x^1, -(-x); y reemplaza x^0 y
+ *   1^x por 1 (pow los define así incluso para NaN). x+0 y 0-x se conservan:
+ *   con x = -0 o +0 cambiarían el signo del cero, y con él el lado de un polo
+ *   en 1/x; solo se simplifican x+(-0) y (-0)-x, que sí son exactas.
+ * - Reescribe potencias enteras pequeñas como productos: x^2 = x*x (exacto),
+ *   x^3 y x^4 con una o dos multiplicaciones (error de hasta 2 ulp frente a pow).
+ * - Unifica subexpresiones idénticas, de modo que el resultado puede ser un
+ *   grafo: un nodo puede ser operando de varios. El orden sigue siendo
+ *   válido (los operandos preceden a su nodo) y el compilador lo admite.
+ *
+ * @param tree Árbol plano en postorden producido por el parser.
+ * @param memory Memoria para el árbol resultante y las tablas auxiliares.
+ * @return syntaxTree Árbol equivalente, sin nodos inalcanzables.
+ */
+syntaxTree optimize(const syntaxTree& tree, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+#endif // OPTIMIZER_HPP
@@ -0,0 +1,81 @@
+/**
+ * @file program.hpp
+ * @brief Programa compilado (bytecode de registros) de una expresión.
+ *
+ * Cada instrucción aplica una operación a uno o dos registros y deja el
+ * resultado en otro. El evaluador por lotes ejecuta cada instrucción sobre
+ * un bloque completo de muestras antes de pasar a la siguiente, por lo que
+ * un "registro" es en realidad una columna de valores.
+ *
+ * Distribución de registros:
+ * - [0, variableRegisterCount): variables x, y, z (apuntan a la entrada, sin copiar)
+ * - [variableRegisterCount, firstTemporary): constantes del programa
+ * - [firstTemporary, registerCount): resultados intermedios
+ */
+#ifndef PROGRAM_HPP
+#define PROGRAM_HPP
+
+#include "../parser/ast.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Cantidad de registros reservados para las variables x, y, z.
+constexpr std::uint16_t variableRegisterCount = 3;
+
+/**
+ * @enum evaluationPrecision
+ * @brief Precisión con la que el evaluador por lotes ejecuta un programa.
+ *
+ * Solo la usan evaluateBatch() (sin tabla explícita) y evaluateAt(), es
+ * decir, el dibujo en pantalla. Las exportaciones (writeTable,
+ * evaluateColumnFile), las derivadas, los intervalos y el buscador de raíces
+ * trabajan siempre en double. En programas solo aritméticos la conversión
+ * de las columnas a float cuesta más de lo que se gana; conviene con
+ * funciones trascendentes.
+ */
+enum class evaluationPrecision : std::uint8_t {
+    Double, ///< doubles con los núcleos de siempre (por defecto)
+    Single, ///< floats: el doble de carriles por registro y unas 7 cifras significativas
+    Fast, ///< floats con casos especiales resueltos en los carriles y pow, raíces y arcos vectorizados
+};
+
+/**
+ * @struct instruction
+ * @brief Una operación del programa: target = op(left, right).
+ */
+struct instruction {
+    opCode op; ///< Operación a aplicar (nunca Constant ni Variable)
+    std::uint16_t target; ///< Registro donde se guarda el resultado
+    std::uint16_t left; ///< Primer operando
+    std::uint16_t right; ///< Segundo operando (solo operaciones binarias)
+};
+
+/**
+ * @struct bytecodeProgram
+ * @brief Expresión compilada lista para evaluarse muchas veces.
+ */
+struct bytecodeProgram {
+    std::vector<instruction> code; ///< Instrucciones en orden de ejecución
+    std::vector<double> constants; ///< Valor de cada registro de constante, en orden
+    std::uint16_t registerCount = variableRegisterCount; ///< Total de registros usados
+    std::uint16_t result = 0; ///< Registro que contiene el valor final
+    std::uint8_t variableMask = 0; ///< Variables de las que depende (bit 0 = x, bit 1 = y, bit 2 = z)
+    evaluationPrecision precision = evaluationPrecision::Double; ///< Precisión al evaluar por lotes
+
+    /**
+     * @brief Primer registro de resultados intermedios.
+     */
+    std::uint16_t firstTemporary() const {
+        return static_cast<std::uint16_t>(variableRegisterCount + constants.size());
+    }
+
+    /**
+     * @brief Indica si el programa lee la variable dada (0 = x, 1 = y, 2 = z).
+     */
+    bool usesVariable(std::size_t variable) const {
+        return (variableMask >> variable) & 1u;
+    }
+};
+
+#endif // PROGRAM_HPP
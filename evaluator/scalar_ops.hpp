@@ -0,0 +1,73 @@
+/**
+ * @file scalar_ops.hpp
+ * @brief Semántica de referencia de cada operación sobre un solo valor.
+ *
+ * Todas las formas de evaluación (por lotes, plegado de constantes, caminos
+ * vectorizados) deben coincidir con estas definiciones.
+ */
+#ifndef SCALAR_OPS_HPP
+#define SCALAR_OPS_HPP
+
+#include "../parser/ast.hpp"
+#include <cmath>
+
+/**
+ * @brief Raíz n-ésima real: para n entero impar también acepta x negativo.
+ */
+inline double realRoot(double n, double x) {
+    if (x < 0.0 && std::fmod(n, 2.0) != 0.0 && std::trunc(n) == n)
+    {
+        return -std::pow(-x, 1.0 / n);
+    }
+    return std::pow(x, 1.0 / n);
+}
+
+/**
+ * @brief Aplica una operación de un operando.
+ *
+ * Convenciones: sec, csc y cot son los recíprocos de cos, sin y tan;
+ * asec, acsc y acot se definen como acos(1/x), asin(1/x) y atan(1/x).
+ */
+inline double applyUnary(opCode op, double a) {
+    switch (op)
+    {
+    case opCode::Negate: return -a;
+    case opCode::Sin: return std::sin(a);
+    case opCode::Cos: return std::cos(a);
+    case opCode::Tan: return std::tan(a);
+    case opCode::Sec: return 1.0 / std::cos(a);
+    case opCode::Csc: return 1.0 / std::sin(a);
+    case opCode::Cot: return std::cos(a) / std::sin(a);
+    case opCode::Asin: return std::asin(a);
+    case opCode::Acos: return std::acos(a);
+    case opCode::Atan: return std::atan(a);
+    case opCode::Asec: return std::acos(1.0 / a);
+    case opCode::Acsc: return std::asin(1.0 / a);
+    case opCode::Acot: return std::atan(1.0 / a);
+    case opCode::Log: return std::log10(a);
+    case opCode::Ln: return std::log(a);
+    case opCode::Sqrt: return std::sqrt(a);
+    case opCode::Abs: return std::fabs(a);
+    default: return std::nan("");
+    }
+}
+
+/**
+ * @brief Aplica una operación de dos operandos.
+ */
+inline double applyBinary(opCode op, double a, double b) {
+    switch (op)
+    {
+    case opCode::Add: return a + b;
+    case opCode::Subtract: return a - b;
+    case opCode::Multiply: return a * b;
+    case opCode::Divide: return a / b;
+    case opCode::Modulo: return std::fmod(a, b);
+    case opCode::Power: return std::pow(a, b);
+    case opCode::LogBase: return std::log(b) / std::log(a);
+    case opCode::Nroot: return realRoot(a, b);
+    default: return std::nan("");
+    }
+}
+
+#endif // SCALAR_OPS_HPP
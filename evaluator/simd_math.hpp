@@ -0,0 +1,715 @@
+/**
+ * @file simd_math.hpp
+ * @brief Funciones matemáticas vectorizadas, genéricas sobre el tipo de carril.
+ *
+ * Cada archivo kernels_<isa>.cpp define un "carril" (lane) con las
+ * operaciones básicas de su conjunto de instrucciones y llama a
+ * makeKernelTable<lane>(). Todo lo que hay aquí son plantillas que dependen
+ * del carril, para que cada instancia se compile con las opciones de su
+ * archivo y nunca se mezcle con código de otro conjunto de instrucciones.
+ *
+ * Por ese mismo motivo este encabezado no incluye funciones inline comunes
+ * (como las de scalar_ops.hpp): el enlazador podría quedarse con la copia
+ * compilada para AVX2 y usarla en un procesador que no la soporta. Los
+ * archivos que lo incluyan deben declarar su carril en un espacio de nombres
+ * anónimo.
+ *
+ * Un carril L debe proporcionar:
+ * - L::reg, L::mask y L::width.
+ * - fusedFma: si fma redondea una sola vez (el resto exacto de % depende de ello).
+ * - load, store, set(double), setBits(uint64).
+ * - add, sub, mul, div, fma (a*b+c), sqrt.
+ * - bitAnd, bitOr, bitXor, shiftLeft<n>, shiftRight<n> (sobre los bits de 64).
+ * - less(a,b), notLessEqual(a,b) (verdadero también con NaN), maskOr, maskAnd.
+ * - select(m, a, b) (m ? a : b) y maskBits(m) (un bit por carril).
+ *
+ * Los polinomios provienen de fdlibm (sin, cos, log, pow) y Cephes (atan).
+ */
+#ifndef SIMD_MATH_HPP
+#define SIMD_MATH_HPP
+
+#include "kernels.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdMath {
+
+/// Máscara del bit de signo de un double.
+constexpr std::uint64_t signBit = 0x8000000000000000ull;
+
+/// 1.5 * 2^52: sumarlo y restarlo redondea al entero más cercano (|x| < 2^51).
+constexpr double roundingMagic = 6755399441055744.0;
+
+/// Límite de |x| hasta el que la reducción de argumento de sin/cos es exacta.
+constexpr double trigLimit = 1.0e6;
+
+template <class L>
+typename L::reg roundNearest(typename L::reg x) {
+    return L::sub(L::add(x, L::set(roundingMagic)), L::set(roundingMagic));
+}
+
+template <class L>
+typename L::reg negate(typename L::reg x) {
+    return L::bitXor(x, L::setBits(signBit));
+}
+
+template <class L>
+typename L::reg absolute(typename L::reg x) {
+    return L::bitAnd(x, L::setBits(~signBit));
+}
+
+/**
+ * @brief Calcula sin(x) y cos(x) a la vez para |x| <= trigLimit.
+ *
+ * Reduce x a r = x - q*pi/2 al estilo Cody-Waite con cuatro términos: las
+ * tres primeras partes de pi/2 tienen 33 bits (los productos q*parte son
+ * exactos) y la cuarta es la cola restante en precisión completa. Luego
+ * evalúa los polinomios de fdlibm en [-pi/4, pi/4]; el cuadrante q mod 4
+ * decide qué polinomio y qué signo corresponde a cada resultado.
+ */
+template <class L>
+void sinCos(typename L::reg x, typename L::reg& sinOut, typename L::reg& cosOut) {
+    using reg = typename L::reg;
+    const reg q = roundNearest<L>(L::mul(x, L::set(6.36619772367581382433e-01)));
+
+    reg r = L::fma(q, L::set(-1.57079632673412561417e+00), x);
+    r = L::fma(q, L::set(-6.07710050630396597660e-11), r);
+    r = L::fma(q, L::set(-2.02226624871116645580e-21), r);
+    r = L::fma(q, L::set(-8.47842766036889956997e-32), r);
+
+    const reg z = L::mul(r, r);
+
+    reg sinPoly = L::set(1.58969099521155010221e-10);
+    sinPoly = L::fma(sinPoly, z, L::set(-2.50507602534068634195e-08));
+    sinPoly = L::fma(sinPoly, z, L::set(2.75573137070700676789e-06));
+    sinPoly = L::fma(sinPoly, z, L::set(-1.98412698298579493134e-04));
+    sinPoly = L::fma(sinPoly, z, L::set(8.33333333332248946124e-03));
+    sinPoly = L::fma(sinPoly, z, L::set(-1.66666666666666324348e-01));
+    const reg sinR = L::fma(L::mul(r, z), sinPoly, r);
+
+    reg cosPoly = L::set(-1.13596475577881948265e-11);
+    cosPoly = L::fma(cosPoly, z, L::set(2.08757232129817482790e-09));
+    cosPoly = L::fma(cosPoly, z, L::set(-2.75573143513906633035e-07));
+    cosPoly = L::fma(cosPoly, z, L::set(2.48015872894767294178e-05));
+    cosPoly = L::fma(cosPoly, z, L::set(-1.38888888888741095749e-03));
+    cosPoly = L::fma(cosPoly, z, L::set(4.16666666666666019037e-02));
+    // cos(r) = 1 - z/2 + z^2 * p(z), calculado como w + ((1 - w) - z/2 + z^2 * p(z))
+    // con w = 1 - z/2 para no perder los bits bajos de z/2.
+    const reg halfZ = L::mul(z, L::set(0.5));
+    const reg w = L::sub(L::set(1.0), halfZ);
+    const reg tail = L::fma(L::mul(z, z), cosPoly, L::sub(L::sub(L::set(1.0), w), halfZ));
+    const reg cosR = L::add(w, tail);
+
+    // q mod 4 calculado sin convertir a entero: floor(q/4) nunca cae en un empate.
+    const reg quarter = roundNearest<L>(L::fma(q, L::set(0.25), L::set(-0.375)));
+    const reg quadrant = L::fma(quarter, L::set(-4.0), q);
+
+    const typename L::mask odd = L::maskOr(
+        L::maskAnd(L::less(L::set(0.5), quadrant), L::less(quadrant, L::set(1.5))),
+        L::less(L::set(2.5), quadrant));
+    const typename L::mask sinNegative = L::less(L::set(1.5), quadrant);
+    const typename L::mask cosNegative = L::maskAnd(L::less(L::set(0.5), quadrant), L::less(quadrant, L::set(2.5)));
+
+    const reg sinX = L::select(odd, cosR, sinR);
+    const reg cosX = L::select(odd, sinR, cosR);
+    sinOut = L::select(sinNegative, negate<L>(sinX), sinX);
+    cosOut = L::select(cosNegative, negate<L>(cosX), cosX);
+}
+
+/**
+ * @brief Carriles que sin/cos resuelven con <cmath>: |x| > trigLimit, NaN, y
+ * ceros o subnormales (para conservar el signo de -0 en sin, csc y cot).
+ */
+template <class L>
+typename L::mask trigSpecial(typename L::reg x) {
+    const typename L::reg magnitude = absolute<L>(x);
+    return L::maskOr(L::notLessEqual(magnitude, L::set(trigLimit)), L::less(magnitude, L::set(2.2250738585072014e-308)));
+}
+
+/**
+ * @brief Logaritmo natural para x normal, positivo y finito (algoritmo de fdlibm).
+ */
+template <class L>
+typename L::reg naturalLog(typename L::reg x) {
+    using reg = typename L::reg;
+    // Exponente como double: los 11 bits se colocan en la mantisa de 2^52.
+    const reg exponentBits = L::bitOr(L::template shiftRight<52>(x), L::setBits(0x4330000000000000ull));
+    reg exponent = L::sub(L::sub(exponentBits, L::set(4503599627370496.0)), L::set(1023.0));
+
+    reg m = L::bitOr(L::bitAnd(x, L::setBits(0x000FFFFFFFFFFFFFull)), L::setBits(0x3FF0000000000000ull));
+    const typename L::mask big = L::less(L::set(1.41421356237309504880), m);
+    m = L::select(big, L::mul(m, L::set(0.5)), m);
+    exponent = L::select(big, L::add(exponent, L::set(1.0)), exponent);
+
+    const reg f = L::sub(m, L::set(1.0));
+    const reg s = L::div(f, L::add(L::set(2.0), f));
+    const reg z = L::mul(s, s);
+    const reg w = L::mul(z, z);
+
+    reg odd = L::set(1.479819860511658591e-01);
+    odd = L::fma(odd, w, L::set(1.818357216161805012e-01));
+    odd = L::fma(odd, w, L::set(2.857142874366239149e-01));
+    odd = L::fma(odd, w, L::set(6.666666666666735130e-01));
+    reg even = L::set(1.531383769920937332e-01);
+    even = L::fma(even, w, L::set(2.222219843214978396e-01));
+    even = L::fma(even, w, L::set(3.999999999940941908e-01));
+    const reg R = L::add(L::mul(z, odd), L::mul(w, even));
+
+    const reg hfsq = L::mul(L::mul(L::set(0.5), f), f);
+    // log(x) = e*ln2_hi - ((hfsq - (s*(hfsq + R) + e*ln2_lo)) - f)
+    const reg inner = L::fma(exponent, L::set(1.90821492927058770002e-10), L::mul(s, L::add(hfsq, R)));
+    return L::fma(exponent, L::set(6.93147180369123816490e-01), L::sub(f, L::sub(hfsq, inner)));
+}
+
+template <class L>
+typename L::mask logSpecial(typename L::reg x) {
+    return L::maskOr(L::notLessEqual(L::set(2.2250738585072014e-308), x), L::notLessEqual(x, L::set(1.7976931348623157e308)));
+}
+
+/**
+ * @brief Arcotangente (algoritmo de Cephes con tres intervalos de reducción).
+ */
+template <class L>
+typename L::reg arcTangent(typename L::reg x) {
+    using reg = typename L::reg;
+    const reg sign = L::bitAnd(x, L::setBits(signBit));
+    const reg a = absolute<L>(x);
+
+    // a > tan(3pi/8): atan(a) = pi/2 + atan(-1/a); a > 0.66: atan(a) = pi/4 + atan((a-1)/(a+1)).
+    const typename L::mask large = L::less(L::set(2.41421356237309504880), a);
+    const typename L::mask medium = L::less(L::set(0.66), a); // Los selects dan prioridad a large
+
+    const reg numerator = L::select(large, L::set(-1.0), L::select(medium, L::sub(a, L::set(1.0)), a));
+    const reg denominator = L::select(large, a, L::select(medium, L::add(a, L::set(1.0)), L::set(1.0)));
+    const reg t = L::div(numerator, denominator);
+    const reg base = L::select(large, L::set(1.57079632679489661923), L::select(medium, L::set(0.78539816339744830962), L::set(0.0)));
+    const reg moreBits = L::select(large, L::set(6.123233995736765886130e-17), L::select(medium, L::set(3.061616997868382943065e-17), L::set(0.0)));
+
+    const reg z = L::mul(t, t);
+    reg p = L::set(-8.750608600031904122785e-01);
+    p = L::fma(p, z, L::set(-1.615753718733365076637e+01));
+    p = L::fma(p, z, L::set(-7.500855792314704667340e+01));
+    p = L::fma(p, z, L::set(-1.228866684490136173410e+02));
+    p = L::fma(p, z, L::set(-6.485021904942025371773e+01));
+    reg q = L::add(z, L::set(2.485846490142306297962e+01));
+    q = L::fma(q, z, L::set(1.650270098316988542046e+02));
+    q = L::fma(q, z, L::set(4.328810604912902668951e+02));
+    q = L::fma(q, z, L::set(4.853903996359136964868e+02));
+    q = L::fma(q, z, L::set(1.945506571482613964425e+02));
+
+    const reg correction = L::fma(t, L::div(L::mul(z, p), q), moreBits);
+    const reg result = L::add(base, L::add(t, correction));
+    return L::bitOr(result, sign);
+}
+
+/**
+ * @brief asin(x) = atan(x / sqrt((1 - x)(1 + x))); fuera de [-1, 1] da NaN.
+ */
+template <class L>
+typename L::reg arcSine(typename L::reg x) {
+    const typename L::reg one = L::set(1.0);
+    return arcTangent<L>(L::div(x, L::sqrt(L::mul(L::sub(one, x), L::add(one, x)))));
+}
+
+/**
+ * @brief acos(x) = 2 atan(sqrt((1 - x) / (1 + x))); fuera de [-1, 1] da NaN.
+ */
+template <class L>
+typename L::reg arcCosine(typename L::reg x) {
+    const typename L::reg one = L::set(1.0);
+    return L::mul(L::set(2.0), arcTangent<L>(L::sqrt(L::div(L::sub(one, x), L::add(one, x)))));
+}
+
+/**
+ * @brief Resto de a/b con el signo de a, exacto como std::fmod.
+ *
+ * n = trunc(a/b) puede pasarse en uno cuando a/b redondea hacia arriba a un
+ * entero; a - n*b sigue siendo representable (|a - n*b| <= |b|), así que se
+ * calcula sin error y se corrige sumando b con el signo de a. Sin FMA el
+ * producto n*b se obtiene exacto partiendo ambos factores en mitades de 26
+ * bits (Veltkamp). Solo vale en los carriles que no marca remainderSpecial.
+ */
+template <class L>
+typename L::reg remainder(typename L::reg a, typename L::reg b) {
+    using reg = typename L::reg;
+    const reg signOfA = L::bitAnd(a, L::setBits(signBit));
+    const reg quotient = L::div(a, b);
+    // trunc(a/b): si el redondeo se alejó de cero, se resta 1 con el signo del cociente.
+    reg n = roundNearest<L>(quotient);
+    const reg unit = L::bitOr(L::set(1.0), L::bitAnd(quotient, L::setBits(signBit)));
+    n = L::select(L::less(absolute<L>(quotient), absolute<L>(n)), L::sub(n, unit), n);
+
+    reg r;
+    if constexpr (L::fusedFma)
+    {
+        r = L::fma(negate<L>(n), b, a);
+    }
+    else
+    {
+        auto split = [](reg v, reg& high, reg& low) {
+            const reg scaled = L::mul(v, L::set(134217729.0));
+            high = L::sub(scaled, L::sub(scaled, v));
+            low = L::sub(v, high);
+        };
+        reg nHigh, nLow, bHigh, bLow;
+        split(n, nHigh, nLow);
+        split(b, bHigh, bLow);
+        const reg product = L::mul(n, b);
+        const reg error = L::add(L::add(L::add(L::sub(L::mul(nHigh, bHigh), product), L::mul(nHigh, bLow)), L::mul(nLow, bHigh)),
+            L::mul(nLow, bLow));
+        r = L::sub(L::sub(a, product), error);
+    }
+
+    const typename L::mask overshoot = L::less(L::bitXor(r, signOfA), L::set(0.0));
+    r = L::select(overshoot, L::add(r, L::bitOr(absolute<L>(b), signOfA)), r);
+    return L::bitOr(absolute<L>(r), signOfA);
+}
+
+/**
+ * @brief Carriles que remainder no resuelve: |a/b| >= 2^51 (incluye b = 0 y a
+ * infinito), b infinito, NaN y, sin FMA, |b| fuera de [2^-900, 2^900] (donde
+ * la partición de Veltkamp desborda o pierde bits en subnormales).
+ */
+template <class L>
+typename L::mask remainderSpecial(typename L::reg a, typename L::reg b) {
+    using reg = typename L::reg;
+    const reg magnitude = absolute<L>(b);
+    const reg smallest = L::set(L::fusedFma ? 0.0 : 0x1p-900);
+    const reg largest = L::set(L::fusedFma ? 1.7976931348623157e308 : 0x1p900);
+    return L::maskOr(L::notLessEqual(absolute<L>(L::div(a, b)), L::set(0x1p51)),
+        L::maskOr(L::notLessEqual(smallest, magnitude), L::notLessEqual(magnitude, largest)));
+}
+
+/// Pone a cero los 32 bits bajos de la mantisa (SET_LOW_WORD(x, 0) de fdlibm).
+template <class L>
+typename L::reg highWord(typename L::reg x) {
+    return L::bitAnd(x, L::setBits(0xFFFFFFFF00000000ull));
+}
+
+/// Exponente binario de x (normal y positivo) como double.
+template <class L>
+typename L::reg binaryExponent(typename L::reg x) {
+    const typename L::reg exponentBits = L::bitOr(L::template shiftRight<52>(x), L::setBits(0x4330000000000000ull));
+    return L::sub(L::sub(exponentBits, L::set(4503599627370496.0)), L::set(1023.0));
+}
+
+/**
+ * @brief Clasifica y (|y| < 2^51) en entero y entero impar.
+ */
+template <class L>
+void classifyInteger(typename L::reg y, typename L::mask& integer, typename L::mask& odd) {
+    using reg = typename L::reg;
+    // La parte fraccionaria es exacta: es 0 solo si y es entero.
+    integer = L::less(absolute<L>(L::sub(y, roundNearest<L>(y))), L::set(4.9406564584124654e-324));
+    const reg half = L::mul(y, L::set(0.5));
+    odd = L::maskAnd(integer, L::less(L::set(0.25), absolute<L>(L::sub(half, roundNearest<L>(half)))));
+}
+
+/**
+ * @brief x^y con el algoritmo de std::pow de fdlibm (error < 1 ulp).
+ *
+ * Calcula log2|x| en dos partes con unos 20 bits extra, multiplica por y
+ * partiendo y en dos mitades, y eleva 2 al resultado reduciendo a
+ * [-ln2/2, ln2/2]. Los productos intermedios son exactos porque las partes
+ * altas tienen los 32 bits bajos a cero, así que no necesita FMA. Con x
+ * negativo da el signo de la paridad de y, o NaN si y no es entero. Solo
+ * vale en los carriles que no marca powerSpecial.
+ */
+template <class L>
+typename L::reg power(typename L::reg x, typename L::reg y) {
+    using reg = typename L::reg;
+    using mask = typename L::mask;
+    const reg one = L::set(1.0);
+    const reg ax = absolute<L>(x);
+
+    // ax = m * 2^n con m en [sqrt(3)/2, sqrt(3)); se reduce respecto de bp = 1 o 1.5.
+    reg n = binaryExponent<L>(ax);
+    reg m = L::bitOr(L::bitAnd(ax, L::setBits(0x000FFFFFFFFFFFFFull)), L::setBits(0x3FF0000000000000ull));
+    const mask middle = L::maskAnd(L::less(L::setBits(0x3FF3988EFFFFFFFFull), m), L::less(m, L::setBits(0x3FFBB67A00000000ull)));
+    const mask big = L::less(L::setBits(0x3FFBB679FFFFFFFFull), m);
+    m = L::select(big, L::mul(m, L::set(0.5)), m);
+    n = L::select(big, L::add(n, one), n);
+    const reg bp = L::select(middle, L::set(1.5), one);
+    const reg dpHigh = L::select(middle, L::set(5.84962487220764160156e-01), L::set(0.0));
+    const reg dpLow = L::select(middle, L::set(1.35003920212974897128e-08), L::set(0.0));
+
+    // ss = sHigh + sLow = (m - bp) / (m + bp)
+    reg u = L::sub(m, bp);
+    reg v = L::div(one, L::add(m, bp));
+    const reg ss = L::mul(u, v);
+    const reg sHigh = highWord<L>(ss);
+    reg tHigh = highWord<L>(L::add(m, bp));
+    reg tLow = L::sub(m, L::sub(tHigh, bp));
+    const reg sLow = L::mul(v, L::sub(L::sub(u, L::mul(sHigh, tHigh)), L::mul(sHigh, tLow)));
+
+    // log(m / bp) = 2s + 2/3 s^3 + s^5 R(s^2)
+    reg s2 = L::mul(ss, ss);
+    reg r = L::set(2.06975017800338417784e-01);
+    r = L::fma(r, s2, L::set(2.30660745775561754067e-01));
+    r = L::fma(r, s2, L::set(2.72728123808534006489e-01));
+    r = L::fma(r, s2, L::set(3.33333329818377432918e-01));
+    r = L::fma(r, s2, L::set(4.28571428578550184252e-01));
+    r = L::fma(r, s2, L::set(5.99999999999994648725e-01));
+    r = L::mul(L::mul(s2, s2), r);
+    r = L::add(r, L::mul(sLow, L::add(sHigh, ss)));
+    s2 = L::mul(sHigh, sHigh);
+    tHigh = highWord<L>(L::add(L::add(L::set(3.0), s2), r));
+    tLow = L::sub(r, L::sub(L::sub(tHigh, L::set(3.0)), s2));
+    u = L::mul(sHigh, tHigh);
+    v = L::add(L::mul(sLow, tHigh), L::mul(tLow, ss));
+
+    // log2(ax) = n + dpHigh + zHigh + zLow = t1 + t2, con 2/(3 ln2) = cpHigh + cpLow
+    const reg pHigh = highWord<L>(L::add(u, v));
+    const reg pLow = L::sub(v, L::sub(pHigh, u));
+    const reg zHigh = L::mul(L::set(9.61796700954437255859e-01), pHigh);
+    const reg zLow = L::add(L::add(L::mul(L::set(-7.02846165095275826516e-09), pHigh), L::mul(pLow, L::set(9.61796693925975554329e-01))), dpLow);
+    const reg t1 = highWord<L>(L::add(L::add(L::add(zHigh, zLow), dpHigh), n));
+    const reg t2 = L::sub(zLow, L::sub(L::sub(L::sub(t1, n), dpHigh), zHigh));
+
+    // y * log2(ax) = productHigh + productLow = k + resto, con |resto| <= 1/2
+    const reg y1 = highWord<L>(y);
+    const reg productLow = L::add(L::mul(L::sub(y, y1), t1), L::mul(y, t2));
+    const reg k = roundNearest<L>(L::add(productLow, L::mul(y1, t1)));
+    const reg productHigh = L::sub(L::mul(y1, t1), k);
+
+    // 2^resto = e^z con z en [-ln2/2, ln2/2], de nuevo en dos partes
+    const reg t = highWord<L>(L::add(productLow, productHigh));
+    u = L::mul(t, L::set(6.93147182464599609375e-01));
+    v = L::add(L::mul(L::sub(productLow, L::sub(t, productHigh)), L::set(6.93147180559945286227e-01)),
+        L::mul(t, L::set(-1.90465429995776804525e-09)));
+    const reg z = L::add(u, v);
+    const reg w = L::sub(v, L::sub(z, u));
+    const reg zz = L::mul(z, z);
+    reg p = L::set(4.13813679705723846039e-08);
+    p = L::fma(p, zz, L::set(-1.65339022054652515390e-06));
+    p = L::fma(p, zz, L::set(6.61375632143793436117e-05));
+    p = L::fma(p, zz, L::set(-2.77777777770155933842e-03));
+    p = L::fma(p, zz, L::set(1.66666666666666019037e-01));
+    const reg c = L::sub(z, L::mul(zz, p));
+    const reg e = L::sub(L::div(L::mul(z, c), L::sub(c, L::set(2.0))), L::add(w, L::mul(z, w)));
+    const reg mantissa = L::sub(one, L::sub(e, z));
+
+    // 2^k con |k| <= 1020: el exponente sesgado se coloca en su campo.
+    const reg scale = L::template shiftLeft<52>(L::add(k, L::set(4503599627370496.0 + 1023.0)));
+    const reg result = L::mul(mantissa, scale);
+
+    mask integer;
+    mask odd;
+    classifyInteger<L>(y, integer, odd);
+    const reg negativeBase = L::select(integer, L::select(odd, negate<L>(result), result), L::set(NAN));
+    return L::select(L::less(x, L::set(0.0)), negativeBase, result);
+}
+
+/**
+ * @brief Carriles que power no resuelve: |x| cero, subnormal, infinito o NaN,
+ * y NaN o |y log2|x|| que pueda pasar de 1020 (el resultado desbordaría o
+ * sería subnormal). Como log2|x| está en [n, n + 1), basta |y| (|n + 1/2| + 1/2).
+ */
+template <class L>
+typename L::mask powerSpecial(typename L::reg x, typename L::reg y) {
+    using reg = typename L::reg;
+    const reg ax = absolute<L>(x);
+    const reg bound = L::add(absolute<L>(L::add(binaryExponent<L>(ax), L::set(0.5))), L::set(0.5));
+    return L::maskOr(logSpecial<L>(ax), L::notLessEqual(L::mul(absolute<L>(y), bound), L::set(1020.0)));
+}
+
+/**
+ * @brief Raíz n-ésima real (ver realRoot en scalar_ops.hpp) a partir de power.
+ *
+ * El exponente es 1/n redondeado, igual que en realRoot.
+ */
+template <class L>
+typename L::reg realRoot(typename L::reg n, typename L::reg x) {
+    typename L::mask integer;
+    typename L::mask odd;
+    classifyInteger<L>(n, integer, odd);
+    const typename L::mask oddNegative = L::maskAnd(L::less(x, L::set(0.0)), odd);
+    const typename L::reg root = power<L>(L::select(oddNegative, negate<L>(x), x), L::div(L::set(1.0), n));
+    return L::select(oddNegative, negate<L>(root), root);
+}
+
+/**
+ * @brief Carriles que realRoot no resuelve: |n| > 2^50 (incluye infinitos y
+ * NaN, que realRoot trata como impares) y los de powerSpecial con 1/n.
+ */
+template <class L>
+typename L::mask realRootSpecial(typename L::reg n, typename L::reg x) {
+    return L::maskOr(L::notLessEqual(absolute<L>(n), L::set(0x1p50)), powerSpecial<L>(x, L::div(L::set(1.0), n)));
+}
+
+/**
+ * @brief Aplica f carril por carril, resolviendo con scalar los carriles especiales.
+ *
+ * El último bloque incompleto se procesa en un búfer relleno para que cada
+ * valor dé el mismo resultado sin importar su posición en la columna.
+ *
+ * @param vector Versión vectorial de f.
+ * @param special Carriles en los que vector no es válido.
+ * @param scalar Versión escalar de f para esos carriles.
+ */
+template <class L, class Vector, class Special, class Scalar>
+void mapUnary(const double* a, double* out, std::size_t count, Vector vector, Special special, Scalar scalar) {
+    constexpr std::size_t width = L::width;
+    auto block = [&](const double* in, double* result) {
+        const typename L::reg value = L::load(in);
+        const int lanes = L::maskBits(special(value));
+        if (lanes == 0)
+        {
+            L::store(result, vector(value));
+            return;
+        }
+        double inputs[width];
+        double outputs[width];
+        L::store(inputs, value);
+        L::store(outputs, vector(value));
+        for (std::size_t lane = 0; lane < width; lane++)
+        {
+            if ((lanes >> lane) & 1)
+            {
+                outputs[lane] = scalar(inputs[lane]);
+            }
+        }
+        std::memcpy(result, outputs, sizeof outputs);
+    };
+
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        block(a + i, out + i);
+    }
+    if (i < count)
+    {
+        double padded[width] = {};
+        double result[width];
+        std::memcpy(padded, a + i, (count - i) * sizeof(double));
+        block(padded, result);
+        std::memcpy(out + i, result, (count - i) * sizeof(double));
+    }
+}
+
+/**
+ * @brief Aplica una operación binaria sin carriles especiales.
+ */
+template <class L, class Vector>
+void mapBinary(const double* a, const double* b, double* out, std::size_t count, Vector vector) {
+    constexpr std::size_t width = L::width;
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        L::store(out + i, vector(L::load(a + i), L::load(b + i)));
+    }
+    if (i < count)
+    {
+        double left[width] = {};
+        double right[width] = {};
+        double result[width];
+        std::memcpy(left, a + i, (count - i) * sizeof(double));
+        std::memcpy(right, b + i, (count - i) * sizeof(double));
+        L::store(result, vector(L::load(left), L::load(right)));
+        std::memcpy(out + i, result, (count - i) * sizeof(double));
+    }
+}
+
+/**
+ * @brief Aplica una operación binaria, resolviendo con scalar los carriles especiales.
+ *
+ * Igual que mapUnary, incluido el búfer relleno del último bloque.
+ */
+template <class L, class Vector, class Special, class Scalar>
+void mapBinary(const double* a, const double* b, double* out, std::size_t count, Vector vector, Special special, Scalar scalar) {
+    constexpr std::size_t width = L::width;
+    auto block = [&](const double* inLeft, const double* inRight, double* result) {
+        const typename L::reg left = L::load(inLeft);
+        const typename L::reg right = L::load(inRight);
+        const int lanes = L::maskBits(special(left, right));
+        if (lanes == 0)
+        {
+            L::store(result, vector(left, right));
+            return;
+        }
+        double outputs[width];
+        L::store(outputs, vector(left, right));
+        for (std::size_t lane = 0; lane < width; lane++)
+        {
+            if ((lanes >> lane) & 1)
+            {
+                outputs[lane] = scalar(inLeft[lane], inRight[lane]);
+            }
+        }
+        std::memcpy(result, outputs, sizeof outputs);
+    };
+
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        block(a + i, b + i, out + i);
+    }
+    if (i < count)
+    {
+        double left[width] = {};
+        double right[width] = {};
+        double result[width];
+        std::memcpy(left, a + i, (count - i) * sizeof(double));
+        std::memcpy(right, b + i, (count - i) * sizeof(double));
+        block(left, right, result);
+        std::memcpy(out + i, result, (count - i) * sizeof(double));
+    }
+}
+
+template <class L>
+typename L::mask noSpecial(typename L::reg) {
+    return L::less(L::set(1.0), L::set(0.0));
+}
+
+template <class L> void addKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::add(x, y); });
+}
+template <class L> void subtractKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::sub(x, y); });
+}
+template <class L> void multiplyKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::mul(x, y); });
+}
+template <class L> void divideKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::div(x, y); });
+}
+
+template <class L> void moduloKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return remainder<L>(x, y); },
+        remainderSpecial<L>, [](double x, double y) { return std::fmod(x, y); });
+}
+template <class L> void powerKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto x, auto y) { return power<L>(x, y); },
+        powerSpecial<L>, [](double x, double y) { return std::pow(x, y); });
+}
+template <class L> void logBaseKernel(const double* a, const double* b, double* out, std::size_t n) {
+    mapBinary<L>(a, b, out, n, [](auto base, auto x) { return L::div(naturalLog<L>(x), naturalLog<L>(base)); },
+        [](auto base, auto x) { return L::maskOr(logSpecial<L>(base), logSpecial<L>(x)); },
+        [](double base, double x) { return std::log(x) / std::log(base); });
+}
+template <class L> void nrootKernel(const double* a, const double* b, double* out, std::size_t n) {
+    // Misma fórmula que realRoot en scalar_ops.hpp, que aquí no puede incluirse.
+    mapBinary<L>(a, b, out, n, [](auto index, auto x) { return realRoot<L>(index, x); }, realRootSpecial<L>, [](double index, double x) {
+        if (x < 0.0 && std::fmod(index, 2.0) != 0.0 && std::trunc(index) == index)
+        {
+            return -std::pow(-x, 1.0 / index);
+        }
+        return std::pow(x, 1.0 / index);
+    });
+}
+
+template <class L> void negateKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return negate<L>(x); }, noSpecial<L>, [](double x) { return -x; });
+}
+template <class L> void absKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return absolute<L>(x); }, noSpecial<L>, [](double x) { return std::fabs(x); });
+}
+template <class L> void sqrtKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return L::sqrt(x); }, noSpecial<L>, [](double x) { return std::sqrt(x); });
+}
+
+template <class L> void sinKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return s; },
+        trigSpecial<L>, [](double x) { return std::sin(x); });
+}
+template <class L> void cosKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return c; },
+        trigSpecial<L>, [](double x) { return std::cos(x); });
+}
+template <class L> void tanKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(s, c); },
+        trigSpecial<L>, [](double x) { return std::tan(x); });
+}
+template <class L> void secKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(L::set(1.0), c); },
+        trigSpecial<L>, [](double x) { return 1.0 / std::cos(x); });
+}
+template <class L> void cscKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(L::set(1.0), s); },
+        trigSpecial<L>, [](double x) { return 1.0 / std::sin(x); });
+}
+template <class L> void cotKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(c, s); },
+        trigSpecial<L>, [](double x) { return std::cos(x) / std::sin(x); });
+}
+
+template <class L> void lnKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return naturalLog<L>(x); }, logSpecial<L>, [](double x) { return std::log(x); });
+}
+template <class L> void logKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return L::mul(naturalLog<L>(x), L::set(4.34294481903251827651e-01)); },
+        logSpecial<L>, [](double x) { return std::log10(x); });
+}
+
+template <class L> void atanKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcTangent<L>(x); }, noSpecial<L>, [](double x) { return std::atan(x); });
+}
+template <class L> void asinKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcSine<L>(x); }, noSpecial<L>, [](double x) { return std::asin(x); });
+}
+template <class L> void acosKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcCosine<L>(x); }, noSpecial<L>, [](double x) { return std::acos(x); });
+}
+template <class L> void asecKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcCosine<L>(L::div(L::set(1.0), x)); },
+        noSpecial<L>, [](double x) { return std::acos(1.0 / x); });
+}
+template <class L> void acscKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcSine<L>(L::div(L::set(1.0), x)); },
+        noSpecial<L>, [](double x) { return std::asin(1.0 / x); });
+}
+template <class L> void acotKernel(const double* a, double* out, std::size_t n) {
+    mapUnary<L>(a, out, n, [](auto x) { return arcTangent<L>(L::div(L::set(1.0), x)); },
+        noSpecial<L>, [](double x) { return std::atan(1.0 / x); });
+}
+
+/**
+ * @brief Construye la tabla del carril L partiendo de la escalar.
+ *
+ * Las operaciones sin versión vectorial conservan el núcleo escalar.
+ */
+template <class L>
+kernelTable makeKernelTable(const char* name) {
+    kernelTable table = scalarKernels();
+    table.name = name;
+
+    auto setUnary = [&](opCode op, unaryKernel kernel) { table.unary[static_cast<std::size_t>(op)] = kernel; };
+    auto setBinary = [&](opCode op, binaryKernel kernel) { table.binary[static_cast<std::size_t>(op)] = kernel; };
+
+    setBinary(opCode::Add, addKernel<L>);
+    setBinary(opCode::Subtract, subtractKernel<L>);
+    setBinary(opCode::Multiply, multiplyKernel<L>);
+    setBinary(opCode::Divide, divideKernel<L>);
+    setBinary(opCode::Modulo, moduloKernel<L>);
+    setBinary(opCode::LogBase, logBaseKernel<L>);
+    if constexpr (L::width >= 4)
+    {
+        // Con dos carriles el pow de fdlibm tarda el doble que el de libm.
+        setBinary(opCode::Power, powerKernel<L>);
+        setBinary(opCode::Nroot, nrootKernel<L>);
+    }
+    setUnary(opCode::Negate, negateKernel<L>);
+    setUnary(opCode::Abs, absKernel<L>);
+    setUnary(opCode::Sqrt, sqrtKernel<L>);
+    setUnary(opCode::Sin, sinKernel<L>);
+    setUnary(opCode::Cos, cosKernel<L>);
+    setUnary(opCode::Tan, tanKernel<L>);
+    setUnary(opCode::Sec, secKernel<L>);
+    setUnary(opCode::Csc, cscKernel<L>);
+    setUnary(opCode::Cot, cotKernel<L>);
+    setUnary(opCode::Ln, lnKernel<L>);
+    setUnary(opCode::Log, logKernel<L>);
+    setUnary(opCode::Asin, asinKernel<L>);
+    setUnary(opCode::Acos, acosKernel<L>);
+    setUnary(opCode::Atan, atanKernel<L>);
+    setUnary(opCode::Asec, asecKernel<L>);
+    setUnary(opCode::Acsc, acscKernel<L>);
+    setUnary(opCode::Acot, acotKernel<L>);
+    return table;
+}
+
+} // namespace simdMath
+
+#endif // SIMD_MATH_HPP
@@ -0,0 +1,565 @@
+/**
+ * @file simd_math_float.hpp
+ * @brief Funciones matemáticas vectorizadas en float, genéricas sobre el tipo de carril.
+ *
+ * Contraparte en precisión simple de simd_math.hpp, con las mismas reglas:
+ * solo plantillas que dependen del carril, y cada kernels_<isa>.cpp declara
+ * su carril de floats en un espacio de nombres anónimo y llama a
+ * makeFloatKernelTable<lane>().
+ *
+ * Un carril de floats L debe proporcionar lo mismo que uno de doubles, pero
+ * sobre float y enteros de 32 bits:
+ * - L::reg, L::mask y L::width.
+ * - load, store, set(float), setBits(uint32).
+ * - add, sub, mul, div, fma (a*b+c), sqrt.
+ * - bitAnd, bitOr, bitXor, shiftLeft<n>, shiftRight<n> (sobre los bits de 32).
+ * - less(a,b), notLessEqual(a,b) (verdadero también con NaN), equal(a,b), maskOr, maskAnd.
+ * - select(m, a, b) (m ? a : b) y maskBits(m) (un bit por carril).
+ *
+ * Los polinomios son los de precisión simple de Cephes (sinf, cosf, logf,
+ * expf, atanf).
+ */
+#ifndef SIMD_MATH_FLOAT_HPP
+#define SIMD_MATH_FLOAT_HPP
+
+#include "kernels.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace simdMathFloat {
+
+/// Máscara del bit de signo de un float.
+constexpr std::uint32_t signBit = 0x80000000u;
+
+/// 1.5 * 2^23: sumarlo y restarlo redondea al entero más cercano (|x| < 2^22).
+constexpr float roundingMagic = 12582912.0f;
+
+/// Límite de |x| hasta el que la reducción de sin/cos es exacta.
+constexpr float trigLimit = 8192.0f;
+
+/// Límite de |x| hasta el que la precisión Fast usa la reducción vectorial.
+constexpr float relaxedTrigLimit = 2097152.0f;
+
+/// Menor float normal positivo.
+constexpr float smallestNormal = 1.17549435e-38f;
+
+/// Mayor float finito.
+constexpr float largestFinite = 3.40282347e+38f;
+
+template <class L>
+typename L::reg roundNearest(typename L::reg x) {
+    return L::sub(L::add(x, L::set(roundingMagic)), L::set(roundingMagic));
+}
+
+template <class L>
+typename L::reg negate(typename L::reg x) {
+    return L::bitXor(x, L::setBits(signBit));
+}
+
+template <class L>
+typename L::reg absolute(typename L::reg x) {
+    return L::bitAnd(x, L::setBits(~signBit));
+}
+
+/**
+ * @brief Calcula sin(x) y cos(x) a la vez.
+ *
+ * Reduce x a r = x - q*pi/2 con pi/2 dividido en cuatro partes (de 8, 11 y
+ * 11 bits, más el resto), de modo que los tres primeros productos son exactos
+ * para |x| <= trigLimit aun sin fma fusionada, y evalúa los polinomios de
+ * Cephes en [-pi/4, pi/4]. Más allá de trigLimit, y hasta relaxedTrigLimit,
+ * el error crece con |x|.
+ */
+template <class L>
+void sinCos(typename L::reg x, typename L::reg& sinOut, typename L::reg& cosOut) {
+    using reg = typename L::reg;
+    const reg q = roundNearest<L>(L::mul(x, L::set(0.636619772367581343f)));
+
+    reg r = L::sub(x, L::mul(q, L::set(1.5703125f)));
+    r = L::sub(r, L::mul(q, L::set(4.837512969970703125e-4f)));
+    r = L::sub(r, L::mul(q, L::set(7.549533620476723e-8f)));
+    r = L::sub(r, L::mul(q, L::set(2.5633440682570896e-12f)));
+
+    const reg z = L::mul(r, r);
+
+    reg sinPoly = L::set(-1.9515295891e-4f);
+    sinPoly = L::fma(sinPoly, z, L::set(8.3321608736e-3f));
+    sinPoly = L::fma(sinPoly, z, L::set(-1.6666654611e-1f));
+    const reg sinR = L::fma(L::mul(r, z), sinPoly, r);
+
+    reg cosPoly = L::set(2.443315711809948e-5f);
+    cosPoly = L::fma(cosPoly, z, L::set(-1.388731625493765e-3f));
+    cosPoly = L::fma(cosPoly, z, L::set(4.166664568298827e-2f));
+    const reg cosR = L::fma(L::mul(z, z), cosPoly, L::sub(L::set(1.0f), L::mul(z, L::set(0.5f))));
+
+    // q mod 4 sin convertir a entero, como en simd_math.hpp.
+    const reg quarter = roundNearest<L>(L::fma(q, L::set(0.25f), L::set(-0.375f)));
+    const reg quadrant = L::fma(quarter, L::set(-4.0f), q);
+
+    const typename L::mask odd = L::maskOr(
+        L::maskAnd(L::less(L::set(0.5f), quadrant), L::less(quadrant, L::set(1.5f))),
+        L::less(L::set(2.5f), quadrant));
+    const typename L::mask sinNegative = L::less(L::set(1.5f), quadrant);
+    const typename L::mask cosNegative = L::maskAnd(L::less(L::set(0.5f), quadrant), L::less(quadrant, L::set(2.5f)));
+
+    const reg sinX = L::select(odd, cosR, sinR);
+    const reg cosX = L::select(odd, sinR, cosR);
+    sinOut = L::select(sinNegative, negate<L>(sinX), sinX);
+    cosOut = L::select(cosNegative, negate<L>(cosX), cosX);
+}
+
+/**
+ * @brief Carriles que sin/cos resuelven en double: |x| > trigLimit, NaN, y
+ * ceros o subnormales (para conservar el signo de -0 en sin, csc y cot).
+ */
+template <class L>
+typename L::mask trigSpecial(typename L::reg x) {
+    const typename L::reg magnitude = absolute<L>(x);
+    return L::maskOr(L::notLessEqual(magnitude, L::set(trigLimit)), L::less(magnitude, L::set(smallestNormal)));
+}
+
+/**
+ * @brief Carriles que sin/cos resuelven en double en la precisión Fast: solo |x| > relaxedTrigLimit y NaN.
+ */
+template <class L>
+typename L::mask relaxedTrigSpecial(typename L::reg x) {
+    return L::notLessEqual(absolute<L>(x), L::set(relaxedTrigLimit));
+}
+
+/**
+ * @brief Logaritmo natural de x normal, positivo y finito, restando shift al exponente (algoritmo de Cephes).
+ */
+template <class L>
+typename L::reg naturalLog(typename L::reg x, typename L::reg shift) {
+    using reg = typename L::reg;
+    // Exponente como float: los 8 bits se colocan en la mantisa de 2^23.
+    const reg exponentBits = L::bitOr(L::template shiftRight<23>(x), L::setBits(0x4B000000u));
+    reg exponent = L::sub(L::sub(L::sub(exponentBits, L::set(8388608.0f)), L::set(127.0f)), shift);
+
+    reg m = L::bitOr(L::bitAnd(x, L::setBits(0x007FFFFFu)), L::setBits(0x3F800000u));
+    const typename L::mask big = L::less(L::set(1.41421356237f), m);
+    m = L::select(big, L::mul(m, L::set(0.5f)), m);
+    exponent = L::select(big, L::add(exponent, L::set(1.0f)), exponent);
+
+    const reg f = L::sub(m, L::set(1.0f));
+    const reg z = L::mul(f, f);
+    reg p = L::set(7.0376836292e-2f);
+    p = L::fma(p, f, L::set(-1.1514610310e-1f));
+    p = L::fma(p, f, L::set(1.1676998740e-1f));
+    p = L::fma(p, f, L::set(-1.2420140846e-1f));
+    p = L::fma(p, f, L::set(1.4249322787e-1f));
+    p = L::fma(p, f, L::set(-1.6668057665e-1f));
+    p = L::fma(p, f, L::set(2.0000714765e-1f));
+    p = L::fma(p, f, L::set(-2.4999993993e-1f));
+    p = L::fma(p, f, L::set(3.3333331174e-1f));
+
+    // log(x) = e*ln2_hi + (f + (f*z*p(f) + e*ln2_lo - z/2))
+    reg y = L::mul(L::mul(f, z), p);
+    y = L::fma(exponent, L::set(-2.12194440e-4f), y);
+    y = L::fma(z, L::set(-0.5f), y);
+    return L::fma(exponent, L::set(0.693359375f), L::add(f, y));
+}
+
+template <class L>
+typename L::mask logSpecial(typename L::reg x) {
+    return L::maskOr(L::notLessEqual(L::set(smallestNormal), x), L::notLessEqual(x, L::set(largestFinite)));
+}
+
+/**
+ * @brief Logaritmo natural con todos los casos resueltos en el carril (precisión Fast).
+ *
+ * Los subnormales se escalan por 2^23; 0 da -inf, los negativos NaN, y
+ * +inf y NaN se devuelven tal cual.
+ */
+template <class L>
+typename L::reg relaxedLog(typename L::reg x) {
+    using reg = typename L::reg;
+    const typename L::mask subnormal = L::less(x, L::set(smallestNormal));
+    const reg scaled = L::select(subnormal, L::mul(x, L::set(8388608.0f)), x);
+    const reg value = naturalLog<L>(scaled, L::select(subnormal, L::set(23.0f), L::set(0.0f)));
+
+    reg result = L::select(L::notLessEqual(x, L::set(largestFinite)), x, value);
+    result = L::select(L::equal(x, L::set(0.0f)), L::set(-INFINITY), result);
+    return L::select(L::less(x, L::set(0.0f)), L::set(NAN), result);
+}
+
+/**
+ * @brief e^x (algoritmo de Cephes), con desborde a inf y resultados menores que ~1e-37 en 0.
+ */
+template <class L>
+typename L::reg exponential(typename L::reg x) {
+    using reg = typename L::reg;
+    const reg n = roundNearest<L>(L::mul(x, L::set(1.44269504088896341f)));
+    reg r = L::sub(x, L::mul(n, L::set(0.693359375f)));
+    r = L::sub(r, L::mul(n, L::set(-2.12194440e-4f)));
+
+    reg p = L::set(1.9875691500e-4f);
+    p = L::fma(p, r, L::set(1.3981999507e-3f));
+    p = L::fma(p, r, L::set(8.3334519073e-3f));
+    p = L::fma(p, r, L::set(4.1665795894e-2f));
+    p = L::fma(p, r, L::set(1.6666665459e-1f));
+    p = L::fma(p, r, L::set(5.0000001201e-1f));
+    const reg y = L::add(L::fma(L::mul(r, r), p, r), L::set(1.0f));
+
+    // 2^(n-1) armado en los bits del exponente, y luego por 2: así n = 128 no desborda antes de tiempo.
+    const reg scale = L::template shiftLeft<23>(L::add(n, L::set(roundingMagic + 126.0f)));
+    reg result = L::mul(L::mul(y, scale), L::set(2.0f));
+    result = L::select(L::less(L::set(88.7228394f), x), L::set(INFINITY), result);
+    return L::select(L::less(x, L::set(-86.5f)), L::set(0.0f), result);
+}
+
+/**
+ * @brief Arcotangente (algoritmo de Cephes con tres intervalos de reducción).
+ */
+template <class L>
+typename L::reg arcTangent(typename L::reg x) {
+    using reg = typename L::reg;
+    const reg sign = L::bitAnd(x, L::setBits(signBit));
+    const reg a = absolute<L>(x);
+
+    const typename L::mask large = L::less(L::set(2.414213562373095f), a);
+    const typename L::mask medium = L::less(L::set(0.4142135623730950f), a); // Los selects dan prioridad a large
+
+    const reg numerator = L::select(large, L::set(-1.0f), L::select(medium, L::sub(a, L::set(1.0f)), a));
+    const reg denominator = L::select(large, a, L::select(medium, L::add(a, L::set(1.0f)), L::set(1.0f)));
+    const reg t = L::div(numerator, denominator);
+    const reg base = L::select(large, L::set(1.57079632679489661923f), L::select(medium, L::set(0.78539816339744830962f), L::set(0.0f)));
+
+    const reg z = L::mul(t, t);
+    reg p = L::set(8.05374449538e-2f);
+    p = L::fma(p, z, L::set(-1.38776856032e-1f));
+    p = L::fma(p, z, L::set(1.99777106478e-1f));
+    p = L::fma(p, z, L::set(-3.33329491539e-1f));
+    const reg result = L::add(base, L::fma(L::mul(z, t), p, t));
+    return L::bitOr(result, sign);
+}
+
+template <class L>
+typename L::mask differs(typename L::reg a, typename L::reg b) {
+    return L::maskOr(L::less(a, b), L::less(b, a));
+}
+
+/**
+ * @brief Indica qué carriles de y son enteros y cuáles enteros impares.
+ *
+ * Restar 2^23 y 2^22 (exacto en el rango en que se restan) no cambia la
+ * paridad y deja |y| por debajo de 2^22, donde roundNearest es exacto. Desde
+ * 2^24 todos los floats son pares, igual que los infinitos.
+ */
+template <class L>
+void classifyInteger(typename L::reg y, typename L::mask& integer, typename L::mask& odd) {
+    using reg = typename L::reg;
+    reg reduced = absolute<L>(y);
+    reduced = L::select(L::less(L::set(16777215.0f), reduced), L::set(0.0f), reduced);
+    reduced = L::select(L::less(L::set(8388607.5f), reduced), L::sub(reduced, L::set(8388608.0f)), reduced);
+    reduced = L::select(L::less(L::set(4194303.75f), reduced), L::sub(reduced, L::set(4194304.0f)), reduced);
+    integer = L::equal(roundNearest<L>(reduced), reduced);
+    const reg half = L::mul(reduced, L::set(0.5f));
+    odd = L::maskAnd(integer, differs<L>(roundNearest<L>(half), half));
+}
+
+/**
+ * @brief x^y por exp(y ln|x|), con los casos de std::pow resueltos por selecciones.
+ *
+ * Para x negativo y finito el exponente tiene que ser entero; el signo sale de su paridad.
+ */
+template <class L>
+typename L::reg relaxedPower(typename L::reg x, typename L::reg y) {
+    using reg = typename L::reg;
+    const reg magnitude = exponential<L>(L::mul(y, relaxedLog<L>(absolute<L>(x))));
+    typename L::mask integer;
+    typename L::mask odd;
+    classifyInteger<L>(y, integer, odd);
+
+    const typename L::mask negative = L::less(x, L::set(0.0f));
+    reg result = L::select(L::maskAnd(negative, odd), negate<L>(magnitude), magnitude);
+    const typename L::mask defined = L::maskOr(integer, L::equal(x, L::set(-INFINITY)));
+    result = L::select(negative, L::select(defined, result, L::set(NAN)), result);
+    // 1^y = 1 y (-1)^(+-inf) = 1 aunque y sea NaN o infinito.
+    const typename L::mask unitBase = L::maskOr(L::equal(x, L::set(1.0f)),
+        L::maskAnd(L::equal(x, L::set(-1.0f)), L::equal(absolute<L>(y), L::set(INFINITY))));
+    result = L::select(unitBase, L::set(1.0f), result);
+    return L::select(L::equal(y, L::set(0.0f)), L::set(1.0f), result);
+}
+
+/**
+ * @brief Raíz n-ésima real (ver realRoot en scalar_ops.hpp) a partir de relaxedPower.
+ *
+ * Como en realRoot, n infinito cuenta como impar (std::fmod da NaN).
+ */
+template <class L>
+typename L::reg relaxedRoot(typename L::reg n, typename L::reg x) {
+    typename L::mask integer;
+    typename L::mask odd;
+    classifyInteger<L>(n, integer, odd);
+    odd = L::maskOr(odd, L::equal(absolute<L>(n), L::set(INFINITY)));
+    const typename L::mask oddNegative = L::maskAnd(L::less(x, L::set(0.0f)), odd);
+    const typename L::reg root = relaxedPower<L>(L::select(oddNegative, negate<L>(x), x), L::div(L::set(1.0f), n));
+    return L::select(oddNegative, negate<L>(root), root);
+}
+
+/**
+ * @brief asin(x) = atan(x / sqrt((1 - x)(1 + x))); fuera de [-1, 1] da NaN.
+ */
+template <class L>
+typename L::reg relaxedArcSine(typename L::reg x) {
+    const typename L::reg one = L::set(1.0f);
+    return arcTangent<L>(L::div(x, L::sqrt(L::mul(L::sub(one, x), L::add(one, x)))));
+}
+
+/**
+ * @brief acos(x) = 2 atan(sqrt((1 - x) / (1 + x))); fuera de [-1, 1] da NaN.
+ */
+template <class L>
+typename L::reg relaxedArcCosine(typename L::reg x) {
+    const typename L::reg one = L::set(1.0f);
+    return L::mul(L::set(2.0f), arcTangent<L>(L::sqrt(L::div(L::sub(one, x), L::add(one, x)))));
+}
+
+/**
+ * @brief asec(x) = acos(1/x) = atan(sqrt(x^2 - 1)), o pi menos eso si x < 0.
+ *
+ * Sin pasar por 1/x, que cerca de |x| = 1 pierde casi toda la precisión del resultado.
+ */
+template <class L>
+typename L::reg relaxedArcSecant(typename L::reg x) {
+    using reg = typename L::reg;
+    const reg one = L::set(1.0f);
+    const reg angle = arcTangent<L>(L::sqrt(L::mul(L::sub(x, one), L::add(x, one))));
+    return L::select(L::less(x, L::set(0.0f)), L::sub(L::set(3.14159265358979323846f), angle), angle);
+}
+
+/**
+ * @brief acsc(x) = asin(1/x) = atan(1 / (|x| sqrt(((|x| - 1) / |x|) ((|x| + 1) / |x|)))), con el signo de x.
+ *
+ * |x| - 1 es exacto, así que cerca de |x| = 1 no se pierde precisión, y
+ * dividir cada factor por |x| evita que x^2 desborde.
+ */
+template <class L>
+typename L::reg relaxedArcCosecant(typename L::reg x) {
+    using reg = typename L::reg;
+    const reg one = L::set(1.0f);
+    const reg magnitude = absolute<L>(x);
+    const reg below = L::div(L::sub(magnitude, one), magnitude);
+    const reg above = L::div(L::add(magnitude, one), magnitude);
+    reg scaled = L::mul(magnitude, L::sqrt(L::mul(below, above)));
+    scaled = L::select(L::equal(magnitude, L::set(INFINITY)), magnitude, scaled);
+    return L::bitOr(arcTangent<L>(L::div(one, scaled)), L::bitAnd(x, L::setBits(signBit)));
+}
+
+/**
+ * @brief Aplica f carril por carril, resolviendo con scalar los carriles especiales.
+ *
+ * Igual que simdMath::mapUnary: el último bloque incompleto va en un búfer
+ * relleno para que cada valor dé lo mismo sin importar su posición.
+ */
+template <class L, class Vector, class Special, class Scalar>
+void mapUnary(const float* a, float* out, std::size_t count, Vector vector, Special special, Scalar scalar) {
+    constexpr std::size_t width = L::width;
+    auto block = [&](const float* in, float* result) {
+        const typename L::reg value = L::load(in);
+        const int lanes = L::maskBits(special(value));
+        if (lanes == 0)
+        {
+            L::store(result, vector(value));
+            return;
+        }
+        float inputs[width];
+        float outputs[width];
+        L::store(inputs, value);
+        L::store(outputs, vector(value));
+        for (std::size_t lane = 0; lane < width; lane++)
+        {
+            if ((lanes >> lane) & 1)
+            {
+                outputs[lane] = static_cast<float>(scalar(static_cast<double>(inputs[lane])));
+            }
+        }
+        std::memcpy(result, outputs, sizeof outputs);
+    };
+
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        block(a + i, out + i);
+    }
+    if (i < count)
+    {
+        float padded[width] = {};
+        float result[width];
+        std::memcpy(padded, a + i, (count - i) * sizeof(float));
+        block(padded, result);
+        std::memcpy(out + i, result, (count - i) * sizeof(float));
+    }
+}
+
+/**
+ * @brief Aplica f carril por carril sin carriles especiales.
+ */
+template <class L, class Vector>
+void mapUnary(const float* a, float* out, std::size_t count, Vector vector) {
+    mapUnary<L>(a, out, count, vector, [](auto) { return L::less(L::set(1.0f), L::set(0.0f)); }, [](double x) { return x; });
+}
+
+/**
+ * @brief Aplica una operación binaria sin carriles especiales.
+ */
+template <class L, class Vector>
+void mapBinary(const float* a, const float* b, float* out, std::size_t count, Vector vector) {
+    constexpr std::size_t width = L::width;
+    std::size_t i = 0;
+    for (; i + width <= count; i += width)
+    {
+        L::store(out + i, vector(L::load(a + i), L::load(b + i)));
+    }
+    if (i < count)
+    {
+        float left[width] = {};
+        float right[width] = {};
+        float result[width];
+        std::memcpy(left, a + i, (count - i) * sizeof(float));
+        std::memcpy(right, b + i, (count - i) * sizeof(float));
+        L::store(result, vector(L::load(left), L::load(right)));
+        std::memcpy(out + i, result, (count - i) * sizeof(float));
+    }
+}
+
+/**
+ * @brief Núcleos de sin, cos y sus derivados para la máscara de carriles especiales dada.
+ */
+template <class L, bool relaxed>
+struct trigKernels {
+    static typename L::mask special(typename L::reg x) {
+        return relaxed ? relaxedTrigSpecial<L>(x) : trigSpecial<L>(x);
+    }
+
+    static void sin(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return s; },
+            special, [](double x) { return std::sin(x); });
+    }
+    static void cos(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return c; },
+            special, [](double x) { return std::cos(x); });
+    }
+    static void tan(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(s, c); },
+            special, [](double x) { return std::tan(x); });
+    }
+    static void sec(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(L::set(1.0f), c); },
+            special, [](double x) { return 1.0 / std::cos(x); });
+    }
+    static void csc(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(L::set(1.0f), s); },
+            special, [](double x) { return 1.0 / std::sin(x); });
+    }
+    static void cot(const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { typename L::reg s, c; sinCos<L>(x, s, c); return L::div(c, s); },
+            special, [](double x) { return std::cos(x) / std::sin(x); });
+    }
+};
+
+/**
+ * @brief Construye la tabla en float del carril L partiendo de la escalar.
+ *
+ * @param name Nombre de la tabla.
+ * @param relaxed true para la precisión Fast (ver kernels.hpp), false para Single.
+ */
+template <class L>
+floatKernelTable makeFloatKernelTable(const char* name, bool relaxed) {
+    floatKernelTable table = scalarFloatKernels();
+    table.name = name;
+
+    auto setUnary = [&](opCode op, unaryFloatKernel kernel) { table.unary[static_cast<std::size_t>(op)] = kernel; };
+    auto setBinary = [&](opCode op, binaryFloatKernel kernel) { table.binary[static_cast<std::size_t>(op)] = kernel; };
+
+    setBinary(opCode::Add, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::add(x, y); });
+    });
+    setBinary(opCode::Subtract, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::sub(x, y); });
+    });
+    setBinary(opCode::Multiply, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::mul(x, y); });
+    });
+    setBinary(opCode::Divide, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::div(x, y); });
+    });
+    setUnary(opCode::Negate, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return negate<L>(x); });
+    });
+    setUnary(opCode::Abs, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return absolute<L>(x); });
+    });
+    setUnary(opCode::Sqrt, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return L::sqrt(x); });
+    });
+    setUnary(opCode::Atan, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return arcTangent<L>(x); });
+    });
+    setUnary(opCode::Acot, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return arcTangent<L>(L::div(L::set(1.0f), x)); });
+    });
+
+    if (!relaxed)
+    {
+        using trig = trigKernels<L, false>;
+        setUnary(opCode::Sin, trig::sin);
+        setUnary(opCode::Cos, trig::cos);
+        setUnary(opCode::Tan, trig::tan);
+        setUnary(opCode::Sec, trig::sec);
+        setUnary(opCode::Csc, trig::csc);
+        setUnary(opCode::Cot, trig::cot);
+        setUnary(opCode::Ln, [](const float* a, float* out, std::size_t n) {
+            mapUnary<L>(a, out, n, [](auto x) { return naturalLog<L>(x, L::set(0.0f)); }, logSpecial<L>,
+                [](double x) { return std::log(x); });
+        });
+        setUnary(opCode::Log, [](const float* a, float* out, std::size_t n) {
+            mapUnary<L>(a, out, n, [](auto x) { return L::mul(naturalLog<L>(x, L::set(0.0f)), L::set(0.434294481903251827651f)); },
+                logSpecial<L>, [](double x) { return std::log10(x); });
+        });
+        return table;
+    }
+
+    using trig = trigKernels<L, true>;
+    setUnary(opCode::Sin, trig::sin);
+    setUnary(opCode::Cos, trig::cos);
+    setUnary(opCode::Tan, trig::tan);
+    setUnary(opCode::Sec, trig::sec);
+    setUnary(opCode::Csc, trig::csc);
+    setUnary(opCode::Cot, trig::cot);
+    setUnary(opCode::Ln, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return relaxedLog<L>(x); });
+    });
+    setUnary(opCode::Log, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return L::mul(relaxedLog<L>(x), L::set(0.434294481903251827651f)); });
+    });
+    setUnary(opCode::Asin, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return relaxedArcSine<L>(x); });
+    });
+    setUnary(opCode::Acos, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return relaxedArcCosine<L>(x); });
+    });
+    setUnary(opCode::Acsc, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return relaxedArcCosecant<L>(x); });
+    });
+    setUnary(opCode::Asec, [](const float* a, float* out, std::size_t n) {
+        mapUnary<L>(a, out, n, [](auto x) { return relaxedArcSecant<L>(x); });
+    });
+    setBinary(opCode::Power, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return relaxedPower<L>(x, y); });
+    });
+    setBinary(opCode::Nroot, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return relaxedRoot<L>(x, y); });
+    });
+    setBinary(opCode::LogBase, [](const float* a, const float* b, float* out, std::size_t n) {
+        mapBinary<L>(a, b, out, n, [](auto x, auto y) { return L::div(relaxedLog<L>(y), relaxedLog<L>(x)); });
+    });
+    return table;
+}
+
+} // namespace simdMathFloat
+
+#endif // SIMD_MATH_FLOAT_HPP
@@ -0,0 +1,1366 @@
+/**
+ * @file differential.cpp
+ * @brief Implementación de las comparaciones diferenciales.
+ */
+
+#include "differential.hpp"
+#include "reference_lexer.hpp"
+#include "evaluator/compiler.hpp"
+#include "evaluator/derivative.hpp"
+#include "evaluator/evaluator.hpp"
+#include "evaluator/interval.hpp"
+#include "evaluator/jit.hpp"
+#include "evaluator/kernels.hpp"
+#include "tabulation/column_file.hpp"
+#include "tabulation/lod_pyramid.hpp"
+#include "tabulation/mapped_table.hpp"
+#include "tabulation/root_finder.hpp"
+#include "tabulation/sweep.hpp"
+#include "tabulation/table_writer.hpp"
+#include "tabulation/tabulate.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+/// Tablas SIMD que se comparan con las escalares.
+constexpr simdLevel vectorLevels[] = {simdLevel::SSE2, simdLevel::AVX2, simdLevel::AVX512, simdLevel::NEON};
+
+/// Muestras de las columnas de prueba: más de un bloque del evaluador y con resto en cualquier ancho de registro.
+constexpr std::size_t sampleCount = 389;
+
+/**
+ * @brief Nombre corto de una operación, para los informes.
+ */
+const char* opName(opCode op) {
+    static const char* const names[] = {
+        "constant", "variable", "+", "-", "*", "/", "%", "^", "neg",
+        "sin", "cos", "tan", "sec", "csc", "cot", "asin", "acos", "atan", "asec", "acsc", "acot",
+        "log", "ln", "log_base", "sqrt", "abs", "nroot",
+    };
+    static_assert(std::size(names) == opCodeCount);
+    return names[static_cast<std::size_t>(op)];
+}
+
+/**
+ * @brief printf sobre un std::string, para armar los detalles de cada divergencia.
+ */
+template <class... Args>
+std::string describe(const char* pattern, Args... args) {
+    char buffer[512];
+    std::snprintf(buffer, sizeof(buffer), pattern, args...);
+    return buffer;
+}
+
+// ---------------------------------------------------------------------------
+// Lexer
+// ---------------------------------------------------------------------------
+
+bool sameBits(double a, double b) {
+    return std::bit_cast<std::uint64_t>(a) == std::bit_cast<std::uint64_t>(b);
+}
+
+std::string describeToken(const tokenView& token) {
+    return describe("{tipo %d, aridad %d, '%.*s' en %zu, valor %.17g}", static_cast<int>(token.type), token.arity,
+        static_cast<int>(std::min<std::size_t>(token.text.size(), 40)), token.text.data(), token.offset, token.number);
+}
+
+/**
+ * @brief Primera diferencia entre dos listas de tokens de la misma expresión, o vacío si son iguales.
+ *
+ * Además de los campos, comprueba que el texto de cada token apunte a su
+ * posición dentro de source.
+ */
+template <class List>
+std::string firstTokenDifference(std::string_view source, const List& tokens, const std::vector<tokenView>& expected) {
+    const std::size_t common = std::min<std::size_t>(tokens.size(), expected.size());
+    for (std::size_t k = 0; k < common; k++)
+    {
+        const tokenView& got = tokens[k];
+        const tokenView& want = expected[k];
+        const bool same = got.type == want.type && got.arity == want.arity && got.offset == want.offset
+            && got.text.size() == want.text.size() && got.text.data() == source.data() + got.offset
+            && sameBits(got.number, want.number);
+        if (!same)
+        {
+            return describe("token %zu: %s en lugar de %s", k, describeToken(got).c_str(), describeToken(want).c_str());
+        }
+    }
+    if (tokens.size() != expected.size())
+    {
+        return describe("%zu tokens en lugar de %zu", static_cast<std::size_t>(tokens.size()), expected.size());
+    }
+    return {};
+}
+
+template <class List>
+std::string firstDiagnosticDifference(const List& diagnostics, const std::vector<diagnostic>& expected) {
+    const std::size_t common = std::min<std::size_t>(diagnostics.size(), expected.size());
+    for (std::size_t k = 0; k < common; k++)
+    {
+        const diagnostic& got = diagnostics[k];
+        const diagnostic& want = expected[k];
+        if (got.kind != want.kind || got.offset != want.offset || got.length != want.length)
+        {
+            return describe("diagnóstico %zu: {tipo %d, en %zu, %zu bytes} en lugar de {tipo %d, en %zu, %zu bytes}", k,
+                static_cast<int>(got.kind), got.offset, got.length, static_cast<int>(want.kind), want.offset, want.length);
+        }
+    }
+    if (diagnostics.size() != expected.size())
+    {
+        return describe("%zu diagnósticos en lugar de %zu", static_cast<std::size_t>(diagnostics.size()), expected.size());
+    }
+    return {};
+}
+
+/**
+ * @brief Primera diferencia entre una lista empaquetada y la de referencia, o vacío si son iguales.
+ */
+std::string firstPackedDifference(std::string_view source, const tokenStream& tokens, const std::vector<tokenView>& expected) {
+    if (tokens.source.data() != source.data() || tokens.source.size() != source.size())
+    {
+        return "la lista no apunta a la expresión analizada";
+    }
+    if (tokens.size() != expected.size() || tokens.offsets.size() != expected.size() || tokens.lengths.size() != expected.size())
+    {
+        return describe("%zu tokens en lugar de %zu", tokens.size(), expected.size());
+    }
+    std::size_t number = 0;
+    for (std::size_t k = 0; k < expected.size(); k++)
+    {
+        const tokenView& want = expected[k];
+        if (tokens.types[k] != want.type || tokens.offsets[k] != want.offset || tokens.lengths[k] != want.text.size())
+        {
+            return describe("token %zu: {tipo %d, en %u, %u bytes} en lugar de %s", k, static_cast<int>(tokens.types[k]),
+                tokens.offsets[k], tokens.lengths[k], describeToken(want).c_str());
+        }
+        if (want.type == tokenType::Number || want.type == tokenType::Constant)
+        {
+            if (number >= tokens.numbers.size() || !sameBits(tokens.numbers[number], want.number))
+            {
+                return describe("valor %zu (token %zu) distinto de %.17g", number, k, want.number);
+            }
+            number++;
+        }
+    }
+    if (number != tokens.numbers.size())
+    {
+        return describe("%zu valores en lugar de %zu", tokens.numbers.size(), number);
+    }
+    return {};
+}
+
+/**
+ * @brief Ejecuta f y devuelve el mensaje de la excepción que lanza, o vacío si no lanza.
+ */
+template <class Function>
+std::string thrownMessage(Function f) {
+    try
+    {
+        f();
+    }
+    catch (const std::runtime_error& error)
+    {
+        return std::string("!") + error.what();
+    }
+    return {};
+}
+
+// ---------------------------------------------------------------------------
+// Núcleos y evaluador
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Distancia en ulps contando los infinitos como un paso más allá del mayor finito
+ * y -0 y +0 como valores vecinos.
+ */
+template <class Bits, class Value>
+Bits ulpDistance(Value a, Value b) {
+    constexpr Bits sign = Bits(1) << (sizeof(Bits) * 8 - 1);
+    auto ordered = [](Value v) {
+        const Bits bits = std::bit_cast<Bits>(v);
+        return (bits & sign) ? (sign - 1) - (bits & ~sign) : sign + bits;
+    };
+    const Bits x = ordered(a);
+    const Bits y = ordered(b);
+    return x > y ? x - y : y - x;
+}
+
+/**
+ * @struct margin
+ * @brief Diferencia admitida entre un núcleo y su referencia en una muestra.
+ */
+struct margin {
+    double ulps = 0.0; ///< Ulps de distancia admitidos
+    double absolute = 0.0; ///< Error absoluto admitido, además de los ulps
+    bool anySign = false; ///< Si ceros e infinitos se aceptan con cualquier signo
+    bool parityUnknown = false; ///< Si el signo, o que sea NaN, depende de un redondeo que la tabla hace distinto
+};
+
+/**
+ * @brief Compara una muestra; los NaN solo coinciden con NaN.
+ */
+template <class Bits, class Value>
+bool agrees(Value expected, Value actual, const margin& allowed) {
+    if (std::isnan(expected) || std::isnan(actual))
+    {
+        return allowed.parityUnknown || (std::isnan(expected) && std::isnan(actual));
+    }
+    if (allowed.parityUnknown)
+    {
+        expected = std::fabs(expected);
+        actual = std::fabs(actual);
+    }
+    if (allowed.anySign && (expected == 0 || std::isinf(expected)) && std::fabs(expected) == std::fabs(actual))
+    {
+        return true;
+    }
+    if (std::fabs(static_cast<double>(expected) - static_cast<double>(actual)) <= allowed.absolute)
+    {
+        return true;
+    }
+    return static_cast<double>(ulpDistance<Bits>(expected, actual)) <= allowed.ulps;
+}
+
+/**
+ * @brief Margen de las tablas SIMD en double respecto de la escalar (ver kernels.hpp).
+ */
+margin doubleMargin(opCode op) {
+    switch (op)
+    {
+    case opCode::Sin:
+    case opCode::Cos:
+    case opCode::Sec:
+    case opCode::Csc:
+    case opCode::Log:
+        return {2.0};
+    case opCode::Tan:
+    case opCode::Cot:
+    case opCode::Asin:
+    case opCode::Acos:
+    case opCode::Asec:
+    case opCode::Acsc:
+        return {3.0};
+    case opCode::LogBase:
+        return {4.0};
+    case opCode::Ln:
+    case opCode::Atan:
+    case opCode::Acot:
+    case opCode::Power:
+    case opCode::Nroot:
+        return {1.0};
+    default:
+        return {};
+    }
+}
+
+bool isTrigonometric(opCode op) {
+    return op == opCode::Sin || op == opCode::Cos || op == opCode::Tan || op == opCode::Sec || op == opCode::Csc || op == opCode::Cot;
+}
+
+/**
+ * @brief Margen de las tablas en float respecto de scalarFloatKernels() (ver kernels.hpp).
+ *
+ * @param op Operación.
+ * @param relaxed Precisión Fast.
+ * @param a Primer operando de la muestra.
+ * @param b Segundo operando de la muestra (operaciones binarias).
+ */
+margin floatMargin(opCode op, bool relaxed, float a, float b) {
+    margin allowed;
+    switch (op)
+    {
+    case opCode::Sin:
+    case opCode::Cos:
+    case opCode::Log:
+        allowed.ulps = 2.0;
+        break;
+    case opCode::Atan:
+        allowed.ulps = 3.0;
+        break;
+    case opCode::Ln:
+        allowed.ulps = 1.0;
+        break;
+    case opCode::Tan:
+    case opCode::Cot:
+    case opCode::Sec:
+    case opCode::Csc:
+    case opCode::Acot:
+        allowed.ulps = 4.0;
+        break;
+    default:
+        break;
+    }
+    if (!relaxed)
+    {
+        return allowed;
+    }
+
+    // Fast: reducción más corta, funciones de arco y potencias vía exp y ln, sin -0 ni subnormales.
+    allowed.absolute = std::numeric_limits<float>::min();
+    if (isTrigonometric(op) && std::fabs(a) > 8192.0f)
+    {
+        allowed.absolute = op == opCode::Sin || op == opCode::Cos ? 0.1 : infinity;
+    }
+    switch (op)
+    {
+    case opCode::Asin:
+    case opCode::Acos:
+    case opCode::Asec:
+    case opCode::Acsc:
+        allowed.ulps = 4.0;
+        break;
+    case opCode::Csc:
+    case opCode::Cot:
+        allowed.anySign = a == 0.0f;
+        break;
+    case opCode::Power:
+        allowed.ulps = 2.0 * std::fabs(static_cast<double>(b) * std::log(std::fabs(static_cast<double>(a)))) + 8.0;
+        allowed.anySign = a == 0.0f;
+        allowed.absolute = 1e-37;
+        break;
+    case opCode::Nroot:
+        // 1/n se redondea a float: 1.5 veces el margen de ^.
+        allowed.ulps = 3.0 * std::fabs(std::log(std::fabs(static_cast<double>(b))) / static_cast<double>(a)) + 8.0;
+        allowed.anySign = b == 0.0f;
+        allowed.absolute = 1e-37;
+        // Con x < 0 y n no impar, la paridad de 1/n decide el signo o el NaN, y la tabla la mira ya redondeado.
+        allowed.parityUnknown = b < 0.0f && !(std::trunc(a) == a && std::fmod(a, 2.0f) != 0.0f)
+            && static_cast<double>(1.0f / a) != 1.0 / static_cast<double>(a);
+        break;
+    case opCode::LogBase:
+        allowed.ulps = 4.0;
+        break;
+    default:
+        break;
+    }
+    if (std::isnan(allowed.ulps))
+    {
+        allowed.ulps = 0.0;
+    }
+    return allowed;
+}
+
+/**
+ * @brief Columna de prueba: valores especiales seguidos de valores al azar de varias escalas.
+ */
+std::vector<double> makeColumn(unsigned seed) {
+    const double maximum = std::numeric_limits<double>::max();
+    const double denormal = std::numeric_limits<double>::denorm_min();
+    const double specials[] = {
+        0.0, -0.0, 1.0, -1.0, 0.5, -0.5, 2.0, -2.0, 3.0, 10.0, 0.1,
+        pi / 2, -pi / 2, pi, -pi, 3 * pi / 2, 2 * pi, 1e6 * pi, 2.5e6,
+        1.0 + 1e-12, 1.0 - 1e-12, 1.0001, -1.0001, 0.9999,
+        8192.5, 1e5 + 0.25, 3e6, 2.1e7, 1e17, 1e22,
+        1e-300, -1e-300, 1e-310, -1e-310, denormal, 1e300, -1e300, maximum, -maximum,
+        88.7, -87.0, 709.0, -745.0, 1e-38, 1e-45,
+        infinity, -infinity, std::numeric_limits<double>::quiet_NaN(),
+    };
+    std::vector<double> column(sampleCount);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull * (seed + 1);
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return static_cast<double>(state >> 11) / 9007199254740992.0;
+    };
+    for (std::size_t i = 0; i < sampleCount; i++)
+    {
+        // Cada columna recorre los especiales en otro orden, así se combinan entre sí.
+        const std::size_t special = (i * (2 * seed + 1) + seed) % (3 * std::size(specials));
+        if (special < std::size(specials))
+        {
+            column[i] = specials[special];
+            continue;
+        }
+        const double u = next();
+        switch (i % 4)
+        {
+        case 0:
+            column[i] = -10.0 + 20.0 * u;
+            break;
+        case 1:
+            column[i] = (next() < 0.5 ? -1.0 : 1.0) * std::pow(10.0, -30.0 + 60.0 * u);
+            break;
+        case 2:
+            column[i] = std::round(-20.0 + 40.0 * u) / (next() < 0.5 ? 1.0 : 2.0);
+            break;
+        default:
+            column[i] = -1.5 + 3.0 * u;
+            break;
+        }
+    }
+    return column;
+}
+
+/**
+ * @brief Columnas de prueba de x, y, z, construidas una sola vez.
+ */
+const std::vector<double>& sampleColumn(std::size_t variable) {
+    static const std::vector<double> columns[variableRegisterCount] = {makeColumn(0), makeColumn(1), makeColumn(2)};
+    return columns[variable];
+}
+
+variableInputs sampleInputs() {
+    return {sampleColumn(0), sampleColumn(1), sampleColumn(2)};
+}
+
+/**
+ * @brief Registros de un programa como columnas completas, con variables y constantes cargadas.
+ */
+template <class Value>
+std::vector<std::vector<Value>> loadRegisters(const bytecodeProgram& program) {
+    std::vector<std::vector<Value>> registers(program.registerCount, std::vector<Value>(sampleCount));
+    for (std::size_t v = 0; v < variableRegisterCount; v++)
+    {
+        const std::vector<double>& column = sampleColumn(v);
+        std::transform(column.begin(), column.end(), registers[v].begin(), [](double x) { return static_cast<Value>(x); });
+    }
+    for (std::size_t c = 0; c < program.constants.size(); c++)
+    {
+        std::fill(registers[variableRegisterCount + c].begin(), registers[variableRegisterCount + c].end(),
+            static_cast<Value>(program.constants[c]));
+    }
+    return registers;
+}
+
+/**
+ * @brief Columna del segundo operando, o nullptr si la operación tiene uno solo.
+ */
+template <class Value>
+const Value* secondOperand(const std::vector<std::vector<Value>>& registers, const instruction& step) {
+    return operandCount(step.op) == 2 ? registers[step.right].data() : nullptr;
+}
+
+/**
+ * @brief Aplica una instrucción de un programa a columnas completas.
+ */
+template <class Table, class Value>
+void apply(const Table& kernels, opCode op, const Value* a, const Value* b, Value* out) {
+    const std::size_t index = static_cast<std::size_t>(op);
+    if (operandCount(op) == 2)
+    {
+        kernels.binary[index](a, b, out, sampleCount);
+    }
+    else
+    {
+        kernels.unary[index](a, out, sampleCount);
+    }
+}
+
+/**
+ * @brief Ejecuta el programa sobre las columnas enteras, sin bloques ni reutilización de memoria.
+ */
+template <class Value, class Table>
+std::vector<double> runDirect(const bytecodeProgram& program, const Table& kernels) {
+    std::vector<std::vector<Value>> registers = loadRegisters<Value>(program);
+    for (const instruction& step : program.code)
+    {
+        std::vector<Value> out(sampleCount);
+        apply(kernels, step.op, registers[step.left].data(), secondOperand(registers, step), out.data());
+        registers[step.target] = std::move(out);
+    }
+    const std::vector<Value>& result = registers[program.result];
+    return std::vector<double>(result.begin(), result.end());
+}
+
+/**
+ * @brief Compara dos columnas de resultados bit a bit (los NaN coinciden entre sí).
+ */
+void compareColumns(std::string_view path, std::string_view expression, const std::vector<double>& actual,
+    const std::vector<double>& expected, differentialReport& report) {
+    report.comparisons++;
+    for (std::size_t i = 0; i < sampleCount; i++)
+    {
+        if (!sameBits(actual[i], expected[i]) && !(std::isnan(actual[i]) && std::isnan(expected[i])))
+        {
+            report.add(path, expression, describe("muestra %zu (x = %.17g, y = %.17g, z = %.17g): %.17g en lugar de %.17g",
+                i, sampleColumn(0)[i], sampleColumn(1)[i], sampleColumn(2)[i], actual[i], expected[i]));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Compara instrucción por instrucción cada tabla SIMD en double con la escalar.
+ */
+void compareDoubleKernels(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    std::vector<std::vector<double>> registers = loadRegisters<double>(program);
+    std::vector<double> expected(sampleCount);
+    std::vector<double> actual(sampleCount);
+    for (const instruction& step : program.code)
+    {
+        const double* a = registers[step.left].data();
+        const double* b = secondOperand(registers, step);
+        apply(scalarKernels(), step.op, a, b, expected.data());
+        const margin allowed = doubleMargin(step.op);
+        for (simdLevel level : vectorLevels)
+        {
+            const kernelTable* kernels = kernelsFor(level);
+            if (kernels == nullptr)
+            {
+                continue;
+            }
+            apply(*kernels, step.op, a, b, actual.data());
+            report.comparisons++;
+            for (std::size_t i = 0; i < sampleCount; i++)
+            {
+                if (!agrees<std::uint64_t>(expected[i], actual[i], allowed))
+                {
+                    const bool binary = operandCount(step.op) == 2;
+                    report.add(std::string(kernels->name) + "/" + opName(step.op), expression,
+                        describe("%s(%.17g%s%.17g): %.17g en lugar de %.17g (%.0f ulps admitidos)", opName(step.op), a[i],
+                            binary ? ", " : "", binary ? b[i] : 0.0, actual[i], expected[i], allowed.ulps));
+                    break;
+                }
+            }
+        }
+        registers[step.target] = expected;
+    }
+}
+
+/**
+ * @brief Compara instrucción por instrucción cada tabla en float con scalarFloatKernels().
+ *
+ * Las entradas de cada instrucción son los registros de la ejecución en
+ * double redondeados a float, las mismas para la referencia y la tabla.
+ */
+void compareFloatKernels(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    std::vector<std::vector<double>> registers = loadRegisters<double>(program);
+    std::vector<float> a(sampleCount);
+    std::vector<float> b(sampleCount);
+    std::vector<float> expected(sampleCount);
+    std::vector<float> actual(sampleCount);
+    std::vector<double> next(sampleCount);
+    for (const instruction& step : program.code)
+    {
+        const bool binary = operandCount(step.op) == 2;
+        std::transform(registers[step.left].begin(), registers[step.left].end(), a.begin(), [](double v) { return static_cast<float>(v); });
+        if (binary)
+        {
+            std::transform(registers[step.right].begin(), registers[step.right].end(), b.begin(), [](double v) { return static_cast<float>(v); });
+        }
+        apply(scalarFloatKernels(), step.op, a.data(), b.data(), expected.data());
+        for (bool relaxed : {false, true})
+        {
+            for (simdLevel level : vectorLevels)
+            {
+                const floatKernelTable* kernels = floatKernelsFor(level, relaxed);
+                if (kernels == nullptr)
+                {
+                    continue;
+                }
+                apply(*kernels, step.op, a.data(), b.data(), actual.data());
+                report.comparisons++;
+                for (std::size_t i = 0; i < sampleCount; i++)
+                {
+                    const margin allowed = floatMargin(step.op, relaxed, a[i], b[i]);
+                    if (!agrees<std::uint32_t>(expected[i], actual[i], allowed))
+                    {
+                        report.add(std::string(kernels->name) + "/" + opName(step.op), expression,
+                            describe("%s(%.9g%s%.9g): %.9g en lugar de %.9g (%.0f ulps admitidos)", opName(step.op), a[i],
+                                binary ? ", " : "", binary ? b[i] : 0.0f, actual[i], expected[i], allowed.ulps));
+                        break;
+                    }
+                }
+            }
+        }
+        apply(scalarKernels(), step.op, registers[step.left].data(), secondOperand(registers, step), next.data());
+        registers[step.target] = next;
+    }
+}
+
+/**
+ * @brief Comprueba que evaluateInterval() contenga los valores de f en puntos de cada caja.
+ *
+ * Cada variable recorre su intervalo en otro orden, así los puntos no caen
+ * todos sobre la diagonal de la caja. Un valor finito fuera del intervalo (o
+ * dentro de una caja marcada como vacía) es un falso negativo para
+ * locateImplicitCurve(); los infinitos solo se admiten fuera si la caja es parcial.
+ */
+void compareIntervals(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    static const interval boxes[] = {
+        {1.7, 1.725}, {-1.0, 1.0}, {0.0, 0.5}, {0.9, 1.1}, {-3.2, -3.1}, {2.0, 10.0},
+        {-1000.0, 1000.0}, {0.0, 0.0}, {1e-3, 2e-3}, {-0.25, 0.75}, {1.5, 1.6}, {-40.0, -7.0},
+    };
+    constexpr std::size_t steps = 33;
+    constexpr std::size_t strides[variableRegisterCount] = {1, 7, 13};
+    bytecodeProgram exact = program;
+    exact.precision = evaluationPrecision::Double;
+
+    std::vector<double> columns[variableRegisterCount];
+    std::vector<double> output(steps);
+    for (std::size_t k = 0; k < std::size(boxes); k++)
+    {
+        interval box[variableRegisterCount];
+        for (std::size_t v = 0; v < variableRegisterCount; v++)
+        {
+            box[v] = boxes[(k + v) % std::size(boxes)];
+            columns[v].resize(steps);
+            for (std::size_t i = 0; i < steps; i++)
+            {
+                const double t = static_cast<double>(i * strides[v] % steps) / (steps - 1);
+                columns[v][i] = std::min(box[v].lo + (box[v].hi - box[v].lo) * t, box[v].hi);
+            }
+        }
+        const interval bounds = evaluateInterval(exact, {box[0], box[1], box[2]});
+        evaluateBatch(exact, {columns[0], columns[1], columns[2]}, output);
+        report.comparisons++;
+        for (std::size_t i = 0; i < steps; i++)
+        {
+            const double value = output[i];
+            if (std::isnan(value) || (!bounds.isEmpty() && (bounds.contains(value) || (std::isinf(value) && bounds.partial))))
+            {
+                continue;
+            }
+            report.add("evaluateInterval", expression,
+                describe("x = %.17g, y = %.17g, z = %.17g da %.17g, fuera de [%.17g, %.17g] (cajas x [%g, %g], y [%g, %g], z [%g, %g])",
+                    columns[0][i], columns[1][i], columns[2][i], value, bounds.lo, bounds.hi, box[0].lo, box[0].hi, box[1].lo,
+                    box[1].hi, box[2].lo, box[2].hi));
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Los valores de evaluateDerivative deben ser los de evaluateBatch en double, con cada tabla y respecto a cada variable.
+ *
+ * La versión sin tabla evalúa en double aunque el programa pida Single o
+ * Fast, así que se compara con evaluateBatch del mismo programa en Double.
+ */
+void compareDerivatives(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    const variableInputs inputs = sampleInputs();
+    bytecodeProgram exact = program;
+    exact.precision = evaluationPrecision::Double;
+    std::vector<double> expected(sampleCount);
+    std::vector<double> values(sampleCount);
+    std::vector<double> derivatives(sampleCount);
+    const char* const variables[] = {"x", "y", "z"};
+
+    std::vector<const kernelTable*> tables = {&scalarKernels()};
+    for (simdLevel level : vectorLevels)
+    {
+        if (const kernelTable* kernels = kernelsFor(level))
+        {
+            tables.push_back(kernels);
+        }
+    }
+    for (std::size_t variable = 0; variable < variableRegisterCount; variable++)
+    {
+        for (const kernelTable* kernels : tables)
+        {
+            evaluateBatch(exact, inputs, expected, *kernels);
+            evaluateDerivative(exact, inputs, variable, values, derivatives, *kernels);
+            compareColumns(std::string("evaluateDerivative/") + kernels->name + "/d" + variables[variable], expression, values, expected,
+                report);
+        }
+        evaluateBatch(exact, inputs, expected);
+        evaluateDerivative(program, inputs, variable, values, derivatives);
+        compareColumns(std::string("evaluateDerivative/d") + variables[variable], expression, values, expected, report);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Tabulación
+// ---------------------------------------------------------------------------
+
+/// Intervalo de las tablas de prueba: cruza el cero y sus muestras no son enteras.
+constexpr sampleRange tableRange{-7.3, 11.9, sampleCount};
+
+/**
+ * @brief Tabla de referencia: evaluateBatch en double sobre las x del intervalo.
+ */
+functionTable expectedTable(const bytecodeProgram& program, const sampleRange& range) {
+    bytecodeProgram exact = program;
+    exact.precision = evaluationPrecision::Double;
+    functionTable table;
+    table.x.resize(range.count);
+    table.y.resize(range.count);
+    for (std::size_t i = 0; i < range.count; i++)
+    {
+        table.x[i] = range.at(i);
+    }
+    evaluateBatch(exact, {table.x}, table.y);
+    return table;
+}
+
+/**
+ * @brief Primera posición en la que dos columnas difieren bit a bit (los NaN coinciden), o su tamaño si no difieren.
+ */
+std::size_t firstMismatch(std::span<const double> actual, std::span<const double> expected) {
+    for (std::size_t i = 0; i < actual.size(); i++)
+    {
+        if (!sameBits(actual[i], expected[i]) && !(std::isnan(actual[i]) && std::isnan(expected[i])))
+        {
+            return i;
+        }
+    }
+    return actual.size();
+}
+
+/**
+ * @brief Compara una tabla con la de referencia, columna por columna.
+ */
+void compareTable(std::string_view path, std::string_view expression, const functionTable& actual, const functionTable& expected,
+    differentialReport& report) {
+    report.comparisons++;
+    if (actual.x.size() != expected.x.size() || actual.y.size() != expected.y.size())
+    {
+        report.add(path, expression, describe("%zu filas en lugar de %zu", actual.y.size(), expected.y.size()));
+        return;
+    }
+    std::size_t row = firstMismatch(actual.x, expected.x);
+    if (row < expected.x.size())
+    {
+        report.add(path, expression, describe("fila %zu: x = %.17g en lugar de %.17g", row, actual.x[row], expected.x[row]));
+        return;
+    }
+    row = firstMismatch(actual.y, expected.y);
+    if (row < expected.y.size())
+    {
+        report.add(path, expression, describe("fila %zu (x = %.17g): %.17g en lugar de %.17g", row, expected.x[row], actual.y[row],
+            expected.y[row]));
+    }
+}
+
+/**
+ * @brief Lee una tabla CSV tal como la escribe writeTable.
+ *
+ * @throws std::runtime_error Si falta la cabecera o alguna fila no tiene dos números.
+ */
+functionTable readCSV(std::string_view text) {
+    constexpr std::string_view header = "x,y\n";
+    if (text.substr(0, header.size()) != header)
+    {
+        throw std::runtime_error("sin cabecera \"x,y\"");
+    }
+    functionTable table;
+    const char* cursor = text.data() + header.size();
+    const char* end = text.data() + text.size();
+    while (cursor < end)
+    {
+        double values[2];
+        for (int c = 0; c < 2; c++)
+        {
+            const std::from_chars_result parsed = std::from_chars(cursor, end, values[c]);
+            if (parsed.ec != std::errc() || parsed.ptr == end || *parsed.ptr != (c == 0 ? ',' : '\n'))
+            {
+                throw std::runtime_error(describe("fila %zu mal formada", table.x.size()));
+            }
+            cursor = parsed.ptr + 1;
+        }
+        table.x.push_back(values[0]);
+        table.y.push_back(values[1]);
+    }
+    return table;
+}
+
+/**
+ * @brief Lee una tabla binaria (column_file.hpp) con las columnas x e y.
+ *
+ * @throws std::runtime_error Si la cabecera no es válida o no coincide con el tamaño de los datos.
+ */
+functionTable readBinary(std::string_view bytes) {
+    if (bytes.size() < columnFileHeaderSize)
+    {
+        throw std::runtime_error("archivo más corto que la cabecera");
+    }
+    const columnFileHeader header = decodeColumnHeader(
+        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(bytes.data()), columnFileHeaderSize));
+    if (header.columnCount != 2 || header.name(0) != "x" || header.name(1) != "y" || header.fileSize() != bytes.size())
+    {
+        throw std::runtime_error("la cabecera no describe las columnas x e y de los datos");
+    }
+    functionTable table;
+    table.x.resize(header.rowCount);
+    table.y.resize(header.rowCount);
+    // Las columnas están en little-endian, igual que los double de las máquinas donde corre el arnés.
+    std::memcpy(table.x.data(), bytes.data() + header.columnOffset(0), table.x.size() * sizeof(double));
+    std::memcpy(table.y.data(), bytes.data() + header.columnOffset(1), table.y.size() * sizeof(double));
+    return table;
+}
+
+/**
+ * @brief Escribe la tabla de f(x) en cada formato, la vuelve a leer y la compara con evaluateBatch en double.
+ */
+void compareTableWriter(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    const functionTable expected = expectedTable(program, tableRange);
+    for (tableFormat format : {tableFormat::CSV, tableFormat::Binary})
+    {
+        const std::string path = format == tableFormat::CSV ? "writeTable/csv" : "writeTable/binary";
+        std::ostringstream out(std::ios::binary);
+        functionTable actual;
+        const std::string error = thrownMessage([&] {
+            writeTable(program, tableRange, format, out);
+            actual = format == tableFormat::CSV ? readCSV(out.str()) : readBinary(out.str());
+        });
+        if (!error.empty())
+        {
+            report.comparisons++;
+            report.add(path, expression, error);
+            continue;
+        }
+        compareTable(path, expression, actual, expected, report);
+    }
+}
+
+/**
+ * @brief Contenido completo de un archivo, o vacío si no se puede leer.
+ */
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Cantidad de entradas de un directorio (para detectar temporales olvidados).
+ */
+std::size_t entryCount(const std::filesystem::path& directory) {
+    return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()));
+}
+
+/**
+ * @brief evaluateColumnFile: el resultado coincide con evaluateBatch y una ejecución fallida no toca la salida.
+ *
+ * Falla una vez antes de crear el temporal (falta la columna y) y otra al
+ * renombrarlo (outputPath es un directorio no vacío); en ambos casos la
+ * salida anterior debe quedar igual y el directorio sin archivos de más.
+ */
+void checkColumnFileFailures(differentialReport& report) {
+#if defined(__unix__) || defined(__APPLE__)
+    std::string pattern = (std::filesystem::temp_directory_path() / "plotsys-differential-XXXXXX").string();
+    if (mkdtemp(pattern.data()) == nullptr)
+    {
+        report.add("evaluateColumnFile", pattern, "no se pudo crear el directorio de prueba");
+        return;
+    }
+    const std::filesystem::path directory = pattern;
+    const std::string inputPath = (directory / "input.cols").string();
+    const std::string outputPath = (directory / "output.cols").string();
+    const std::filesystem::path busy = directory / "busy";
+    const bytecodeProgram program = compileExpression("sin(x) * x - 3");
+    const functionTable expected = expectedTable(program, tableRange);
+    {
+        const std::string_view names[] = {"x"};
+        mappedColumnFile input(inputPath, makeColumnHeader(names, tableRange.count));
+        std::copy(expected.x.begin(), expected.x.end(), input.writableColumn(0).begin());
+        input.sync();
+    }
+    const std::string previous = "salida anterior";
+    std::ofstream(outputPath, std::ios::binary) << previous;
+    std::filesystem::create_directory(busy);
+    std::ofstream(busy / "keep") << previous;
+    const std::size_t entries = entryCount(directory);
+
+    const std::pair<const char*, std::string> failures[] = {
+        {"falta la columna y", outputPath},
+        {"el destino es un directorio no vacío", busy.string()},
+    };
+    for (std::size_t k = 0; k < std::size(failures); k++)
+    {
+        const bytecodeProgram failing = compileExpression(k == 0 ? "x + y" : "sin(x) * x - 3");
+        const std::string error = thrownMessage([&] { evaluateColumnFile(failing, inputPath, failures[k].second); });
+        report.comparisons++;
+        if (error.empty())
+        {
+            report.add("evaluateColumnFile", failures[k].first, "no informó el error");
+        }
+        else if (readFile(outputPath) != previous || readFile(busy / "keep") != previous)
+        {
+            report.add("evaluateColumnFile", failures[k].first, "la ejecución fallida modificó la salida anterior");
+        }
+        else if (entryCount(directory) != entries)
+        {
+            report.add("evaluateColumnFile", failures[k].first, "quedó un archivo temporal en el directorio");
+        }
+    }
+
+    const std::string error = thrownMessage([&] {
+        evaluateColumnFile(program, inputPath, outputPath);
+        const mappedColumnFile output(outputPath);
+        std::span<const double> values = output.column(0);
+        compareTable("evaluateColumnFile", "sin(x) * x - 3", {expected.x, std::vector<double>(values.begin(), values.end())}, expected,
+            report);
+    });
+    report.comparisons++;
+    if (!error.empty())
+    {
+        report.add("evaluateColumnFile", "sin(x) * x - 3", error);
+    }
+    else if (entryCount(directory) != entries)
+    {
+        report.add("evaluateColumnFile", "sin(x) * x - 3", "quedó un archivo temporal en el directorio");
+    }
+    std::filesystem::remove_all(directory);
+#else
+    (void)report;
+#endif
+}
+
+/**
+ * @brief Raíces y extremos de sin y tan en [0, 10], con ambas versiones de findCriticalPoints.
+ *
+ * sin tiene raíces en k pi, máximos en pi/2 y 5 pi/2 y un mínimo en 3 pi/2.
+ * tan tiene las mismas raíces y ningún extremo, y sus cambios de signo en
+ * los polos (pi/2 + k pi) no deben aparecer como raíces. La versión para
+ * muchas funciones debe dar exactamente lo mismo que cada llamada suelta.
+ */
+void checkCriticalPoints(differentialReport& report) {
+    struct expectedCase {
+        const char* expression;
+        std::vector<criticalPoint> points; // value no se compara
+    };
+    const expectedCase cases[] = {
+        {"sin(x)", {{0.0, 0.0, criticalKind::Root}, {pi / 2, 0.0, criticalKind::Maximum}, {pi, 0.0, criticalKind::Root},
+            {3 * pi / 2, 0.0, criticalKind::Minimum}, {2 * pi, 0.0, criticalKind::Root}, {5 * pi / 2, 0.0, criticalKind::Maximum},
+            {3 * pi, 0.0, criticalKind::Root}}},
+        {"tan(x)", {{0.0, 0.0, criticalKind::Root}, {pi, 0.0, criticalKind::Root}, {2 * pi, 0.0, criticalKind::Root},
+            {3 * pi, 0.0, criticalKind::Root}}},
+    };
+    constexpr double start = 0.0;
+    constexpr double end = 10.0;
+
+    std::vector<bytecodeProgram> programs;
+    std::vector<std::vector<criticalPoint>> single;
+    for (const expectedCase& test : cases)
+    {
+        programs.push_back(compileExpression(test.expression));
+        single.push_back(findCriticalPoints(programs.back(), start, end));
+        const std::vector<criticalPoint>& found = single.back();
+        report.comparisons++;
+        if (found.size() != test.points.size())
+        {
+            report.add("findCriticalPoints", test.expression, describe("%zu puntos en lugar de %zu", found.size(), test.points.size()));
+            continue;
+        }
+        for (std::size_t k = 0; k < found.size(); k++)
+        {
+            const criticalPoint& want = test.points[k];
+            const double allowed = 8 * std::numeric_limits<double>::epsilon() * std::max(1.0, std::fabs(want.x));
+            if (found[k].kind != want.kind || !(std::fabs(found[k].x - want.x) <= allowed))
+            {
+                report.add("findCriticalPoints", test.expression, describe("punto %zu: tipo %d en x = %.17g en lugar de tipo %d en %.17g", k,
+                    static_cast<int>(found[k].kind), found[k].x, static_cast<int>(want.kind), want.x));
+                break;
+            }
+        }
+    }
+
+    const std::vector<std::vector<criticalPoint>> batched = findCriticalPoints(std::span<const bytecodeProgram>(programs), start, end);
+    for (std::size_t p = 0; p < programs.size(); p++)
+    {
+        report.comparisons++;
+        const bool same = batched[p].size() == single[p].size()
+            && std::equal(single[p].begin(), single[p].end(), batched[p].begin(), [](const criticalPoint& a, const criticalPoint& b) {
+                   return a.kind == b.kind && sameBits(a.x, b.x) && sameBits(a.value, b.value);
+               });
+        if (!same)
+        {
+            report.add("findCriticalPoints/batch", cases[p].expression, "no coincide con la búsqueda de la función sola");
+        }
+    }
+}
+
+/**
+ * @brief sweepParameter contra evaluateBatch de cada cuadro por separado, en double.
+ *
+ * El parámetro es y (o z si el programa usa z): su parte se eleva y se
+ * evalúa una vez para todos los cuadros, así que cada cuadro debe dar bit a
+ * bit lo mismo que el programa entero con el parámetro como columna fija.
+ * La cantidad de cuadros no es múltiplo de ningún ancho de registro.
+ */
+void compareSweep(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    static const double parameters[] = {-2.5, 0.0, 0.75, 1.0, 3.0, -0.125, 40.0, 1e-3, -1e3, 2.0, pi, -pi / 2, 0.5};
+    const sampleRange range{-7.3, 11.9, 97};
+    const std::size_t parameter = program.usesVariable(2) ? 2 : 1;
+    bytecodeProgram exact = program;
+    exact.precision = evaluationPrecision::Double;
+
+    std::vector<double> output(std::size(parameters) * range.count);
+    const std::string error = thrownMessage([&] { sweepParameter(exact, parameter, parameters, range, output); });
+    report.comparisons++;
+    if (!error.empty())
+    {
+        report.add("sweepParameter", expression, error);
+        return;
+    }
+
+    std::vector<double> xs(range.count);
+    for (std::size_t i = 0; i < range.count; i++)
+    {
+        xs[i] = range.at(i);
+    }
+    std::vector<double> column(range.count);
+    std::vector<double> expected(range.count);
+    for (std::size_t frame = 0; frame < std::size(parameters); frame++)
+    {
+        std::fill(column.begin(), column.end(), parameters[frame]);
+        variableInputs inputs;
+        inputs.x = xs;
+        (parameter == 1 ? inputs.y : inputs.z) = column;
+        evaluateBatch(exact, inputs, expected);
+        const std::span<const double> actual = std::span<const double>(output).subspan(frame * range.count, range.count);
+        const std::size_t row = firstMismatch(actual, expected);
+        report.comparisons++;
+        if (row < range.count)
+        {
+            report.add("sweepParameter", expression, describe("cuadro %zu (%c = %.17g), x = %.17g: %.17g en lugar de %.17g", frame,
+                parameter == 1 ? 'y' : 'z', parameters[frame], xs[row], actual[row], expected[row]));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Mínimo y máximo de las muestras recorriéndolas una por una (los NaN no cuentan).
+ */
+sampleEnvelope bruteEnvelope(std::span<const double> values) {
+    sampleEnvelope result{std::nan(""), std::nan("")};
+    for (double value : values)
+    {
+        if (std::isnan(value))
+        {
+            continue;
+        }
+        result.lo = std::isnan(result.lo) ? value : std::min(result.lo, value);
+        result.hi = std::isnan(result.hi) ? value : std::max(result.hi, value);
+    }
+    return result;
+}
+
+bool sameEnvelope(const sampleEnvelope& a, const sampleEnvelope& b) {
+    auto same = [](double p, double q) { return p == q || (std::isnan(p) && std::isnan(q)); };
+    return same(a.lo, b.lo) && same(a.hi, b.hi);
+}
+
+/**
+ * @brief Consulta rangos al azar de las primeras pyramid.size() muestras y los compara con el recorrido directo.
+ *
+ * Con la columna, la envolvente debe ser la exacta; sin ella, la de los
+ * bloques del nivel 0 que tocan el rango, completos.
+ */
+void compareEnvelopes(std::string_view path, std::string_view expression, const lodPyramid& pyramid, std::span<const double> column,
+    std::minstd_rand& random, differentialReport& report) {
+    const std::size_t size = pyramid.size();
+    const std::span<const double> values = column.first(size);
+    for (int query = 0; query < 24; query++)
+    {
+        // Rangos de todos los tamaños: dentro de un bloque, cruzando bordes y casi completos.
+        const std::size_t length = 1 + random() % (query % 3 == 0 ? size : std::min<std::size_t>(size, 3 * lodBaseBucket));
+        const std::size_t first = random() % (size - length + 1);
+        const std::size_t last = first + length;
+
+        const sampleEnvelope exact = bruteEnvelope(values.subspan(first, length));
+        const std::size_t outerFirst = first / lodBaseBucket * lodBaseBucket;
+        const std::size_t outerLast = std::min(size, (last + lodBaseBucket - 1) / lodBaseBucket * lodBaseBucket);
+        const sampleEnvelope outer = bruteEnvelope(values.subspan(outerFirst, outerLast - outerFirst));
+        const sampleEnvelope withValues = pyramid.envelope(first, last, values);
+        const sampleEnvelope withoutValues = pyramid.envelope(first, last);
+        report.comparisons++;
+        if (!sameEnvelope(withValues, exact) || !sameEnvelope(withoutValues, outer))
+        {
+            report.add(path, expression, describe("[%zu, %zu) de %zu: [%.17g, %.17g] y sin columna [%.17g, %.17g], en lugar de [%.17g, %.17g] y [%.17g, %.17g]",
+                first, last, size, withValues.lo, withValues.hi, withoutValues.lo, withoutValues.hi, exact.lo, exact.hi, outer.lo, outer.hi));
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Envolventes de lodPyramid contra el mínimo y máximo directos, construida de una vez y por partes.
+ *
+ * Las partes tienen tamaños que caen a un lado y otro de los bordes de
+ * bloque, y se consulta después de cada una.
+ */
+void compareLodPyramid(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    constexpr sampleRange lodRange{-7.3, 11.9, 4999}; // Cinco niveles, el último bloque incompleto
+    const std::vector<double> values = expectedTable(program, lodRange).y;
+    std::minstd_rand random(static_cast<std::minstd_rand::result_type>(std::hash<std::string_view>()(expression)));
+
+    lodPyramid whole;
+    whole.append(values);
+    compareEnvelopes("lodPyramid", expression, whole, values, random, report);
+
+    static const std::size_t parts[] = {1, 63, 64, 65, 200, 1, 1024, 127};
+    lodPyramid pieces;
+    std::size_t appended = 0;
+    for (std::size_t k = 0; appended < values.size(); k++)
+    {
+        const std::size_t count = std::min(k < std::size(parts) ? parts[k] : 1500, values.size() - appended);
+        pieces.append(std::span<const double>(values).subspan(appended, count));
+        appended += count;
+        compareEnvelopes("lodPyramid/append", expression, pieces, values, random, report);
+    }
+}
+
+} // namespace
+
+void differentialReport::add(std::string_view path, std::string_view expression, std::string detail) {
+    const std::size_t seen = ++counts[std::string(path)];
+    if (seen <= examplesPerPath)
+    {
+        examples.push_back({std::string(path), std::string(expression), std::move(detail)});
+    }
+}
+
+void compareLexers(std::string_view expression, differentialReport& report) {
+    report.inputs++;
+    for (errorPolicy policy : {errorPolicy::CollectAll, errorPolicy::StopAtFirst})
+    {
+        const char* suffix = policy == errorPolicy::CollectAll ? "" : "/StopAtFirst";
+        const referenceLexResult expected = referenceTokenizeChecked(expression, policy);
+
+        const lexResult checked = tokenizeChecked(expression, policy);
+        std::string difference = firstTokenDifference(expression, checked.tokens, expected.tokens);
+        if (difference.empty())
+        {
+            difference = firstDiagnosticDifference(checked.diagnostics, expected.diagnostics);
+        }
+        report.comparisons++;
+        if (!difference.empty())
+        {
+            report.add(std::string("tokenizeChecked") + suffix, expression, difference);
+        }
+
+        const packedLexResult packed = tokenizePacked(expression, policy);
+        difference = firstPackedDifference(expression, packed.tokens, expected.tokens);
+        if (difference.empty())
+        {
+            difference = firstDiagnosticDifference(packed.diagnostics, expected.diagnostics);
+        }
+        report.comparisons++;
+        if (!difference.empty())
+        {
+            report.add(std::string("tokenizePacked") + suffix, expression, difference);
+        }
+    }
+
+    // tokenizeView: los mismos tokens, o la misma excepción.
+    const referenceLexResult expected = referenceTokenizeChecked(expression);
+    const std::string source(expression);
+    std::vector<token> expectedTokens;
+    const std::string expectedError = thrownMessage([&] { expectedTokens = referenceTokenize(source); });
+    std::vector<tokenView> views;
+    const std::string viewError = thrownMessage([&] { views = tokenizeView(expression); });
+    report.comparisons++;
+    if (viewError != expectedError)
+    {
+        report.add("tokenizeView", expression, describe("excepción '%s' en lugar de '%s'", viewError.c_str(), expectedError.c_str()));
+    }
+    else if (viewError.empty())
+    {
+        const std::string difference = firstTokenDifference(expression, views, expected.tokens);
+        if (!difference.empty())
+        {
+            report.add("tokenizeView", expression, difference);
+        }
+    }
+
+    // tokenize: igual, con el texto copiado.
+    std::vector<token> tokens;
+    const std::string error = thrownMessage([&] { tokens = tokenize(source); });
+    report.comparisons++;
+    if (error != expectedError)
+    {
+        report.add("tokenize", expression, describe("excepción '%s' en lugar de '%s'", error.c_str(), expectedError.c_str()));
+        return;
+    }
+    if (tokens.size() != expectedTokens.size())
+    {
+        report.add("tokenize", expression, describe("%zu tokens en lugar de %zu", tokens.size(), expectedTokens.size()));
+        return;
+    }
+    for (std::size_t k = 0; k < tokens.size(); k++)
+    {
+        const token& got = tokens[k];
+        const token& want = expectedTokens[k];
+        if (got.type != want.type || got.value != want.value || got.arity != want.arity || !sameBits(got.number, want.number))
+        {
+            report.add("tokenize", expression, describe("token %zu: '%s' (tipo %d) en lugar de '%s' (tipo %d)", k,
+                got.value.c_str(), static_cast<int>(got.type), want.value.c_str(), static_cast<int>(want.type)));
+            return;
+        }
+    }
+}
+
+void compareIncremental(std::string_view before, std::string_view after, const textEdit& edit, differentialReport& report) {
+    const lexResult previous = tokenizeChecked(before);
+    const lexResult updated = tokenizeIncremental(previous, after, edit);
+    const referenceLexResult expected = referenceTokenizeChecked(after);
+    std::string difference = firstTokenDifference(after, updated.tokens, expected.tokens);
+    if (difference.empty())
+    {
+        difference = firstDiagnosticDifference(updated.diagnostics, expected.diagnostics);
+    }
+    report.comparisons++;
+    if (!difference.empty())
+    {
+        report.add("tokenizeIncremental", after, describe("tras editar en %zu (-%zu +%zu) '%.*s': %s", edit.offset, edit.removed,
+            edit.inserted, static_cast<int>(std::min<std::size_t>(before.size(), 200)), before.data(), difference.c_str()));
+        return;
+    }
+
+    // Deshacer la edición partiendo del resultado incremental.
+    const lexResult restored = tokenizeIncremental(updated, before, {edit.offset, edit.inserted, edit.removed});
+    const referenceLexResult original = referenceTokenizeChecked(before);
+    difference = firstTokenDifference(before, restored.tokens, original.tokens);
+    if (difference.empty())
+    {
+        difference = firstDiagnosticDifference(restored.diagnostics, original.diagnostics);
+    }
+    report.comparisons++;
+    if (!difference.empty())
+    {
+        report.add("tokenizeIncremental", before, describe("al deshacer la edición en %zu: %s", edit.offset, difference.c_str()));
+    }
+
+    // Una edición que borra más allá del final del texto anterior es un error.
+    const std::string error = thrownMessage([&] { tokenizeIncremental(previous, after, {before.size(), 1, 0}); });
+    report.comparisons++;
+    if (error.empty())
+    {
+        report.add("tokenizeIncremental", before, "acepta una edición que borra más allá del texto anterior");
+    }
+}
+
+void compareEvaluators(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    report.programs++;
+    compareDoubleKernels(expression, program, report);
+    compareFloatKernels(expression, program, report);
+    compareIntervals(expression, program, report);
+    compareDerivatives(expression, program, report);
+
+    // evaluateBatch con cada tabla: bloques, registros reutilizados y conversiones.
+    const variableInputs inputs = sampleInputs();
+    std::vector<double> output(sampleCount);
+    evaluateBatch(program, inputs, output, scalarKernels());
+    compareColumns("evaluateBatch/scalar", expression, output, runDirect<double>(program, scalarKernels()), report);
+    evaluateBatch(program, inputs, output, scalarFloatKernels());
+    compareColumns("evaluateBatch/scalar-float", expression, output, runDirect<float>(program, scalarFloatKernels()), report);
+    for (simdLevel level : vectorLevels)
+    {
+        if (const kernelTable* kernels = kernelsFor(level))
+        {
+            evaluateBatch(program, inputs, output, *kernels);
+            compareColumns(std::string("evaluateBatch/") + kernels->name, expression, output, runDirect<double>(program, *kernels), report);
+        }
+        for (bool relaxed : {false, true})
+        {
+            if (const floatKernelTable* kernels = floatKernelsFor(level, relaxed))
+            {
+                evaluateBatch(program, inputs, output, *kernels);
+                compareColumns(std::string("evaluateBatch/") + kernels->name, expression, output, runDirect<float>(program, *kernels), report);
+            }
+        }
+    }
+
+    // La tabla que elige cada precisión.
+    bytecodeProgram tier = program;
+    tier.precision = evaluationPrecision::Double;
+    evaluateBatch(tier, inputs, output);
+    const std::vector<double> interpreted = runDirect<double>(program, activeKernels());
+    compareColumns("evaluateBatch/Double", expression, output, interpreted, report);
+    tier.precision = evaluationPrecision::Single;
+    evaluateBatch(tier, inputs, output);
+    compareColumns("evaluateBatch/Single", expression, output, runDirect<float>(program, activeFloatKernels(false)), report);
+    tier.precision = evaluationPrecision::Fast;
+    evaluateBatch(tier, inputs, output);
+    compareColumns("evaluateBatch/Fast", expression, output, runDirect<float>(program, activeFloatKernels(true)), report);
+
+    // JIT: bit a bit igual que el intérprete, y nunca nativo fuera de Double.
+    const jitProgram native(program);
+    if (native.isNative())
+    {
+        native.evaluate(inputs, output);
+        compareColumns("jit", expression, output, interpreted, report);
+    }
+    report.comparisons++;
+    if (jitProgram(tier).isNative())
+    {
+        report.add("jit/Fast", expression, "se generó código nativo para un programa en float");
+    }
+
+    // Constantes pasadas en la llamada: lo mismo que un programa que ya las tenga.
+    if (!program.constants.empty())
+    {
+        bytecodeProgram exact = program;
+        exact.precision = evaluationPrecision::Double;
+        bytecodeProgram replaced = exact;
+        for (double& constant : replaced.constants)
+        {
+            constant = constant * 0.5 + 1.0;
+        }
+        variableInputs overridden = inputs;
+        overridden.constants = replaced.constants;
+        std::vector<double> expected(sampleCount);
+        evaluateBatch(replaced, inputs, expected);
+        evaluateBatch(exact, overridden, output);
+        compareColumns("evaluateBatch/constants", expression, output, expected, report);
+        const jitProgram exactNative(exact);
+        if (exactNative.isNative())
+        {
+            exactNative.evaluate(overridden, output);
+            compareColumns("jit/constants", expression, output, expected, report);
+        }
+        std::vector<double> derivatives(sampleCount);
+        std::vector<double> expectedDerivatives(sampleCount);
+        evaluateDerivative(replaced, inputs, 0, expected, expectedDerivatives);
+        evaluateDerivative(exact, overridden, 0, output, derivatives);
+        compareColumns("evaluateDerivative/constants", expression, output, expected, report);
+        compareColumns("evaluateDerivative/constants/dx", expression, derivatives, expectedDerivatives, report);
+    }
+}
+
+void compareTabulation(std::string_view expression, const bytecodeProgram& program, differentialReport& report) {
+    if (!program.usesVariable(1) || !program.usesVariable(2))
+    {
+        compareSweep(expression, program, report);
+    }
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        return;
+    }
+    compareTableWriter(expression, program, report);
+    compareLodPyramid(expression, program, report);
+}
+
+void checkTabulationCases(differentialReport& report) {
+    checkColumnFileFailures(report);
+    checkCriticalPoints(report);
+}
+
+void compareInput(std::string_view input, differentialReport& report) {
+    compareLexers(input, report);
+    if (input.size() >= 3)
+    {
+        // El tercio central se inserta en el texto sin él y después se vuelve a borrar.
+        const std::size_t third = input.size() / 3;
+        std::string shorter(input.substr(0, third));
+        shorter += input.substr(2 * third);
+        compareIncremental(shorter, input, {third, 0, third}, report);
+    }
+
+    const compiledExpression compiled = compileExpressionChecked(input);
+    if (compiled.ok())
+    {
+        compareEvaluators(input, *compiled.program, report);
+        compareTabulation(input, *compiled.program, report);
+    }
+}
@@ -0,0 +1,137 @@
+/**
+ * @file differential.hpp
+ * @brief Comparación de los caminos rápidos del lexer y del evaluador con sus referencias.
+ *
+ * Cada función recibe una entrada, la pasa por la referencia y por cada
+ * camino optimizado, y anota en un differentialReport lo que no coincide:
+ * - Lexer: tokenizeChecked (con ambas políticas), tokenizePacked, tokenizeView
+ *   y tokenize contra el lexer original (reference_lexer.hpp), y
+ *   tokenizeIncremental contra el análisis completo del texto editado. Tipos,
+ *   posiciones, aridades, diagnósticos y mensajes deben ser idénticos, y los
+ *   valores numéricos iguales bit a bit.
+ * - Núcleos: cada tabla SIMD se compara con scalarKernels() y cada tabla en
+ *   float con scalarFloatKernels() instrucción por instrucción, dando a las
+ *   dos las mismas entradas (los registros de la ejecución de referencia),
+ *   así el error de una operación no se confunde con su propagación. El
+ *   margen de cada operación es el que documenta kernels.hpp.
+ * - Evaluador: evaluateBatch con cada tabla, la tabla que elige cada
+ *   precisión y el JIT deben dar bit a bit lo mismo que una ejecución directa
+ *   del programa sobre la columna entera con esa misma tabla.
+ * - Intervalos: evaluateInterval() sobre una caja debe contener el valor de f
+ *   en cada punto muestreado de ella.
+ * - Derivadas: los valores de evaluateDerivative deben ser los de
+ *   evaluateBatch en double con la misma tabla.
+ * - Tabulación: las tablas que escribe writeTable, leídas de vuelta, y cada
+ *   cuadro de sweepParameter deben coincidir bit a bit con evaluateBatch en
+ *   double; las envolventes de lodPyramid, con el mínimo y el máximo
+ *   recorriendo las muestras. evaluateColumnFile no debe tocar la salida
+ *   anterior cuando falla, y findCriticalPoints debe encontrar las raíces y
+ *   extremos de sin y tan sin confundirlos con polos.
+ */
+#ifndef DIFFERENTIAL_HPP
+#define DIFFERENTIAL_HPP
+
+#include "evaluator/program.hpp"
+#include "parser/lexer.hpp"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct divergence
+ * @brief Un resultado de un camino rápido que no coincide con la referencia.
+ */
+struct divergence {
+    std::string path; ///< Camino comparado (ej: "tokenizePacked", "avx2/sin", "jit")
+    std::string expression; ///< Entrada que lo muestra
+    std::string detail; ///< Qué valor difiere y cómo
+};
+
+/**
+ * @struct differentialReport
+ * @brief Resultados acumulados de las comparaciones.
+ */
+struct differentialReport {
+    std::size_t inputs = 0; ///< Entradas analizadas por el lexer
+    std::size_t programs = 0; ///< Entradas que compilaron y se evaluaron
+    std::size_t comparisons = 0; ///< Listas de tokens y columnas de valores comparadas
+    std::map<std::string, std::size_t> counts; ///< Divergencias por camino
+    std::vector<divergence> examples; ///< Primeras divergencias de cada camino
+
+    /// Divergencias que se guardan completas por camino; del resto solo se cuentan.
+    static constexpr std::size_t examplesPerPath = 4;
+
+    /**
+     * @brief Anota una divergencia.
+     */
+    void add(std::string_view path, std::string_view expression, std::string detail);
+
+    /**
+     * @brief Indica si no hubo ninguna divergencia.
+     */
+    bool ok() const { return counts.empty(); }
+};
+
+/**
+ * @brief Compara todas las variantes del lexer con el lexer de referencia.
+ */
+void compareLexers(std::string_view expression, differentialReport& report);
+
+/**
+ * @brief Compara el reanálisis incremental con el análisis completo del texto editado.
+ *
+ * @param before Texto antes de la edición.
+ * @param after Texto después de la edición.
+ * @param edit Edición que lleva de before a after.
+ * @param report Donde se anotan las divergencias.
+ */
+void compareIncremental(std::string_view before, std::string_view after, const textEdit& edit, differentialReport& report);
+
+/**
+ * @brief Compara núcleos, tablas, JIT e intervalos sobre un programa, con columnas de prueba fijas.
+ *
+ * Las columnas mezclan valores comunes con ceros con signo, infinitos, NaN,
+ * subnormales, múltiplos de pi/2 y valores enormes, y su tamaño no es
+ * múltiplo del bloque del evaluador ni de ningún ancho de registro.
+ *
+ * @param expression Texto del que salió el programa (solo para los informes).
+ * @param program Programa compilado.
+ * @param report Donde se anotan las divergencias.
+ */
+void compareEvaluators(std::string_view expression, const bytecodeProgram& program, differentialReport& report);
+
+/**
+ * @brief Compara tablas, pirámides y barridos de parámetro con evaluateBatch y con recorridos directos.
+ *
+ * Las tablas y las pirámides solo se construyen para programas de x; el
+ * barrido usa y (o z) como parámetro y se omite si el programa usa las dos.
+ *
+ * @param expression Texto del que salió el programa (solo para los informes).
+ * @param program Programa compilado.
+ * @param report Donde se anotan las divergencias.
+ */
+void compareTabulation(std::string_view expression, const bytecodeProgram& program, differentialReport& report);
+
+/**
+ * @brief Casos fijos de la tabulación que no dependen de una expresión al azar.
+ *
+ * evaluateColumnFile sobre archivos en un directorio temporal, incluidas
+ * ejecuciones que fallan y deben dejar la salida anterior intacta, y las
+ * raíces y extremos conocidos de sin y tan con findCriticalPoints.
+ *
+ * @param report Donde se anotan las divergencias.
+ */
+void checkTabulationCases(differentialReport& report);
+
+/**
+ * @brief Pasa una entrada arbitraria por todas las comparaciones.
+ *
+ * Es lo que ejecuta el objetivo de libFuzzer con cada entrada: el lexer
+ * sobre el texto, el reanálisis incremental tras insertar y borrar su tercio
+ * central, y, si la entrada compila, el evaluador y la tabulación.
+ */
+void compareInput(std::string_view input, differentialReport& report);
+
+#endif // DIFFERENTIAL_HPP
@@ -0,0 +1,416 @@
+/**
+ * @file differential_main.cpp
+ * @brief plotsys_differential: compara los caminos rápidos con sus referencias e informa divergencias y tiempos.
+ *
+ * Uso:
+ *   plotsys_differential [--count N] [--seed S]   expresiones al azar y derivadas del corpus
+ *   plotsys_differential archivo...                reproduce entradas (por ejemplo, las que guardó libFuzzer)
+ *
+ * Devuelve 1 si algún camino no coincide con su referencia.
+ */
+
+#include "differential.hpp"
+#include "reference_lexer.hpp"
+#include "bench/corpus.hpp"
+#include "evaluator/compiler.hpp"
+#include "evaluator/evaluator.hpp"
+#include "evaluator/jit.hpp"
+#include "evaluator/kernels.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @class expressionGenerator
+ * @brief Expresiones al azar: válidas según la gramática o con ruido para el lexer.
+ */
+class expressionGenerator {
+public:
+    explicit expressionGenerator(std::uint64_t seed) : random(seed) {}
+
+    /**
+     * @brief Expresión válida de a lo sumo depth niveles, con un '=' de vez en cuando.
+     */
+    std::string expression(int depth) {
+        std::string result = term(depth);
+        if (chance(0.05))
+        {
+            result += spacing() + "=" + spacing() + term(depth);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Aplica entre una y tres mutaciones de bytes: inserciones, borrados y duplicados.
+     */
+    std::string mutate(std::string text) {
+        const int mutations = 1 + pick(3);
+        for (int m = 0; m < mutations; m++)
+        {
+            const std::size_t at = text.empty() ? 0 : pick(text.size() + 1);
+            switch (pick(4))
+            {
+            case 0:
+                text.insert(at, 1, noiseCharacter());
+                break;
+            case 1:
+                text.erase(at, 1 + pick(4));
+                break;
+            case 2:
+                if (at < text.size())
+                {
+                    text.insert(pick(text.size() + 1), text.substr(at, 1 + pick(8)));
+                }
+                break;
+            default:
+                text.insert(at, snippet());
+                break;
+            }
+        }
+        return text;
+    }
+
+    /**
+     * @brief Edición al azar sobre text: borra hasta 5 caracteres e inserta un fragmento.
+     */
+    textEdit edit(const std::string& text, std::string& edited) {
+        const std::size_t offset = pick(text.size() + 1);
+        const std::size_t removed = std::min<std::size_t>(pick(6), text.size() - offset);
+        const std::string inserted = chance(0.3) ? std::string() : snippet();
+        edited = text.substr(0, offset) + inserted + text.substr(offset + removed);
+        return {offset, removed, inserted.size()};
+    }
+
+private:
+    std::mt19937_64 random;
+
+    std::size_t pick(std::size_t count) { return static_cast<std::size_t>(random() % count); }
+    bool chance(double p) { return std::uniform_real_distribution<double>(0.0, 1.0)(random) < p; }
+
+    template <std::size_t N>
+    const char* choose(const char* const (&options)[N]) { return options[pick(N)]; }
+
+    std::string spacing() {
+        static const char* const spaces[] = {"", "", "", " ", " ", "  ", "\t", "\n"};
+        return choose(spaces);
+    }
+
+    std::string number() {
+        static const char* const literals[] = {
+            "0", "1", "2", "7", "10", "0.5", ".5", "3.25", "1e-7", "2E+3", "6e22", "1e23", "1.5e-300",
+            "9007199254740993", "0.1000000000000000055511151231257827", "1e400", "4.9e-324", "1e-400",
+            "123456789012345678901234567890", "0.000001", "22", "1e22", "3.0e0",
+        };
+        if (chance(0.6))
+        {
+            return choose(literals);
+        }
+        std::string digits = std::to_string(random() % 100000);
+        if (chance(0.5))
+        {
+            digits += "." + std::to_string(random() % 1000000);
+        }
+        if (chance(0.3))
+        {
+            digits += (chance(0.5) ? "e-" : "e") + std::to_string(random() % 40);
+        }
+        return digits;
+    }
+
+    std::string atom() {
+        static const char* const names[] = {"x", "y", "z", "x", "pi", "e"};
+        return chance(0.4) ? number() : std::string(choose(names));
+    }
+
+    std::string term(int depth) {
+        if (depth <= 0 || chance(0.25))
+        {
+            return atom();
+        }
+        static const char* const unary[] = {
+            "sin", "cos", "tan", "sec", "csc", "cot", "asin", "acos", "atan", "asec", "acsc", "acot",
+            "log", "ln", "sqrt", "abs",
+        };
+        static const char* const binary[] = {"log_base", "nroot"};
+        static const char* const operators[] = {"+", "-", "*", "/", "^", "%"};
+        switch (pick(5))
+        {
+        case 0:
+            return std::string(choose(unary)) + spacing() + "(" + term(depth - 1) + ")";
+        case 1:
+            return std::string(choose(binary)) + "(" + term(depth - 1) + "," + spacing() + term(depth - 1) + ")";
+        case 2:
+            return "-" + term(depth - 1);
+        case 3:
+            return "(" + term(depth - 1) + spacing() + choose(operators) + spacing() + term(depth - 1) + ")";
+        default:
+            return term(depth - 1) + spacing() + choose(operators) + spacing() + term(depth - 1);
+        }
+    }
+
+    char noiseCharacter() {
+        static const char alphabet[] = "0123456789..eeEE++--*/^%=(),_ \t xyzpisncotalgbqrd@#\x80\xff";
+        return alphabet[pick(sizeof(alphabet) - 1)];
+    }
+
+    std::string snippet() {
+        static const char* const pieces[] = {"1.2.3", "2e", "3e+", "1e2e3", "e-", ".", "sin(", ")", ",", "log_", "foo", "__", "pi"};
+        switch (pick(3))
+        {
+        case 0:
+            return number();
+        case 1:
+            return choose(pieces);
+        default:
+            return std::string(1, noiseCharacter()) + atom();
+        }
+    }
+};
+
+/**
+ * @brief Milisegundos del mejor de tres pases de f.
+ */
+template <class Function>
+double bestOfThree(Function f) {
+    double best = 0.0;
+    for (int pass = 0; pass < 3; pass++)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = pass == 0 ? elapsed : std::min(best, elapsed);
+    }
+    return best;
+}
+
+void printTiming(const char* path, double milliseconds, double reference) {
+    std::printf("  %-28s %10.3f ms   x%.2f\n", path, milliseconds, reference / milliseconds);
+}
+
+/**
+ * @brief Tiempos de cada camino del lexer frente a la referencia, sobre las mismas entradas.
+ */
+void timeLexers(const std::vector<std::string>& inputs, const std::vector<std::string>& edited, const std::vector<textEdit>& edits) {
+    std::size_t sink = 0;
+    const double reference = bestOfThree([&] {
+        for (const std::string& input : inputs)
+        {
+            sink += referenceTokenizeChecked(input).tokens.size();
+        }
+    });
+    printTiming("lexer/reference", reference, reference);
+    printTiming("lexer/tokenizeChecked", bestOfThree([&] {
+        for (const std::string& input : inputs)
+        {
+            sink += tokenizeChecked(input).tokens.size();
+        }
+    }), reference);
+    printTiming("lexer/tokenizePacked", bestOfThree([&] {
+        for (const std::string& input : inputs)
+        {
+            sink += tokenizePacked(input).tokens.size();
+        }
+    }), reference);
+
+    // Reanálisis tras editar: completo con el lexer de referencia frente a incremental.
+    std::vector<lexResult> previous;
+    previous.reserve(inputs.size());
+    for (const std::string& input : inputs)
+    {
+        previous.push_back(tokenizeChecked(input));
+    }
+    const double relex = bestOfThree([&] {
+        for (const std::string& text : edited)
+        {
+            sink += referenceTokenizeChecked(text).tokens.size();
+        }
+    });
+    printTiming("lexer/relex-reference", relex, relex);
+    printTiming("lexer/tokenizeIncremental", bestOfThree([&] {
+        for (std::size_t k = 0; k < edited.size(); k++)
+        {
+            sink += tokenizeIncremental(previous[k], edited[k], edits[k]).tokens.size();
+        }
+    }), relex);
+    if (sink == 0)
+    {
+        std::printf("  (sin tokens)\n");
+    }
+}
+
+/**
+ * @brief Tiempos del evaluador con cada tabla, precisión y el JIT, frente a la tabla escalar.
+ */
+void timeEvaluators(const std::vector<bytecodeProgram>& programs) {
+    const std::size_t count = 4096;
+    std::vector<double> xs(count), ys(count), zs(count), output(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        xs[i] = -10.0 + 20.0 * static_cast<double>(i) / count;
+        ys[i] = 0.5 + static_cast<double>(i % 97) / 16.0;
+        zs[i] = -3.0 + static_cast<double>(i % 61) / 10.0;
+    }
+    const variableInputs inputs{xs, ys, zs};
+    auto run = [&](auto&& evaluate) {
+        return bestOfThree([&] {
+            for (const bytecodeProgram& program : programs)
+            {
+                evaluate(program);
+            }
+        });
+    };
+
+    const double reference = run([&](const bytecodeProgram& p) { evaluateBatch(p, inputs, output, scalarKernels()); });
+    printTiming("evaluate/scalar", reference, reference);
+    for (simdLevel level : {simdLevel::SSE2, simdLevel::AVX2, simdLevel::AVX512, simdLevel::NEON})
+    {
+        if (const kernelTable* kernels = kernelsFor(level))
+        {
+            const std::string path = std::string("evaluate/") + kernels->name;
+            printTiming(path.c_str(), run([&](const bytecodeProgram& p) { evaluateBatch(p, inputs, output, *kernels); }), reference);
+        }
+    }
+    for (bool relaxed : {false, true})
+    {
+        const floatKernelTable& kernels = activeFloatKernels(relaxed);
+        const std::string path = std::string("evaluate/") + kernels.name;
+        printTiming(path.c_str(), run([&](const bytecodeProgram& p) { evaluateBatch(p, inputs, output, kernels); }), reference);
+    }
+
+    std::vector<jitProgram> natives;
+    natives.reserve(programs.size());
+    for (const bytecodeProgram& program : programs)
+    {
+        natives.emplace_back(program);
+    }
+    if (!jitProgram::available())
+    {
+        std::printf("  %-28s no disponible (compilar con -DPLOTSYS_JIT=ON)\n", "evaluate/jit");
+        return;
+    }
+    printTiming("evaluate/jit", bestOfThree([&] {
+        for (const jitProgram& native : natives)
+        {
+            native.evaluate(inputs, output);
+        }
+    }), reference);
+}
+
+void printReport(const differentialReport& report) {
+    std::printf("%zu entradas, %zu programas evaluados, %zu comparaciones\n", report.inputs, report.programs, report.comparisons);
+    if (report.ok())
+    {
+        std::printf("Sin divergencias.\n");
+        return;
+    }
+    std::printf("Divergencias:\n");
+    for (const auto& [path, count] : report.counts)
+    {
+        std::printf("  %-28s %zu\n", path.c_str(), count);
+    }
+    for (const divergence& found : report.examples)
+    {
+        std::printf("[%s] \"%.*s\"\n    %s\n", found.path.c_str(), static_cast<int>(std::min<std::size_t>(found.expression.size(), 300)),
+            found.expression.data(), found.detail.c_str());
+    }
+}
+
+/// Entradas que mostraron errores ya corregidos; se comparan siempre.
+const char* const regressionInputs[] = {
+    "x%0.1 - 0.01 + 0*y", // fmod que cruza un período por redondeo en interval.cpp
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::size_t count = 2000;
+    std::uint64_t seed = 1;
+    std::vector<std::string> files;
+    for (int a = 1; a < argc; a++)
+    {
+        if (std::strcmp(argv[a], "--count") == 0 && a + 1 < argc)
+        {
+            count = std::strtoull(argv[++a], nullptr, 10);
+        }
+        else if (std::strcmp(argv[a], "--seed") == 0 && a + 1 < argc)
+        {
+            seed = std::strtoull(argv[++a], nullptr, 10);
+        }
+        else
+        {
+            files.emplace_back(argv[a]);
+        }
+    }
+
+    differentialReport report;
+    if (!files.empty())
+    {
+        for (const std::string& file : files)
+        {
+            std::ifstream in(file, std::ios::binary);
+            if (!in)
+            {
+                std::fprintf(stderr, "No se pudo abrir %s\n", file.c_str());
+                return 2;
+            }
+            const std::string input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            compareInput(input, report);
+        }
+        printReport(report);
+        return report.ok() ? 0 : 1;
+    }
+
+    // Entradas: casos que ya fallaron, expresiones al azar, el corpus de los benchmarks, y versiones mutadas.
+    expressionGenerator generator(seed);
+    std::vector<std::string> inputs(std::begin(regressionInputs), std::end(regressionInputs));
+    for (std::size_t k = 0; k < count; k++)
+    {
+        inputs.push_back(generator.expression(1 + static_cast<int>(k % 6)));
+    }
+    const std::size_t corpusSize = std::max<std::size_t>(count / 40, 1);
+    for (corpusKind kind : {corpusKind::Short, corpusKind::Long, corpusKind::NumberHeavy, corpusKind::IdentifierHeavy})
+    {
+        for (std::string& expression : makeCorpus(kind, corpusSize))
+        {
+            inputs.push_back(std::move(expression));
+        }
+    }
+    const std::size_t clean = inputs.size();
+    for (std::size_t k = 0; k < clean; k++)
+    {
+        inputs.push_back(generator.mutate(inputs[k]));
+    }
+
+    std::vector<std::string> edited(inputs.size());
+    std::vector<textEdit> edits;
+    std::vector<bytecodeProgram> programs;
+    for (std::size_t k = 0; k < inputs.size(); k++)
+    {
+        compareLexers(inputs[k], report);
+        edits.push_back(generator.edit(inputs[k], edited[k]));
+        compareIncremental(inputs[k], edited[k], edits[k], report);
+        compiledExpression compiled = compileExpressionChecked(inputs[k]);
+        if (compiled.ok())
+        {
+            compareEvaluators(inputs[k], *compiled.program, report);
+            compareTabulation(inputs[k], *compiled.program, report);
+            programs.push_back(std::move(*compiled.program));
+        }
+    }
+    checkTabulationCases(report);
+    printReport(report);
+
+    std::printf("Tiempos (mejor de tres pases; xN = veces más rápido que la referencia):\n");
+    timeLexers(inputs, edited, edits);
+    timeEvaluators(programs);
+    return report.ok() ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file fuzz_expression.cpp
+ * @brief Objetivo de libFuzzer: cada entrada pasa por todas las comparaciones diferenciales.
+ *
+ * Con Clang y -DPLOTSYS_BUILD_FUZZERS=ON se enlaza con libFuzzer, ASan y
+ * UBSan; por ejemplo:
+ *   ./plotsys_fuzz -dict=../fuzz/expression.dict corpus/
+ * Cualquier divergencia aborta con su detalle, así libFuzzer guarda la
+ * entrada; plotsys_differential <archivo> la reproduce.
+ */
+
+#include "differential.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    // Las expresiones reales son cortas; las entradas enormes solo hacen lento cada intento.
+    if (size > 4096)
+    {
+        return 0;
+    }
+    const std::string_view input(reinterpret_cast<const char*>(data), size);
+    differentialReport report;
+    compareInput(input, report);
+    if (!report.ok())
+    {
+        for (const divergence& found : report.examples)
+        {
+            std::fprintf(stderr, "[%s] %s\n", found.path.c_str(), found.detail.c_str());
+        }
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file reference_lexer.cpp
+ * @brief Copia del lexer original, usada como oráculo por las pruebas diferenciales.
+ *
+ * Respecto del original solo cambia que los caracteres se pasan a <cctype>
+ * como unsigned char (con un char negativo el original tenía comportamiento
+ * indefinido), que los números se convierten con strtod (el original dejaba
+ * en 0 los que desbordan, como 1e400) y que no se registran métricas.
+ */
+
+#include "reference_lexer.hpp"
+#include "parser/keywords.hpp"
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace {
+
+/// <cctype> en el locale "C", sin comportamiento indefinido con char negativos.
+bool isDigit(char character) { return std::isdigit(static_cast<unsigned char>(character)) != 0; }
+bool isAlpha(char character) { return std::isalpha(static_cast<unsigned char>(character)) != 0; }
+bool isSpace(char character) { return std::isspace(static_cast<unsigned char>(character)) != 0; }
+
+/**
+ * @brief Indica si un carácter puede continuar un número mal formado.
+ *
+ * Se usa para recuperarse de un error: el fragmento inválido abarca todo
+ * lo que "parece" número, y el análisis sigue después de él.
+ */
+bool continuesNumber(std::string_view expression, size_t i) {
+    char character = expression[i];
+    if (isDigit(character) || character == '.' || character == 'e' || character == 'E')
+    {
+        return true;
+    }
+    return (character == '+' || character == '-') && i > 0 && (expression[i - 1] == 'e' || expression[i - 1] == 'E');
+}
+
+/**
+ * @brief Analiza el token que empieza en la posición i, que no es un espacio.
+ *
+ * El resultado solo depende del texto a partir de i, lo que permite
+ * reanudar el análisis en cualquier inicio de token (ver tokenizeIncremental).
+ *
+ * @param expression Expresión matemática a analizar.
+ * @param i Posición del primer carácter del token.
+ * @param tokens Lista donde se agrega el token generado.
+ * @param diagnostics Lista donde se agrega el error, si lo hay.
+ * @return size_t Posición siguiente al token.
+ *
+ * Las listas pueden usar cualquier asignador (std::vector o std::pmr::vector).
+ */
+template <typename tokenList, typename diagnosticList>
+size_t scanToken(std::string_view expression, size_t i, tokenList& tokens, diagnosticList& diagnostics) {
+    char character = expression[i];
+
+    //TOKEN: NÚMERO (incluyendo notación científica como 1.23e-4)
+    if (isDigit(character) || (character == '.' && i + 1 < expression.length() && isDigit(expression[i + 1])))
+    {
+        size_t start = i;
+        i++;
+
+        bool seenDot = (character == '.'); // Marca si ya apareció un punto decimal
+        bool seenExp = false; // Marca si ya apareció un exponente 'e' o 'E'
+        bool malformed = false; // Marca si el número resultó inválido
+        diagnosticKind error = diagnosticKind::MultipleDecimalPoints;
+
+        while (i < expression.length())
+        {
+            char next = expression[i];
+
+            if (isDigit(next))
+            {
+                // Los dígitos forman parte del número; solo avanzamos.
+            }
+            else if (next == '.')
+            {   
+                // Solo se permite un punto decimal, y no puede venir después de un exponente
+                if (seenDot || seenExp)
+                {
+                    malformed = true;
+                    error = diagnosticKind::MultipleDecimalPoints;
+                    break;
+                }
+                seenDot = true;
+            }
+            else if (next == 'e' || next == 'E')
+            {
+                // El exponente cierra el número (ver más abajo), así que
+                // nunca se llega aquí con un exponente previo.
+                seenExp = true;
+                
+                // Validar el carácter después de 'e'
+                i++;
+                if (i >= expression.length())
+                {
+                    malformed = true;
+                    error = diagnosticKind::IncompleteExponent;
+                    break;
+                }
+
+                char signOrDigit = expression[i];
+                if (signOrDigit == '+' || signOrDigit == '-')
+                {
+                    i++;
+                    if (i >= expression.length() || !isDigit(expression[i]))
+                    {
+                        malformed = true;
+                        error = diagnosticKind::ExponentWithoutDigits;
+                        break;
+                    }
+                }
+                else if (!isDigit(signOrDigit))
+                {
+                    malformed = true;
+                    error = diagnosticKind::ExponentWithoutDigits;
+                    break;
+                }
+
+                // Leer los dígitos del exponente
+                while (i < expression.length() && isDigit(expression[i]))
+                {
+                    i++;
+                }
+
+                break; // Salimos porque el número ya terminó
+            }
+            else
+            {
+                break; // Ya no es parte del número
+            }
+
+            i++;
+        }
+
+        if (malformed)
+        {
+            // Consumimos el resto del número inválido para reportarlo completo.
+            while (i < expression.length() && continuesNumber(expression, i))
+            {
+                i++;
+            }
+            std::string_view text = expression.substr(start, i - start);
+            diagnostics.push_back({error, start, text.size()});
+            tokens.push_back({tokenType::Invalid, 0, text, start, 0.0});
+            return i;
+        }
+
+        std::string_view text = expression.substr(start, i - start);
+        const double number = std::strtod(std::string(text).c_str(), nullptr);
+        tokens.push_back({tokenType::Number, 0, text, start, number});
+        return i;
+    }
+
+    //TOKEN: FUNCIONES, CONSTANTES O VARIABLES
+    if (isAlpha(character))
+    {
+        size_t start = i;
+        // Leemos toda la secuencia de letras (por ejemplo: sin, ln, pi).
+        // Después de la primera letra se admite '_' para nombres como log_base.
+        while (i + 1 < expression.length() && (isAlpha(expression[i + 1]) || expression[i + 1] == '_'))
+        {
+            i++;
+        }
+        std::string_view text = expression.substr(start, i - start + 1);
+        const keyword* entry = findKeyword(text);
+
+        if (entry == nullptr)
+        {
+            diagnostics.push_back({diagnosticKind::UnknownIdentifier, start, text.size()});
+            tokens.push_back({tokenType::Invalid, 0, text, start, 0.0});
+        }
+        else
+        {
+            tokens.push_back({entry->type, entry->arity, text, start, entry->value});
+        }
+        return i + 1;
+    }
+
+    //TOKEN: PARÉNTESIS
+    if (character == '('){
+        tokens.push_back({tokenType::LeftParen, 0, expression.substr(i, 1), i, 0.0});
+    }
+    else if (character == ')'){
+        tokens.push_back({tokenType::RightParen, 0, expression.substr(i, 1), i, 0.0});
+    }
+
+    //TOKEN: SEPARADOR DE ARGUMENTOS
+    else if (character == ','){
+        tokens.push_back({tokenType::Comma, 0, expression.substr(i, 1), i, 0.0});
+    }
+
+    //TOKEN: OPERADORES
+    else if (std::string_view("+-*/^%=").find(character) != std::string_view::npos) {
+        tokens.push_back({tokenType::Operator, 0, expression.substr(i, 1), i, 0.0});
+    }
+
+    //TOKEN: DESCONOCIDO O NO SOPORTADO
+    else {
+        diagnostics.push_back({diagnosticKind::UnexpectedCharacter, i, 1});
+        tokens.push_back({tokenType::Invalid, 0, expression.substr(i, 1), i, 0.0});
+    }
+    return i + 1;
+}
+
+/**
+ * @brief Núcleo del analizador léxico compartido por todas las entradas públicas.
+ *
+ * Nunca lanza excepciones por errores léxicos: los registra en diagnostics y,
+ * según la política, se detiene o continúa con el resto de la expresión.
+ *
+ * @param expression Expresión matemática a analizar.
+ * @param policy Detenerse en el primer error o recopilarlos todos.
+ * @param tokens Lista donde se agregan los tokens generados.
+ * @param diagnostics Lista donde se agregan los errores encontrados.
+ */
+template <typename tokenList, typename diagnosticList>
+void scanExpression(std::string_view expression, errorPolicy policy, tokenList& tokens, diagnosticList& diagnostics) {
+    tokens.reserve(expression.length() / 2 + 1);
+
+    // Las funciones, constantes y variables reconocidas viven en keywordTable
+    // (keywords.hpp), que se construye una sola vez en tiempo de compilación.
+
+    // Bucle principal que recorre la expresión token por token.
+    size_t i = 0;
+    while (i < expression.length()) {
+        if (policy == errorPolicy::StopAtFirst && !diagnostics.empty())
+        {
+            break;
+        }
+
+        // Ignorar espacios en blanco.
+        if (isSpace(expression[i]))
+        {
+            i++;
+            continue;
+        }
+
+        i = scanToken(expression, i, tokens, diagnostics);
+    }
+}
+
+} // namespace
+
+referenceLexResult referenceTokenizeChecked(std::string_view expression, errorPolicy policy) {
+    referenceLexResult result;
+    scanExpression(expression, policy, result.tokens, result.diagnostics);
+    return result;
+}
+
+std::vector<token> referenceTokenize(const std::string& expression) {
+    const referenceLexResult lexed = referenceTokenizeChecked(expression);
+    for (const diagnostic& found : lexed.diagnostics)
+    {
+        if (isMalformedNumber(found.kind))
+        {
+            throw std::runtime_error(diagnosticMessage(found.kind));
+        }
+    }
+    std::vector<token> tokens;
+    for (const tokenView& view : lexed.tokens)
+    {
+        tokens.emplace_back(view.type, std::string(view.text), view.arity, view.number);
+    }
+    return tokens;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file reference_lexer.hpp
+ * @brief Lexer de referencia para las pruebas diferenciales.
+ *
+ * Es el analizador carácter por carácter que había antes de la clasificación
+ * por tabla, el salto de rachas con SSE2 y la conversión rápida de números
+ * (parser/char_class.hpp, parser/number_parse.hpp): <cctype> en el locale
+ * "C" y strtod. No se usa fuera de fuzz/; su única tarea es ser
+ * fácil de leer y dar el resultado correcto.
+ */
+#ifndef REFERENCE_LEXER_HPP
+#define REFERENCE_LEXER_HPP
+
+#include "parser/lexer.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct referenceLexResult
+ * @brief Tokens y diagnósticos del lexer de referencia.
+ */
+struct referenceLexResult {
+    std::vector<tokenView> tokens; ///< Tokens generados, apuntando a la expresión
+    std::vector<diagnostic> diagnostics; ///< Errores encontrados, en orden de aparición
+};
+
+/**
+ * @brief Analiza la expresión como lo hacía el lexer original.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @param policy Detenerse en el primer error o continuar hasta el final.
+ * @return referenceLexResult Tokens y diagnósticos; mismo contrato que tokenizeChecked().
+ */
+referenceLexResult referenceTokenizeChecked(std::string_view expression, errorPolicy policy = errorPolicy::CollectAll);
+
+/**
+ * @brief Versión de referencia de tokenize().
+ *
+ * @param expression Expresión matemática.
+ * @return std::vector<token> Tokens con su texto copiado.
+ * @throws std::runtime_error Con el mensaje del primer número mal formado, si lo hay.
+ */
+std::vector<token> referenceTokenize(const std::string& expression);
+
+#endif // REFERENCE_LEXER_HPP
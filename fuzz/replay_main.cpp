@@ -0,0 +1,33 @@
+/**
+ * @file replay_main.cpp
+ * @brief main() para plotsys_fuzz cuando el compilador no trae libFuzzer.
+ *
+ * Pasa cada archivo recibido por LLVMFuzzerTestOneInput, igual que libFuzzer
+ * al reproducir una entrada, de modo que el objetivo se compila y se puede
+ * probar con cualquier compilador.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+int main(int argc, char** argv) {
+    for (int a = 1; a < argc; a++)
+    {
+        std::ifstream in(argv[a], std::ios::binary);
+        if (!in)
+        {
+            std::fprintf(stderr, "No se pudo abrir %s\n", argv[a]);
+            return 2;
+        }
+        const std::string input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+    }
+    std::printf("%d entradas sin divergencias\n", argc - 1);
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file ast.hpp
+ * @brief Representación plana (basada en índices) del árbol sintáctico.
+ *
+ * En lugar de un árbol de nodos en el heap unidos por punteros, el parser
+ * produce un arreglo contiguo de nodos en postorden: los operandos de un nodo
+ * siempre aparecen antes que él, y se referencian por su índice.
+ */
+#ifndef AST_HPP
+#define AST_HPP
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @enum opCode
+ * @brief Operación que representa cada nodo del árbol.
+ */
+enum class opCode : std::uint8_t {
+    Constant, ///< Valor numérico fijo (números y constantes como pi)
+    Variable, ///< Variable x, y o z
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    Power,
+    Negate,
+    Sin,
+    Cos,
+    Tan,
+    Sec,
+    Csc,
+    Cot,
+    Asin,
+    Acos,
+    Atan,
+    Asec,
+    Acsc,
+    Acot,
+    Log, ///< Logaritmo base 10
+    Ln, ///< Logaritmo natural
+    LogBase, ///< log_base(b, x): logaritmo de x en base b
+    Sqrt,
+    Abs,
+    Nroot, ///< nroot(n, x): raíz n-ésima de x
+};
+
+/**
+ * @brief Cantidad de operandos que consume una operación (0, 1 o 2).
+ */
+constexpr int operandCount(opCode op) {
+    switch (op)
+    {
+    case opCode::Constant:
+    case opCode::Variable:
+        return 0;
+    case opCode::Add:
+    case opCode::Subtract:
+    case opCode::Multiply:
+    case opCode::Divide:
+    case opCode::Modulo:
+    case opCode::Power:
+    case opCode::LogBase:
+    case opCode::Nroot:
+        return 2;
+    default:
+        return 1;
+    }
+}
+
+/**
+ * @struct astNode
+ * @brief Un nodo del árbol plano.
+ */
+struct astNode {
+    opCode op; ///< Operación del nodo
+    std::uint8_t variable; ///< Índice de la variable (0 = x, 1 = y, 2 = z); solo Variable
+    std::uint32_t left; ///< Índice del primer operando (si lo hay)
+    std::uint32_t right; ///< Índice del segundo operando (si lo hay)
+    double value; ///< Valor del nodo; solo Constant
+};
+
+/**
+ * @struct syntaxTree
+ * @brief Árbol sintáctico de una expresión, almacenado en postorden.
+ *
+ * Tras optimize() un mismo nodo puede ser operando de varios (subexpresiones
+ * comunes); los operandos siguen precediendo siempre a su nodo.
+ *
+ * Los nodos usan std::pmr para poder vivir en la misma arena que los tokens.
+ */
+struct syntaxTree {
+    std::pmr::vector<astNode> nodes; ///< Nodos en postorden; los operandos preceden a su nodo
+    std::uint32_t root = 0; ///< Índice del nodo raíz (el último en construirse)
+};
+
+#endif // AST_HPP
@@ -0,0 +1,183 @@
+/**
+ * @file char_class.hpp
+ * @brief Clasificación de caracteres por tabla y salto de rachas con SIMD para el lexer.
+ *
+ * std::isdigit, std::isalpha y std::isspace dependen del locale y pasan por
+ * una llamada por carácter (además de no admitir char negativos). Aquí cada
+ * carácter se clasifica con una sola lectura de una tabla de 256 entradas,
+ * construida en tiempo de compilación con la clasificación del locale "C",
+ * que es la que veía el lexer.
+ *
+ * Las rachas de espacios, dígitos y letras se saltan de 16 en 16 bytes con
+ * SSE2 (siempre disponible en x86-64); en otras arquitecturas se recorren
+ * con la tabla.
+ */
+#ifndef CHAR_CLASS_HPP
+#define CHAR_CLASS_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define PLOTSYS_LEXER_SSE2
+#include <emmintrin.h>
+#endif
+
+/**
+ * @enum charClass
+ * @brief Clases de un carácter; un carácter puede tener varias.
+ */
+enum charClass : std::uint8_t {
+    SpaceClass = 1 << 0, ///< ' ', '\t', '\n', '\v', '\f', '\r'
+    DigitClass = 1 << 1, ///< '0' a '9'
+    AlphaClass = 1 << 2, ///< 'a' a 'z' y 'A' a 'Z'
+    IdentifierClass = 1 << 3, ///< Letras y '_': lo que puede seguir a la primera letra de un nombre
+    OperatorClass = 1 << 4, ///< + - * / ^ % =
+    NumberTailClass = 1 << 5, ///< Dígitos, '.', 'e' y 'E': lo que continúa un número mal formado
+};
+
+/**
+ * @brief Construye la tabla de clases en tiempo de compilación.
+ */
+constexpr std::array<std::uint8_t, 256> makeCharClassTable() {
+    std::array<std::uint8_t, 256> table{};
+    for (unsigned c : {' ', '\t', '\n', '\v', '\f', '\r'})
+    {
+        table[c] |= SpaceClass;
+    }
+    for (unsigned c = '0'; c <= '9'; c++)
+    {
+        table[c] |= DigitClass | NumberTailClass;
+    }
+    for (unsigned c = 'a'; c <= 'z'; c++)
+    {
+        table[c] |= AlphaClass | IdentifierClass;
+        table[c - 'a' + 'A'] |= AlphaClass | IdentifierClass;
+    }
+    table['_'] |= IdentifierClass;
+    for (unsigned c : {'+', '-', '*', '/', '^', '%', '='})
+    {
+        table[c] |= OperatorClass;
+    }
+    for (unsigned c : {'.', 'e', 'E'})
+    {
+        table[c] |= NumberTailClass;
+    }
+    return table;
+}
+
+/// Clases de cada uno de los 256 valores de un byte.
+inline constexpr std::array<std::uint8_t, 256> charClassTable = makeCharClassTable();
+
+/**
+ * @brief Indica si el carácter pertenece a alguna de las clases dadas.
+ */
+constexpr bool hasClass(char character, std::uint8_t classes) {
+    return (charClassTable[static_cast<unsigned char>(character)] & classes) != 0;
+}
+
+constexpr bool isSpace(char character) { return hasClass(character, SpaceClass); }
+constexpr bool isDigit(char character) { return hasClass(character, DigitClass); }
+constexpr bool isAlpha(char character) { return hasClass(character, AlphaClass); }
+
+namespace charRuns {
+
+#ifdef PLOTSYS_LEXER_SSE2
+
+/**
+ * @brief Máscara de bytes de [low, high], para rangos dentro de ASCII.
+ *
+ * Los bytes 0x80 a 0xFF son negativos en la comparación con signo y nunca
+ * caen dentro del rango.
+ */
+inline __m128i inRange(__m128i bytes, char low, char high) {
+    return _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(static_cast<char>(low - 1))),
+        _mm_cmplt_epi8(bytes, _mm_set1_epi8(static_cast<char>(high + 1))));
+}
+
+inline __m128i spaceMask(__m128i bytes) {
+    return _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')), inRange(bytes, '\t', '\r'));
+}
+
+inline __m128i digitMask(__m128i bytes) {
+    return inRange(bytes, '0', '9');
+}
+
+inline __m128i identifierMask(__m128i bytes) {
+    // Con el bit 0x20 encendido, las mayúsculas pasan a minúsculas y nada más cae en 'a'..'z'.
+    const __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+    return _mm_or_si128(inRange(lower, 'a', 'z'), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('_')));
+}
+
+/**
+ * @brief Avanza de 16 en 16 bytes mientras todos sean de la clase; devuelve dónde se detuvo.
+ */
+template <__m128i (*mask)(__m128i)>
+inline std::size_t skipBlocks(std::string_view text, std::size_t i) {
+    while (i + 16 <= text.size())
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + i));
+        const unsigned inside = static_cast<unsigned>(_mm_movemask_epi8(mask(bytes)));
+        if (inside != 0xFFFF)
+        {
+            return i + static_cast<std::size_t>(std::countr_zero(~inside));
+        }
+        i += 16;
+    }
+    return i;
+}
+
+#endif // PLOTSYS_LEXER_SSE2
+
+/**
+ * @brief Avanza con la tabla mientras el carácter pertenezca a la clase.
+ */
+inline std::size_t skipScalar(std::string_view text, std::size_t i, std::uint8_t classes) {
+    while (i < text.size() && hasClass(text[i], classes))
+    {
+        i++;
+    }
+    return i;
+}
+
+} // namespace charRuns
+
+/**
+ * @brief Primera posición desde i que no es un espacio (o el final).
+ */
+inline std::size_t skipSpaces(std::string_view text, std::size_t i) {
+    // La racha típica es de un solo espacio: se mira con la tabla antes de cargar 16 bytes.
+    if (i < text.size() && !isSpace(text[i]))
+    {
+        return i;
+    }
+#ifdef PLOTSYS_LEXER_SSE2
+    i = charRuns::skipBlocks<charRuns::spaceMask>(text, i);
+#endif
+    return charRuns::skipScalar(text, i, SpaceClass);
+}
+
+/**
+ * @brief Primera posición desde i que no es un dígito (o el final).
+ */
+inline std::size_t skipDigits(std::string_view text, std::size_t i) {
+#ifdef PLOTSYS_LEXER_SSE2
+    i = charRuns::skipBlocks<charRuns::digitMask>(text, i);
+#endif
+    return charRuns::skipScalar(text, i, DigitClass);
+}
+
+/**
+ * @brief Primera posición desde i que no es una letra ni '_' (o el final).
+ */
+inline std::size_t skipIdentifier(std::string_view text, std::size_t i) {
+#ifdef PLOTSYS_LEXER_SSE2
+    i = charRuns::skipBlocks<charRuns::identifierMask>(text, i);
+#endif
+    return charRuns::skipScalar(text, i, IdentifierClass);
+}
+
+#endif // CHAR_CLASS_HPP
@@ -0,0 +1,47 @@
+/**
+ * @file diagnostic.cpp
+ * @brief Mensajes legibles para cada tipo de diagnóstico.
+ */
+
+#include "diagnostic.hpp"
+
+const char* diagnosticMessage(diagnosticKind kind) {
+    switch (kind)
+    {
+    case diagnosticKind::MultipleDecimalPoints:
+        return "[Lexer Error]: Número mal formado con múltiples puntos decimales.";
+    case diagnosticKind::IncompleteExponent:
+        return "[Lexer Error]: Exponente inválido o incompleto.";
+    case diagnosticKind::ExponentWithoutDigits:
+        return "[Lexer Error]: Exponente debe ir seguido de un dígito.";
+    case diagnosticKind::UnknownIdentifier:
+        return "[Lexer Error]: Identificador desconocido.";
+    case diagnosticKind::UnexpectedCharacter:
+        return "[Lexer Error]: Carácter no soportado.";
+    case diagnosticKind::EmptyExpression:
+        return "[Parser Error]: La expresión está vacía.";
+    case diagnosticKind::ExpectedOperand:
+        return "[Parser Error]: Se esperaba un número, variable, función o paréntesis.";
+    case diagnosticKind::ExpectedOperator:
+        return "[Parser Error]: Se esperaba un operador entre dos operandos.";
+    case diagnosticKind::ExpectedLeftParen:
+        return "[Parser Error]: Una función debe ir seguida de '('.";
+    case diagnosticKind::ExpectedRightParen:
+        return "[Parser Error]: Falta cerrar un paréntesis.";
+    case diagnosticKind::UnexpectedRightParen:
+        return "[Parser Error]: Paréntesis de cierre sin apertura.";
+    case diagnosticKind::WrongArgumentCount:
+        return "[Parser Error]: Cantidad incorrecta de argumentos para la función.";
+    case diagnosticKind::MisplacedComma:
+        return "[Parser Error]: Coma fuera de los argumentos de una función.";
+    case diagnosticKind::MisplacedEquals:
+        return "[Parser Error]: '=' solo puede aparecer una vez y fuera de paréntesis.";
+    case diagnosticKind::NestingTooDeep:
+        return "[Parser Error]: La expresión está anidada demasiado profundo.";
+    }
+    return "[Lexer Error]: Error desconocido.";
+}
+
+bool isMalformedNumber(diagnosticKind kind) {
+    return kind == diagnosticKind::MultipleDecimalPoints || kind == diagnosticKind::IncompleteExponent || kind == diagnosticKind::ExponentWithoutDigits;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file diagnostic.hpp
+ * @brief Diagnósticos léxicos y sintácticos con su ubicación dentro de la expresión.
+ *
+ * Permiten informar errores sin lanzar excepciones, de modo que quien llama
+ * pueda resaltar todas las posiciones con error en una sola pasada.
+ */
+#ifndef DIAGNOSTIC_HPP
+#define DIAGNOSTIC_HPP
+
+#include <cstddef>
+
+/**
+ * @enum diagnosticKind
+ * @brief Tipos de error que pueden detectar el analizador léxico y el parser.
+ */
+enum class diagnosticKind {
+    MultipleDecimalPoints, ///< Número con más de un punto decimal (ej: 1.2.3)
+    IncompleteExponent, ///< El número termina justo después de la 'e' (ej: 2e)
+    ExponentWithoutDigits, ///< Tras la 'e' (y su signo) no hay dígitos (ej: 2e+x)
+    UnknownIdentifier, ///< Secuencia de letras que no es función, constante ni variable
+    UnexpectedCharacter, ///< Carácter que no pertenece a ningún token
+    EmptyExpression, ///< La expresión no contiene ningún token
+    ExpectedOperand, ///< Falta un número, variable, función o paréntesis
+    ExpectedOperator, ///< Dos operandos seguidos sin operador entre ellos (ej: 2 x)
+    ExpectedLeftParen, ///< Una función no va seguida de '('
+    ExpectedRightParen, ///< Falta cerrar un paréntesis
+    UnexpectedRightParen, ///< Paréntesis de cierre sin su apertura
+    WrongArgumentCount, ///< La función recibió una cantidad de argumentos distinta a su aridad
+    MisplacedComma, ///< Coma fuera de la lista de argumentos de una función
+    MisplacedEquals, ///< '=' dentro de paréntesis o usado más de una vez
+    NestingTooDeep, ///< La expresión está anidada más allá del límite del parser
+};
+
+/**
+ * @struct diagnostic
+ * @brief Un error encontrado en la expresión junto con el fragmento que lo causa.
+ */
+struct diagnostic {
+    diagnosticKind kind; ///< Tipo de error
+    std::size_t offset; ///< Posición (en bytes) donde empieza el fragmento con error
+    std::size_t length; ///< Longitud (en bytes) del fragmento con error
+};
+
+/**
+ * @brief Devuelve el mensaje legible asociado a un tipo de diagnóstico.
+ *
+ * Los mensajes coinciden con los de las excepciones que lanza tokenize().
+ *
+ * @param kind Tipo de diagnóstico.
+ * @return const char* Mensaje con el prefijo del componente que lo generó.
+ */
+const char* diagnosticMessage(diagnosticKind kind);
+
+/**
+ * @brief Indica si un diagnóstico corresponde a un número mal formado.
+ *
+ * Son los únicos errores léxicos por los que tokenize() lanza excepción.
+ */
+bool isMalformedNumber(diagnosticKind kind);
+
+#endif // DIAGNOSTIC_HPP
@@ -0,0 +1,105 @@
+/**
+ * @file keywords.hpp
+ * @brief Tabla constante de palabras reservadas: funciones, constantes y variables.
+ *
+ * La tabla se construye en tiempo de compilación y se comparte entre todas las
+ * llamadas al lexer, en lugar de volver a crear conjuntos y mapas cada vez.
+ * Está ordenada por nombre para poder buscar con búsqueda binaria.
+ */
+#ifndef KEYWORDS_HPP
+#define KEYWORDS_HPP
+
+#include "token.hpp"
+#include "ast.hpp"
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @struct keyword
+ * @brief Una palabra reconocida por el lexer junto con sus atributos.
+ */
+struct keyword {
+    std::string_view name; ///< Texto exacto de la palabra
+    tokenType type; ///< Tipo de token que produce (Function, Constant o Variable)
+    int arity; ///< Cantidad de argumentos que espera (solo funciones)
+    double value; ///< Valor numérico (solo constantes)
+    opCode op; ///< Operación que genera en el árbol sintáctico
+};
+
+/**
+ * @brief Tabla de palabras reservadas, ordenada lexicográficamente por nombre.
+ *
+ * Las constantes usan una precisión similar a la de una calculadora científica.
+ */
+inline constexpr std::array<keyword, 23> keywordTable = {{
+    {"abs", tokenType::Function, 1, 0.0, opCode::Abs},
+    {"acos", tokenType::Function, 1, 0.0, opCode::Acos},
+    {"acot", tokenType::Function, 1, 0.0, opCode::Acot},
+    {"acsc", tokenType::Function, 1, 0.0, opCode::Acsc},
+    {"asec", tokenType::Function, 1, 0.0, opCode::Asec},
+    {"asin", tokenType::Function, 1, 0.0, opCode::Asin},
+    {"atan", tokenType::Function, 1, 0.0, opCode::Atan},
+    {"cos", tokenType::Function, 1, 0.0, opCode::Cos},
+    {"cot", tokenType::Function, 1, 0.0, opCode::Cot},
+    {"csc", tokenType::Function, 1, 0.0, opCode::Csc},
+    {"e", tokenType::Constant, 0, 2.718281828459045, opCode::Constant},
+    {"ln", tokenType::Function, 1, 0.0, opCode::Ln},
+    {"log", tokenType::Function, 1, 0.0, opCode::Log},
+    {"log_base", tokenType::Function, 2, 0.0, opCode::LogBase},
+    {"nroot", tokenType::Function, 2, 0.0, opCode::Nroot},
+    {"pi", tokenType::Constant, 0, 3.141592653589793, opCode::Constant},
+    {"sec", tokenType::Function, 1, 0.0, opCode::Sec},
+    {"sin", tokenType::Function, 1, 0.0, opCode::Sin},
+    {"sqrt", tokenType::Function, 1, 0.0, opCode::Sqrt},
+    {"tan", tokenType::Function, 1, 0.0, opCode::Tan},
+    {"x", tokenType::Variable, 0, 0.0, opCode::Variable},
+    {"y", tokenType::Variable, 0, 0.0, opCode::Variable},
+    {"z", tokenType::Variable, 0, 0.0, opCode::Variable},
+}};
+
+/**
+ * @brief Comprueba en tiempo de compilación que la tabla está ordenada.
+ */
+constexpr bool keywordTableIsSorted() {
+    for (std::size_t i = 1; i < keywordTable.size(); i++)
+    {
+        if (!(keywordTable[i - 1].name < keywordTable[i].name))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(keywordTableIsSorted(), "keywordTable debe estar ordenada por nombre");
+
+/**
+ * @brief Busca una palabra en la tabla mediante búsqueda binaria.
+ *
+ * @param name Texto a buscar.
+ * @return const keyword* Entrada encontrada o nullptr si no es una palabra reservada.
+ */
+constexpr const keyword* findKeyword(std::string_view name) {
+    std::size_t low = 0;
+    std::size_t high = keywordTable.size();
+    while (low < high)
+    {
+        std::size_t middle = low + (high - low) / 2;
+        if (keywordTable[middle].name < name)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    if (low < keywordTable.size() && keywordTable[low].name == name)
+    {
+        return &keywordTable[low];
+    }
+    return nullptr;
+}
+
+#endif // KEYWORDS_HPP
@@ -10,175 +10,416 @@
  * - Funciones trigonométricas y sus inversas
  * - Constantes matemáticas como pi y e
  * - Variables (x, y, z)
+ * - Funciones de dos argumentos separados por coma (ej: nroot(3, x))
  * - Notación científica (ej: 3.2e-5)
  * - Manejo de errores léxicos comunes
+ * - Tokens sin copia (tokenView) que apuntan a la expresión original
+ * - Reanálisis incremental tras una edición, reutilizando los tokens intactos
  * 
  * @author Sergio
  * @date 2025
  */
 
-#include "Lexer.hpp"
-#include <cctype>
-#include <unordered_set>
-#include <unordered_map>
-#include <sstream>
+#include "lexer.hpp"
+#include "char_class.hpp"
+#include "keywords.hpp"
+#include "number_parse.hpp"
+#include "../support/metrics.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
 
 /**
- * @brief Convierte una cadena de entrada en una lista de tokens.
- * 
- * @param expression Expresión matemática como cadena.
- * @return std::vector<Token> Lista de tokens generados.
+ * @brief Indica si un carácter puede continuar un número mal formado.
+ *
+ * Se usa para recuperarse de un error: el fragmento inválido abarca todo
+ * lo que "parece" número, y el análisis sigue después de él.
  */
-std::vector<token> tokenize(const std::string& expression) {
-    std::vector<token> tokens;
-    std::string current;
-
-    // Conjunto de funciones matemáticas reconocidas por el analizador léxico.
-    std::unordered_set<std::string> functions = {"sin", "cos", "tan", "sec", "csc", "cot", "asin", "acos", "atan", "asec", "acsc", "acot", "log", "ln", "log_base", "sqrt", "abs", "nroot", "^"};
-    
-    // Mapa que relaciona funciones con su aridad (cantidad de argumentos que esperan).
-    std::unordered_map<std::string, double> functionsArity = {
-        {"sin", 1}, {"cos", 1}, {"tan", 1}, {"sec", 1}, {"csc", 1}, {"cot", 1}, {"asin", 1}, {"acos", 1}, {"atan", 1}, {"asec", 1}, {"acsc", 1}, {"acot", 1}, {"log", 1}, {"ln", 1}, {"log_base", 2}, {"sqrt", 1}, {"abs", 1}, {"nroot", 2}, {"^", 2}
-    };
-    
-    // Constantes predefinidas con precisión razonable (similar a una calculadora científica).
-    std::unordered_map<std::string, double> constant = {
-        {"pi", 3.141592653589793}, {"e", 2.718281828459045}
-    };
+bool continuesNumber(std::string_view expression, size_t i) {
+    char character = expression[i];
+    if (hasClass(character, NumberTailClass))
+    {
+        return true;
+    }
+    return (character == '+' || character == '-') && i > 0 && (expression[i - 1] == 'e' || expression[i - 1] == 'E');
+}
 
-    // Variables válidas reconocidas por el sistema.
-    std::unordered_set<std::string> variables = {"x", "y", "z"};
+/**
+ * @brief Analiza el token que empieza en la posición i, que no es un espacio.
+ *
+ * El resultado solo depende del texto a partir de i, lo que permite
+ * reanudar el análisis en cualquier inicio de token (ver tokenizeIncremental).
+ *
+ * @param expression Expresión matemática a analizar.
+ * @param i Posición del primer carácter del token.
+ * @param tokens Lista donde se agrega el token generado.
+ * @param diagnostics Lista donde se agrega el error, si lo hay.
+ * @return size_t Posición siguiente al token.
+ *
+ * Las listas pueden usar cualquier asignador (std::vector o std::pmr::vector).
+ */
+template <typename tokenList, typename diagnosticList>
+size_t scanToken(std::string_view expression, size_t i, tokenList& tokens, diagnosticList& diagnostics) {
+    char character = expression[i];
 
-    // Bucle principal que recorre la expresión carácter por carácter.
-    for (size_t i = 0; i < expression.length(); i++) {
-        char character = expression[i];
+    //TOKEN: NÚMERO (incluyendo notación científica como 1.23e-4)
+    if (isDigit(character) || (character == '.' && i + 1 < expression.length() && isDigit(expression[i + 1])))
+    {
+        size_t start = i;
+        i++;
 
-        // Ignorar espacios en blanco.
-        if (std::isspace(character))
-        {
-            continue;
-        }
+        bool seenDot = (character == '.'); // Marca si ya apareció un punto decimal
+        bool seenExp = false; // Marca si ya apareció un exponente 'e' o 'E'
+        bool malformed = false; // Marca si el número resultó inválido
+        diagnosticKind error = diagnosticKind::MultipleDecimalPoints;
 
-        //TOKEN: NÚMERO (incluyendo notación científica como 1.23e-4)
-        if (std::isdigit(character) || (character == '.' && i + 1 < expression.length() && std::isdigit(expression[i + 1])))
+        while (i < expression.length())
         {
-            current = character;
-            i++;
-
-            bool seenDot = (character == '.'); // Marca si ya apareció un punto decimal
-            bool seenExp = false; // Marca si ya apareció un exponente 'e' o 'E'
-
-            while (i < expression.length())
+            // Los dígitos forman parte del número: se saltan de una vez.
+            i = skipDigits(expression, i);
+            if (i >= expression.length())
             {
-                char next = expression[i];
+                break;
+            }
+            char next = expression[i];
 
-                if (std::isdigit(next))
+            if (next == '.')
+            {   
+                // Solo se permite un punto decimal, y no puede venir después de un exponente
+                if (seenDot || seenExp)
                 {
-                    current += next;
+                    malformed = true;
+                    error = diagnosticKind::MultipleDecimalPoints;
+                    break;
                 }
-                else if (next == '.')
-                {   
-                    // Solo se permite un punto decimal, y no puede venir después de un exponente
-                    if (seenDot || seenExp)
-                    {
-                        throw std::runtime_error("[Lexer Error]: Número mal formado con múltiples puntos decimales.");
-                    }
-                    current += next;
-                    seenDot = true;
+                seenDot = true;
+            }
+            else if (next == 'e' || next == 'E')
+            {
+                // El exponente cierra el número (ver más abajo), así que
+                // nunca se llega aquí con un exponente previo.
+                seenExp = true;
+                
+                // Validar el carácter después de 'e'
+                i++;
+                if (i >= expression.length())
+                {
+                    malformed = true;
+                    error = diagnosticKind::IncompleteExponent;
+                    break;
                 }
-                else if (next == 'e' || next == 'E')
+
+                char signOrDigit = expression[i];
+                if (signOrDigit == '+' || signOrDigit == '-')
                 {
-                    if (seenExp)
-                    {
-                        throw std::runtime_error("[Lexer Error]: Número mal formado con múltiples exponentes.");
-                    }
-                    current += next;
-                    seenExp = true;
-                    
-                    // Validar el carácter después de 'e'
                     i++;
-                    if (i >= expression.length())
+                    if (i >= expression.length() || !isDigit(expression[i]))
                     {
-                        throw std::runtime_error("[Lexer Error]: Exponente inválido o incompleto.");
+                        malformed = true;
+                        error = diagnosticKind::ExponentWithoutDigits;
+                        break;
                     }
-
-                    char signOrDigit = expression[i];
-                    if (signOrDigit == '+' || signOrDigit == '-')
-                    {
-                        current += signOrDigit;
-                        i++;
-                        if (i >= expression.length() || !std::isdigit(expression[i]))
-                        {
-                            throw std::runtime_error("[Lexer Error]: Exponente debe ir seguido de un dígito.");
-                        }
-                    }
-                    else if (!std::isdigit(signOrDigit))
-                    {
-                        throw std::runtime_error("[Lexer Error]: Exponente debe ir seguido de un dígito.");
-                    }
-
-                    // Leer los dígitos del exponente
-                    while (i < expression.length() && std::isdigit(expression[i]))
-                    {
-                        current += expression[i++];
-                    }
-
-                    break; // Salimos porque el número ya terminó
                 }
-                else
+                else if (!isDigit(signOrDigit))
                 {
-                    break; // Ya no es parte del número
+                    malformed = true;
+                    error = diagnosticKind::ExponentWithoutDigits;
+                    break;
                 }
 
-                i++;
+                // Leer los dígitos del exponente
+                i = skipDigits(expression, i);
+
+                break; // Salimos porque el número ya terminó
+            }
+            else
+            {
+                break; // Ya no es parte del número
             }
 
-            i--; // Corregimos para evitar saltarnos un carácter en el for principal
-            tokens.emplace_back(tokenType::Number, current);
+            i++;
         }
 
-        //TOKEN: FUNCIONES, CONSTANTES O VARIABLES
-        else if (std::isalpha(character))
+        if (malformed)
         {
-            current = character;
-            // Leemos toda la secuencia de letras (por ejemplo: sin, ln, pi)
-            while (i + 1 < expression.length() && std::isalpha(expression[i + 1]))
-            {
-                current += expression[++i];
-            }
-            if (functions.count(current))
+            // Consumimos el resto del número inválido para reportarlo completo.
+            while (i < expression.length() && continuesNumber(expression, i))
             {
-                tokens.emplace_back(tokenType::Function, current);
-            }
-            else if (constant.count(current))
-            {
-                tokens.emplace_back(tokenType::Constant, current);
-            }
-            else if(variables.count(current) && current.length() == 1){
-                tokens.emplace_back(tokenType::Variable, current);
-            }
-            else
-            {
-                tokens.emplace_back(tokenType::Invalid, current);
+                i++;
             }
+            std::string_view text = expression.substr(start, i - start);
+            diagnostics.push_back({error, start, text.size()});
+            tokens.push_back({tokenType::Invalid, 0, text, start, 0.0});
+            return i;
         }
-        //TOKEN: PARÉNTESIS
-        else if (character == '('){
-            tokens.emplace_back(tokenType::LeftParen, "(");
+
+        std::string_view text = expression.substr(start, i - start);
+        tokens.push_back({tokenType::Number, 0, text, start, parseNumber(text)});
+        return i;
+    }
+
+    //TOKEN: FUNCIONES, CONSTANTES O VARIABLES
+    if (isAlpha(character))
+    {
+        size_t start = i;
+        // Leemos toda la secuencia de letras (por ejemplo: sin, ln, pi).
+        // Después de la primera letra se admite '_' para nombres como log_base.
+        i = skipIdentifier(expression, i + 1);
+        std::string_view text = expression.substr(start, i - start);
+        const keyword* entry = findKeyword(text);
+
+        if (entry == nullptr)
+        {
+            diagnostics.push_back({diagnosticKind::UnknownIdentifier, start, text.size()});
+            tokens.push_back({tokenType::Invalid, 0, text, start, 0.0});
         }
-        else if (character == ')'){
-            tokens.emplace_back(tokenType::RightParen, ")");
+        else
+        {
+            tokens.push_back({entry->type, entry->arity, text, start, entry->value});
         }
+        return i;
+    }
+
+    //TOKEN: PARÉNTESIS
+    if (character == '('){
+        tokens.push_back({tokenType::LeftParen, 0, expression.substr(i, 1), i, 0.0});
+    }
+    else if (character == ')'){
+        tokens.push_back({tokenType::RightParen, 0, expression.substr(i, 1), i, 0.0});
+    }
+
+    //TOKEN: SEPARADOR DE ARGUMENTOS
+    else if (character == ','){
+        tokens.push_back({tokenType::Comma, 0, expression.substr(i, 1), i, 0.0});
+    }
 
-        //TOKEN: OPERADORES
-        else if (std::string("+-*/^%=").find(character) != std::string::npos) {
-            tokens.emplace_back(tokenType::Operator, std::string(1, character));
+    //TOKEN: OPERADORES
+    else if (hasClass(character, OperatorClass)) {
+        tokens.push_back({tokenType::Operator, 0, expression.substr(i, 1), i, 0.0});
+    }
+
+    //TOKEN: DESCONOCIDO O NO SOPORTADO
+    else {
+        diagnostics.push_back({diagnosticKind::UnexpectedCharacter, i, 1});
+        tokens.push_back({tokenType::Invalid, 0, expression.substr(i, 1), i, 0.0});
+    }
+    return i + 1;
+}
+
+/**
+ * @brief Núcleo del analizador léxico compartido por todas las entradas públicas.
+ *
+ * Nunca lanza excepciones por errores léxicos: los registra en diagnostics y,
+ * según la política, se detiene o continúa con el resto de la expresión.
+ *
+ * @param expression Expresión matemática a analizar.
+ * @param policy Detenerse en el primer error o recopilarlos todos.
+ * @param tokens Lista donde se agregan los tokens generados.
+ * @param diagnostics Lista donde se agregan los errores encontrados.
+ */
+template <typename tokenList, typename diagnosticList>
+void scanExpression(std::string_view expression, errorPolicy policy, tokenList& tokens, diagnosticList& diagnostics) {
+    stageTimer timer(metricStage::Lex);
+    tokens.reserve(expression.length() / 2 + 1);
+
+    // Las funciones, constantes y variables reconocidas viven en keywordTable
+    // (keywords.hpp), que se construye una sola vez en tiempo de compilación.
+
+    // Bucle principal que recorre la expresión token por token.
+    size_t i = 0;
+    while (i < expression.length()) {
+        if (policy == errorPolicy::StopAtFirst && !diagnostics.empty())
+        {
+            break;
+        }
+
+        // Ignorar espacios en blanco.
+        i = skipSpaces(expression, i);
+        if (i < expression.length())
+        {
+            i = scanToken(expression, i, tokens, diagnostics);
+        }
+    }
+    recordLexed(tokens.size(), i);
+}
+
+} // namespace
+
+/**
+ * @brief Convierte una cadena de entrada en una lista de tokens sin copiar texto.
+ *
+ * Cada token guarda un fragmento (std::string_view) de la expresión original
+ * y, para números y constantes, su valor ya convertido a double.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @return std::vector<tokenView> Lista de tokens generados.
+ */
+std::vector<tokenView> tokenizeView(std::string_view expression) {
+    std::vector<tokenView> tokens;
+    std::vector<diagnostic> diagnostics;
+    scanExpression(expression, errorPolicy::CollectAll, tokens, diagnostics);
+
+    // Los identificadores desconocidos quedan como tokens inválidos; solo los
+    // números mal formados se informan con una excepción.
+    for (const diagnostic& found : diagnostics)
+    {
+        if (isMalformedNumber(found.kind))
+        {
+            throw std::runtime_error(diagnosticMessage(found.kind));
+        }
+    }
+    return tokens;
+}
+
+/**
+ * @brief Analiza la expresión sin lanzar excepciones, recopilando los errores.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @param policy Detenerse en el primer error o continuar hasta el final.
+ * @param memory Memoria para las listas de tokens y diagnósticos.
+ * @return lexResult Tokens generados y diagnósticos con su ubicación.
+ */
+lexResult tokenizeChecked(std::string_view expression, errorPolicy policy, std::pmr::memory_resource* memory) {
+    lexResult result(memory);
+    result.length = expression.size();
+    scanExpression(expression, policy, result.tokens, result.diagnostics);
+    return result;
+}
+
+/**
+ * @brief Analiza la expresión y guarda los tokens por columnas.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @param policy Detenerse en el primer error o continuar hasta el final.
+ * @param memory Memoria para las columnas de tokens y los diagnósticos.
+ * @return packedLexResult Tokens generados y diagnósticos con su ubicación.
+ */
+packedLexResult tokenizePacked(std::string_view expression, errorPolicy policy, std::pmr::memory_resource* memory) {
+    if (expression.size() > std::numeric_limits<std::uint32_t>::max())
+    {
+        throw std::runtime_error("[Lexer Error]: La expresión es demasiado larga.");
+    }
+    packedLexResult result(memory);
+    result.tokens.source = expression;
+    scanExpression(expression, policy, result.tokens, result.diagnostics);
+    return result;
+}
+
+/**
+ * @brief Vuelve a analizar una expresión tras una edición, solo alrededor del cambio.
+ *
+ * Un token anterior se conserva si termina antes de la edición (el análisis
+ * mira un carácter más allá del final del token). Como el análisis desde un
+ * inicio de token solo depende del texto a partir de ahí, en cuanto un token
+ * nuevo posterior a la edición empieza donde empezaba uno anterior (desplazado),
+ * el resto de la lista anterior vale sin cambios.
+ *
+ * @param previous Resultado de tokenizeChecked (con CollectAll) o de una llamada anterior.
+ * @param edited Expresión ya editada; debe sobrevivir a los tokens.
+ * @param edit Edición aplicada.
+ * @param memory Memoria para las listas del resultado.
+ * @return lexResult Tokens y diagnósticos de la expresión editada.
+ * @throws std::runtime_error Si la edición no es coherente con ambos textos.
+ */
+lexResult tokenizeIncremental(const lexResult& previous, std::string_view edited, const textEdit& edit, std::pmr::memory_resource* memory) {
+    // Las comparaciones se escriben restando para que ningún campo enorme desborde.
+    if (edit.offset > previous.length || edit.removed > previous.length - edit.offset)
+    {
+        throw std::runtime_error("[Lexer Error]: La edición se sale del texto anterior.");
+    }
+    if (edit.offset > edited.size() || edit.inserted > edited.size() - edit.offset)
+    {
+        throw std::runtime_error("[Lexer Error]: La edición se sale del texto editado.");
+    }
+    if (previous.length - edit.removed != edited.size() - edit.inserted)
+    {
+        throw std::runtime_error("[Lexer Error]: La edición no coincide con la longitud del texto editado.");
+    }
+    const size_t editEnd = edit.offset + edit.inserted; // Fin de la edición en el texto nuevo
+    const size_t oldEditEnd = edit.offset + edit.removed; // Fin de la edición en el texto anterior
+    stageTimer timer(metricStage::Lex);
+
+    const auto& oldTokens = previous.tokens;
+    const auto& oldDiagnostics = previous.diagnostics;
+    auto tokenEnd = [](const tokenView& t) { return t.offset + t.text.size(); };
+    auto rebased = [edited](tokenView t, size_t offset) {
+        t.text = edited.substr(offset, t.text.size());
+        t.offset = offset;
+        return t;
+    };
+
+    lexResult result(memory);
+    result.length = edited.size();
+    result.tokens.reserve(oldTokens.size() + edit.inserted);
+
+    // Tokens intactos antes de la edición.
+    size_t kept = std::partition_point(oldTokens.begin(), oldTokens.end(),
+        [&](const tokenView& t) { return tokenEnd(t) < edit.offset; }) - oldTokens.begin();
+    for (size_t k = 0; k < kept; k++)
+    {
+        result.tokens.push_back(rebased(oldTokens[k], oldTokens[k].offset));
+    }
+    size_t i = kept > 0 ? tokenEnd(oldTokens[kept - 1]) : 0;
+    const size_t windowStart = i;
+    for (const diagnostic& found : oldDiagnostics)
+    {
+        if (found.offset < i)
+        {
+            result.diagnostics.push_back(found);
         }
+    }
 
-        //TOKEN: DESCONOCIDO O NO SOPORTADO
-        else {
-            tokens.emplace_back(tokenType::Invalid, std::string(1, character));
-        }              
-    }            
+    // Ventana afectada: se analiza hasta volver a coincidir con los tokens anteriores.
+    while (i < edited.length())
+    {
+        if (isSpace(edited[i]))
+        {
+            i = skipSpaces(edited, i);
+            continue;
+        }
+
+        if (i >= editEnd)
+        {
+            const size_t oldOffset = i - editEnd + oldEditEnd;
+            auto match = std::lower_bound(oldTokens.begin() + kept, oldTokens.end(), oldOffset,
+                [](const tokenView& t, size_t offset) { return t.offset < offset; });
+            if (match != oldTokens.end() && match->offset == oldOffset)
+            {
+                for (auto it = match; it != oldTokens.end(); ++it)
+                {
+                    result.tokens.push_back(rebased(*it, it->offset - oldOffset + i));
+                }
+                for (const diagnostic& found : oldDiagnostics)
+                {
+                    if (found.offset >= oldOffset)
+                    {
+                        result.diagnostics.push_back({found.kind, found.offset - oldOffset + i, found.length});
+                    }
+                }
+                recordLexed(result.tokens.size() - static_cast<size_t>(oldTokens.end() - match) - kept, i - windowStart);
+                return result;
+            }
+        }
+
+        i = scanToken(edited, i, result.tokens, result.diagnostics);
+    }
+    recordLexed(result.tokens.size() - kept, i - windowStart);
+    return result;
+}
+
+/**
+ * @brief Convierte una cadena de entrada en una lista de tokens.
+ * 
+ * @param expression Expresión matemática como cadena.
+ * @return std::vector<Token> Lista de tokens generados.
+ */
+std::vector<token> tokenize(const std::string& expression) {
+    std::vector<token> tokens;
+    for (const tokenView& view : tokenizeView(expression))
+    {
+        tokens.emplace_back(view.type, std::string(view.text), view.arity, view.number);
+    }
     return tokens;
 }
\ No newline at end of file
@@ -5,9 +5,14 @@
 #ifndef LEXER_HPP
 #define LEXER_HPP
 
-#include "Token.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+#include "diagnostic.hpp"
+#include <cstddef>
+#include <memory_resource>
 #include <vector>
 #include <string>
+#include <string_view>
 
 /**
  * @brief Convierte una cadena de entrada en una lista de tokens.
@@ -17,4 +22,121 @@
  */
 std::vector<token> tokenize(const std::string& expression);
 
+/**
+ * @brief Igual que tokenize, pero sin copiar el texto de cada token.
+ *
+ * Los tokens apuntan a la expresión original, por lo que esta debe seguir
+ * viva mientras se usen. Números y constantes traen su valor ya convertido.
+ *
+ * @param expression Expresión matemática como vista de cadena.
+ * @return std::vector<tokenView> Lista de tokens generados.
+ */
+std::vector<tokenView> tokenizeView(std::string_view expression);
+
+/**
+ * @enum errorPolicy
+ * @brief Qué hacer cuando el analizador encuentra un error léxico.
+ */
+enum class errorPolicy {
+    StopAtFirst, ///< Detener el análisis en el primer error
+    CollectAll, ///< Continuar y reportar todos los errores
+};
+
+/**
+ * @struct lexResult
+ * @brief Resultado del análisis léxico sin excepciones.
+ *
+ * Las listas usan std::pmr: con una arena (std::pmr::monotonic_buffer_resource)
+ * todo el análisis de una expresión comparte un solo bloque de memoria.
+ */
+struct lexResult {
+    std::pmr::vector<tokenView> tokens; ///< Tokens generados (los fragmentos inválidos quedan como Invalid)
+    std::pmr::vector<diagnostic> diagnostics; ///< Errores encontrados, en orden de aparición
+    std::size_t length = 0; ///< Longitud del texto analizado (para validar ediciones)
+
+    explicit lexResult(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : tokens(memory), diagnostics(memory) {}
+
+    /**
+     * @brief Indica si la expresión no tiene errores léxicos.
+     */
+    bool ok() const { return diagnostics.empty(); }
+};
+
+/**
+ * @brief Analiza la expresión sin lanzar excepciones, recopilando los errores.
+ *
+ * A diferencia de tokenize, los números mal formados no lanzan excepción:
+ * se reportan como diagnóstico y quedan como un token Invalid. Los
+ * identificadores y caracteres desconocidos también generan diagnóstico.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @param policy Detenerse en el primer error o continuar hasta el final.
+ * @param memory Memoria para las listas de tokens y diagnósticos.
+ * @return lexResult Tokens generados y diagnósticos con su ubicación.
+ */
+lexResult tokenizeChecked(std::string_view expression, errorPolicy policy = errorPolicy::CollectAll,
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @struct packedLexResult
+ * @brief Resultado del análisis léxico con los tokens empaquetados por columnas.
+ */
+struct packedLexResult {
+    tokenStream tokens; ///< Tokens generados (los fragmentos inválidos quedan como Invalid)
+    std::pmr::vector<diagnostic> diagnostics; ///< Errores encontrados, en orden de aparición
+
+    explicit packedLexResult(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : tokens(memory), diagnostics(memory) {}
+
+    /**
+     * @brief Indica si la expresión no tiene errores léxicos.
+     */
+    bool ok() const { return diagnostics.empty(); }
+};
+
+/**
+ * @brief Igual que tokenizeChecked, pero produce un tokenStream.
+ *
+ * @param expression Expresión matemática; debe sobrevivir a los tokens.
+ * @param policy Detenerse en el primer error o continuar hasta el final.
+ * @param memory Memoria para las columnas de tokens y los diagnósticos.
+ * @return packedLexResult Tokens generados y diagnósticos con su ubicación.
+ * @throws std::runtime_error Si la expresión no cabe en posiciones de 32 bits.
+ */
+packedLexResult tokenizePacked(std::string_view expression, errorPolicy policy = errorPolicy::CollectAll,
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @struct textEdit
+ * @brief Una edición sobre el texto: se reemplazó un fragmento por otro.
+ */
+struct textEdit {
+    std::size_t offset; ///< Posición donde empieza la edición
+    std::size_t removed; ///< Cantidad de caracteres borrados del texto anterior
+    std::size_t inserted; ///< Cantidad de caracteres insertados en el texto nuevo
+};
+
+/**
+ * @brief Vuelve a analizar una expresión tras una edición, solo alrededor del cambio.
+ *
+ * Los tokens anteriores a la edición se conservan tal cual y los posteriores
+ * se reutilizan desplazados en cuanto el análisis vuelve a coincidir con el
+ * de antes; solo se analiza de nuevo la ventana afectada. El resultado es
+ * idéntico al de tokenizeChecked(edited, errorPolicy::CollectAll).
+ *
+ * Del resultado anterior solo se usan tipos, posiciones y valores, nunca su
+ * texto: es válido aunque la cadena original ya se haya modificado en el lugar.
+ *
+ * @param previous Resultado de tokenizeChecked (con CollectAll) o de una llamada anterior.
+ * @param edited Expresión ya editada; debe sobrevivir a los tokens.
+ * @param edit Edición aplicada sobre el texto de previous.
+ * @param memory Memoria para las listas del resultado.
+ * @return lexResult Tokens y diagnósticos de la expresión editada.
+ * @throws std::runtime_error Si la edición se sale del texto anterior o del
+ *         editado, o si sus longitudes no cuadran con la edición.
+ */
+lexResult tokenizeIncremental(const lexResult& previous, std::string_view edited, const textEdit& edit,
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
 #endif // LEXER_HPP
@@ -0,0 +1,180 @@
+/**
+ * @file number_parse.cpp
+ * @brief Implementación de la conversión de literales numéricos.
+ */
+
+#include "number_parse.hpp"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+namespace {
+
+/// Potencias de 10 exactas en double (10^22 es la mayor).
+constexpr double exactPowers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/// Mayor exponente con potencia de 10 exacta.
+constexpr int maxExactPower = 22;
+
+/// Mayor mantisa entera representable exactamente en double.
+constexpr std::uint64_t maxExactMantissa = std::uint64_t(1) << 53;
+
+/// Dígitos que siempre caben en un entero de 64 bits sin desbordarse.
+constexpr std::ptrdiff_t maxMantissaDigits = 19;
+
+/// Exponentes escritos mayores que este no pueden salir por el camino rápido.
+constexpr int exponentLimit = 10000;
+
+bool isDigitChar(char character) {
+    return static_cast<unsigned char>(character - '0') < 10;
+}
+
+/**
+ * @brief Indica si el literal vale al menos 1, mirando solo su orden de magnitud.
+ *
+ * Basta para decidir hacia dónde se sale de rango: los que desbordan pasan de
+ * 1e308 y los que se anulan no llegan a 1e-323.
+ */
+bool atLeastOne(std::string_view text) {
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    long order = 0; // Dígitos enteros significativos, o menos los ceros tras el punto
+    bool significant = false;
+    bool fraction = false;
+    for (; cursor != end && *cursor != 'e' && *cursor != 'E'; cursor++)
+    {
+        if (*cursor == '.')
+        {
+            fraction = true;
+        }
+        else if (*cursor != '0' || significant)
+        {
+            significant = true;
+            order += fraction ? 0 : 1;
+        }
+        else if (fraction)
+        {
+            order--;
+        }
+    }
+    if (!significant)
+    {
+        return false;
+    }
+    long exponent = 0;
+    bool negative = false;
+    if (cursor != end)
+    {
+        cursor++;
+        if (cursor != end && (*cursor == '+' || *cursor == '-'))
+        {
+            negative = *cursor == '-';
+            cursor++;
+        }
+        for (; cursor != end && exponent < exponentLimit; cursor++)
+        {
+            exponent = exponent * 10 + (*cursor - '0');
+        }
+    }
+    return order + (negative ? -exponent : exponent) > 0;
+}
+
+double slowPath(std::string_view text) {
+    double number = 0.0;
+    if (std::from_chars(text.data(), text.data() + text.size(), number).ec == std::errc::result_out_of_range)
+    {
+        // from_chars no toca el valor: como strtod, lo que desborda es inf y lo que se anula, 0.
+        return atLeastOne(text) ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+    return number;
+}
+
+/**
+ * @brief Acumula los dígitos desde cursor en mantissa y devuelve dónde terminan.
+ */
+const char* readDigits(const char* cursor, const char* end, std::uint64_t& mantissa) {
+    while (cursor != end && isDigitChar(*cursor))
+    {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*cursor - '0');
+        cursor++;
+    }
+    return cursor;
+}
+
+} // namespace
+
+/**
+ * @brief Convierte un literal ya validado por el lexer al double más cercano.
+ *
+ * @param text Literal numérico completo.
+ * @return double Valor del literal.
+ */
+double parseNumber(std::string_view text) {
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+
+    // Mantisa entera con todos los dígitos, y el exponente que le corresponde.
+    std::uint64_t mantissa = 0;
+    const char* integer = cursor;
+    cursor = readDigits(cursor, end, mantissa);
+    std::ptrdiff_t digits = cursor - integer;
+    int exponent = 0;
+    if (cursor != end && *cursor == '.')
+    {
+        const char* fraction = ++cursor;
+        cursor = readDigits(cursor, end, mantissa);
+        digits += cursor - fraction;
+        exponent = -static_cast<int>(cursor - fraction);
+    }
+    // Con ceros a la izquierda puede haber más de 15 dígitos y la mantisa seguir siendo exacta.
+    if (digits > maxMantissaDigits || mantissa > maxExactMantissa)
+    {
+        return slowPath(text);
+    }
+
+    if (cursor != end && (*cursor == 'e' || *cursor == 'E'))
+    {
+        cursor++;
+        bool negative = false;
+        if (cursor != end && (*cursor == '+' || *cursor == '-'))
+        {
+            negative = *cursor == '-';
+            cursor++;
+        }
+        int written = 0;
+        for (; cursor != end && isDigitChar(*cursor); cursor++)
+        {
+            if (written > exponentLimit)
+            {
+                return slowPath(text);
+            }
+            written = written * 10 + (*cursor - '0');
+        }
+        exponent += negative ? -written : written;
+    }
+    if (cursor != end)
+    {
+        return slowPath(text); // Forma no prevista: que decida from_chars
+    }
+
+    // Mantisa y potencia exactas: una sola operación redondea correctamente.
+    const double value = static_cast<double>(mantissa);
+    if (mantissa == 0)
+    {
+        return 0.0;
+    }
+    if (exponent >= 0 && exponent <= maxExactPower)
+    {
+        return value * exactPowers[exponent];
+    }
+    if (exponent < 0 && exponent >= -maxExactPower)
+    {
+        return value / exactPowers[-exponent];
+    }
+    return slowPath(text);
+}
@@ -0,0 +1,30 @@
+/**
+ * @file number_parse.hpp
+ * @brief Conversión de literales numéricos a double, exacta y sin depender del locale.
+ */
+#ifndef NUMBER_PARSE_HPP
+#define NUMBER_PARSE_HPP
+
+#include <string_view>
+
+/**
+ * @brief Convierte un literal ya validado por el lexer al double más cercano.
+ *
+ * El literal tiene la forma dígitos [. dígitos] [(e|E) [+|-] dígitos], o
+ * empieza con '.'. Si todos los dígitos forman un entero de hasta 2^53 y el
+ * exponente decimal está en [-22, 22], tanto la mantisa como la potencia de
+ * 10 son exactas en double y una sola multiplicación o división da el valor
+ * correctamente redondeado (camino rápido de Clinger). En el resto de casos
+ * se usa std::from_chars (Eisel-Lemire en las bibliotecas actuales), que
+ * también redondea correctamente.
+ *
+ * El resultado es siempre idéntico al de strtod en el locale "C": un literal
+ * que desborda (por ejemplo 1e400) da inf, y uno demasiado pequeño da el
+ * subnormal más cercano o 0.
+ *
+ * @param text Literal numérico completo.
+ * @return double Valor del literal.
+ */
+double parseNumber(std::string_view text);
+
+#endif // NUMBER_PARSE_HPP
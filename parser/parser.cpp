@@ -0,0 +1,469 @@
+/**
+ * @file parser.cpp
+ * @brief Implementación del parser (analizador sintáctico) de expresiones matemáticas.
+ *
+ * Usa la técnica de Pratt (precedencia por "binding power") sobre la lista de
+ * tokens y emite los nodos directamente en postorden dentro de un arreglo
+ * contiguo, sin árboles de punteros.
+ *
+ * El parser se detiene en el primer error y lo reporta como diagnóstico con
+ * la posición del token que lo causó.
+ */
+
+#include "parser.hpp"
+#include "keywords.hpp"
+#include "lexer.hpp"
+#include "../support/metrics.hpp"
+#include <cctype>
+#include <stdexcept>
+
+namespace {
+
+/// Profundidad máxima de anidamiento (paréntesis, funciones y operadores unarios).
+constexpr int maxNestingDepth = 256;
+
+/// Precedencia de los operadores unarios '-' y '+'.
+constexpr int unaryPrecedence = 30;
+
+/**
+ * @struct bindingPower
+ * @brief Precedencia a izquierda y derecha de un operador binario.
+ *
+ * Si la derecha es mayor que la izquierda el operador asocia por la
+ * izquierda; si son iguales, asocia por la derecha.
+ */
+struct bindingPower {
+    int left;
+    int right;
+    opCode op;
+};
+
+/**
+ * @brief Precedencia de un operador binario, o left = -1 si no lo es.
+ */
+bindingPower binaryPower(char character) {
+    switch (character)
+    {
+    case '+': return {10, 11, opCode::Add};
+    case '-': return {10, 11, opCode::Subtract};
+    case '*': return {20, 21, opCode::Multiply};
+    case '/': return {20, 21, opCode::Divide};
+    case '%': return {20, 21, opCode::Modulo};
+    case '^': return {40, 40, opCode::Power};
+    default: return {-1, -1, opCode::Constant};
+    }
+}
+
+/**
+ * @struct viewTokens
+ * @brief Acceso a una lista de tokenView con la interfaz que usa parserState.
+ */
+struct viewTokens {
+    std::span<const tokenView> tokens;
+
+    std::size_t size() const { return tokens.size(); }
+    tokenType type(std::size_t index) const { return tokens[index].type; }
+    std::string_view text(std::size_t index) const { return tokens[index].text; }
+    std::size_t offset(std::size_t index) const { return tokens[index].offset; }
+
+    /**
+     * @brief Valor del token index, que es el Number o Constant número ordinal.
+     */
+    double number(std::size_t index, std::size_t) const { return tokens[index].number; }
+};
+
+/**
+ * @struct packedTokens
+ * @brief Acceso a un tokenStream con la interfaz que usa parserState.
+ */
+struct packedTokens {
+    const tokenStream& tokens;
+
+    std::size_t size() const { return tokens.size(); }
+    tokenType type(std::size_t index) const { return tokens.types[index]; }
+    std::string_view text(std::size_t index) const { return tokens.text(index); }
+    std::size_t offset(std::size_t index) const { return tokens.offsets[index]; }
+    double number(std::size_t, std::size_t ordinal) const { return tokens.numbers[ordinal]; }
+};
+
+/**
+ * @class parserState
+ * @brief Estado del parser durante el análisis de una lista de tokens.
+ *
+ * tokenSource es viewTokens o packedTokens: el análisis es el mismo y solo
+ * cambia cómo se leen el tipo, el texto y el valor de cada token.
+ */
+template <typename tokenSource>
+class parserState {
+public:
+    parserState(tokenSource tokens, syntaxTree& tree, std::pmr::vector<diagnostic>& diagnostics)
+        : tokens(tokens), tree(tree), diagnostics(diagnostics) {}
+
+    /**
+     * @brief Analiza la expresión completa, incluyendo un '=' opcional.
+     */
+    void parseEquation() {
+        if (tokens.size() == 0)
+        {
+            fail(diagnosticKind::EmptyExpression, 0, 0);
+            return;
+        }
+
+        std::uint32_t result = parseBinary(0);
+        if (failed())
+        {
+            return;
+        }
+
+        if (isOperator(position, '='))
+        {
+            position++;
+            std::uint32_t rhs = parseBinary(0);
+            if (failed())
+            {
+                return;
+            }
+            // Una ecuación a = b se evalúa como a - b: su conjunto de ceros es la curva.
+            result = emit({opCode::Subtract, 0, result, rhs, 0.0});
+        }
+
+        if (position < tokens.size())
+        {
+            rejectTrailing();
+            return;
+        }
+        tree.root = result;
+    }
+
+private:
+    tokenSource tokens;
+    syntaxTree& tree;
+    std::pmr::vector<diagnostic>& diagnostics;
+    std::size_t position = 0; ///< Índice del siguiente token por consumir
+    std::size_t numbers = 0; ///< Tokens Number o Constant ya consumidos
+    int depth = 0; ///< Profundidad de anidamiento actual
+
+    bool failed() const { return !diagnostics.empty(); }
+
+    void fail(diagnosticKind kind, std::size_t offset, std::size_t length) {
+        if (!failed())
+        {
+            diagnostics.push_back({kind, offset, length});
+        }
+    }
+
+    /**
+     * @brief Reporta un error sobre el token en la posición dada (o el final).
+     */
+    void failAt(diagnosticKind kind, std::size_t index) {
+        if (index < tokens.size())
+        {
+            fail(kind, tokens.offset(index), tokens.text(index).size());
+        }
+        else
+        {
+            const std::size_t last = tokens.size() - 1;
+            fail(kind, tokens.offset(last) + tokens.text(last).size(), 0);
+        }
+    }
+
+    bool isType(std::size_t index, tokenType type) const {
+        return index < tokens.size() && tokens.type(index) == type;
+    }
+
+    bool isOperator(std::size_t index, char character) const {
+        return isType(index, tokenType::Operator) && tokens.text(index)[0] == character;
+    }
+
+    std::uint32_t emit(const astNode& node) {
+        tree.nodes.push_back(node);
+        return static_cast<std::uint32_t>(tree.nodes.size() - 1);
+    }
+
+    /**
+     * @brief Reporta el error adecuado para un token que sobra tras una expresión completa.
+     */
+    void rejectTrailing() {
+        if (isType(position, tokenType::RightParen))
+        {
+            failAt(diagnosticKind::UnexpectedRightParen, position);
+        }
+        else if (isType(position, tokenType::Comma))
+        {
+            failAt(diagnosticKind::MisplacedComma, position);
+        }
+        else if (isOperator(position, '='))
+        {
+            failAt(diagnosticKind::MisplacedEquals, position);
+        }
+        else
+        {
+            failAt(diagnosticKind::ExpectedOperator, position);
+        }
+    }
+
+    /**
+     * @brief Exige un token de cierre (')' o ',') y si falta reporta el error adecuado.
+     *
+     * @param expected Token que debería seguir.
+     * @param insideCall Si estamos dentro de los argumentos de una función.
+     */
+    void expectClosing(tokenType expected, bool insideCall) {
+        if (isType(position, expected))
+        {
+            position++;
+        }
+        else if (position >= tokens.size())
+        {
+            failAt(diagnosticKind::ExpectedRightParen, position);
+        }
+        else if (isOperator(position, '='))
+        {
+            failAt(diagnosticKind::MisplacedEquals, position);
+        }
+        else if (isType(position, tokenType::Comma))
+        {
+            failAt(insideCall ? diagnosticKind::WrongArgumentCount : diagnosticKind::MisplacedComma, position);
+        }
+        else if (isType(position, tokenType::RightParen))
+        {
+            failAt(diagnosticKind::WrongArgumentCount, position); // Faltan argumentos
+        }
+        else
+        {
+            failAt(diagnosticKind::ExpectedOperator, position);
+        }
+    }
+
+    /**
+     * @brief Analiza operadores binarios cuya precedencia izquierda sea al menos minPower.
+     */
+    std::uint32_t parseBinary(int minPower) {
+        // Toda forma de anidamiento (paréntesis, argumentos, unarios y '^') pasa por aquí.
+        if (++depth > maxNestingDepth)
+        {
+            failAt(diagnosticKind::NestingTooDeep, position);
+            return 0;
+        }
+
+        std::uint32_t lhs = parsePrefix();
+        while (!failed() && isType(position, tokenType::Operator))
+        {
+            bindingPower power = binaryPower(tokens.text(position)[0]);
+            if (power.left < minPower)
+            {
+                break; // También corta en '=', cuya precedencia es -1
+            }
+            position++;
+            std::uint32_t rhs = parseBinary(power.right);
+            if (failed())
+            {
+                break;
+            }
+            lhs = emit({power.op, 0, lhs, rhs, 0.0});
+        }
+        depth--;
+        return lhs;
+    }
+
+    /**
+     * @brief Analiza un operando: número, constante, variable, función, paréntesis o unario.
+     */
+    std::uint32_t parsePrefix() {
+        if (position >= tokens.size())
+        {
+            failAt(diagnosticKind::ExpectedOperand, position);
+            return 0;
+        }
+
+        std::uint32_t result = 0;
+        const char first = tokens.text(position)[0];
+        switch (tokens.type(position))
+        {
+        case tokenType::Number:
+        case tokenType::Constant:
+            result = emit({opCode::Constant, 0, 0, 0, tokens.number(position, numbers++)});
+            position++;
+            break;
+        case tokenType::Variable:
+            position++;
+            result = emit({opCode::Variable, static_cast<std::uint8_t>(first - 'x'), 0, 0, 0.0});
+            break;
+        case tokenType::Function:
+            result = parseCall();
+            break;
+        case tokenType::LeftParen:
+        {
+            position++;
+            result = parseBinary(0);
+            if (!failed())
+            {
+                expectClosing(tokenType::RightParen, false);
+            }
+            break;
+        }
+        case tokenType::Operator:
+            if (first == '-' || first == '+')
+            {
+                position++;
+                std::uint32_t operand = parseBinary(unaryPrecedence);
+                if (!failed())
+                {
+                    result = first == '-' ? emit({opCode::Negate, 0, operand, 0, 0.0}) : operand;
+                }
+            }
+            else
+            {
+                failAt(diagnosticKind::ExpectedOperand, position);
+            }
+            break;
+        case tokenType::Invalid:
+            failAt(std::isalpha(static_cast<unsigned char>(first)) ? diagnosticKind::UnknownIdentifier : diagnosticKind::UnexpectedCharacter, position);
+            break;
+        default:
+            failAt(diagnosticKind::ExpectedOperand, position);
+            break;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Analiza una llamada a función con tantos argumentos como su aridad.
+     */
+    std::uint32_t parseCall() {
+        const keyword* entry = findKeyword(tokens.text(position));
+        position++;
+
+        if (!isType(position, tokenType::LeftParen))
+        {
+            failAt(diagnosticKind::ExpectedLeftParen, position);
+            return 0;
+        }
+        position++;
+
+        std::uint32_t arguments[2] = {0, 0};
+        for (int argument = 0; argument < entry->arity && !failed(); argument++)
+        {
+            arguments[argument] = parseBinary(0);
+            if (!failed())
+            {
+                expectClosing(argument + 1 < entry->arity ? tokenType::Comma : tokenType::RightParen, true);
+            }
+        }
+        if (failed())
+        {
+            return 0;
+        }
+        return emit({entry->op, 0, arguments[0], arguments[1], 0.0});
+    }
+};
+
+template <typename tokenSource>
+parseResult parseTokens(tokenSource tokens, std::pmr::memory_resource* memory) {
+    stageTimer timer(metricStage::Parse);
+    parseResult result(memory);
+    result.tree.nodes.reserve(tokens.size());
+    parserState<tokenSource>(tokens, result.tree, result.diagnostics).parseEquation();
+    if (!result.ok())
+    {
+        result.tree.nodes.clear();
+        result.tree.root = 0;
+    }
+    return result;
+}
+
+} // namespace
+
+/**
+ * @brief Construye el árbol sintáctico sin lanzar excepciones.
+ *
+ * @param tokens Tokens producidos por el lexer.
+ * @param memory Memoria para los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o el primer error con su ubicación.
+ */
+parseResult parseChecked(std::span<const tokenView> tokens, std::pmr::memory_resource* memory) {
+    return parseTokens(viewTokens{tokens}, memory);
+}
+
+/**
+ * @brief Construye el árbol sintáctico a partir de tokens empaquetados, sin lanzar excepciones.
+ *
+ * @param tokens Tokens producidos por tokenizePacked.
+ * @param memory Memoria para los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o el primer error con su ubicación.
+ */
+parseResult parseChecked(const tokenStream& tokens, std::pmr::memory_resource* memory) {
+    return parseTokens(packedTokens{tokens}, memory);
+}
+
+/**
+ * @brief Construye el árbol sintáctico a partir de los tokens.
+ *
+ * @param tokens Tokens producidos por el lexer.
+ * @param memory Memoria para los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ */
+syntaxTree parse(std::span<const tokenView> tokens, std::pmr::memory_resource* memory) {
+    parseResult result = parseChecked(tokens, memory);
+    if (!result.ok())
+    {
+        throw std::runtime_error(diagnosticMessage(result.diagnostics.front().kind));
+    }
+    return std::move(result.tree);
+}
+
+/**
+ * @brief Construye el árbol sintáctico a partir de tokens empaquetados.
+ *
+ * @param tokens Tokens producidos por tokenizePacked.
+ * @param memory Memoria para los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ */
+syntaxTree parse(const tokenStream& tokens, std::pmr::memory_resource* memory) {
+    parseResult result = parseChecked(tokens, memory);
+    if (!result.ok())
+    {
+        throw std::runtime_error(diagnosticMessage(result.diagnostics.front().kind));
+    }
+    return std::move(result.tree);
+}
+
+/**
+ * @brief Analiza léxica y sintácticamente una expresión sin lanzar excepciones.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param memory Memoria para los tokens, los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o los errores encontrados.
+ */
+parseResult parseExpressionChecked(std::string_view expression, std::pmr::memory_resource* memory) {
+    lexResult lexed = tokenizeChecked(expression, errorPolicy::CollectAll, memory);
+    if (!lexed.ok())
+    {
+        parseResult result(memory);
+        result.diagnostics = std::move(lexed.diagnostics);
+        return result;
+    }
+    return parseChecked(lexed.tokens, memory);
+}
+
+/**
+ * @brief Analiza léxica y sintácticamente una expresión.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param memory Memoria para los tokens (temporales) y los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ */
+syntaxTree parseExpression(std::string_view expression, std::pmr::memory_resource* memory) {
+    // Igual que parse(tokenizeView(expression)): solo los números mal formados
+    // se informan antes de analizar; el resto de errores los reporta el parser.
+    lexResult lexed = tokenizeChecked(expression, errorPolicy::CollectAll, memory);
+    for (const diagnostic& found : lexed.diagnostics)
+    {
+        if (isMalformedNumber(found.kind))
+        {
+            throw std::runtime_error(diagnosticMessage(found.kind));
+        }
+    }
+    return parse(lexed.tokens, memory);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file parser.hpp
+ * @brief Declaración del parser que convierte tokens en un árbol sintáctico plano.
+ *
+ * Gramática (de menor a mayor precedencia):
+ * - ecuación:  expr [ '=' expr ]   (a = b se representa como a - b)
+ * - '+' '-'    binarios, asociativos por la izquierda
+ * - '*' '/' '%' binarios, asociativos por la izquierda
+ * - '-' '+'    unarios (por eso -x^2 es -(x^2))
+ * - '^'        binario, asociativo por la derecha
+ * - primario:  número | constante | variable | función '(' args ')' | '(' expr ')'
+ *
+ * Las funciones de dos argumentos los separan con coma: log_base(b, x), nroot(n, x).
+ */
+#ifndef PARSER_HPP
+#define PARSER_HPP
+
+#include "ast.hpp"
+#include "diagnostic.hpp"
+#include "token.hpp"
+#include "token_stream.hpp"
+#include <memory_resource>
+#include <span>
+#include <string_view>
+
+/**
+ * @struct parseResult
+ * @brief Resultado del análisis sintáctico sin excepciones.
+ */
+struct parseResult {
+    syntaxTree tree; ///< Árbol generado; solo es válido si no hay diagnósticos
+    std::pmr::vector<diagnostic> diagnostics; ///< Errores encontrados (el parser se detiene en el primero)
+
+    explicit parseResult(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : tree{std::pmr::vector<astNode>(memory)}, diagnostics(memory) {}
+
+    /**
+     * @brief Indica si la expresión se analizó sin errores.
+     */
+    bool ok() const { return diagnostics.empty(); }
+};
+
+/**
+ * @brief Construye el árbol sintáctico sin lanzar excepciones.
+ *
+ * @param tokens Tokens producidos por el lexer.
+ * @param memory Memoria para los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o el primer error con su ubicación.
+ */
+parseResult parseChecked(std::span<const tokenView> tokens, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Construye el árbol sintáctico a partir de los tokens.
+ *
+ * @param tokens Tokens producidos por el lexer.
+ * @param memory Memoria para los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ * @throws std::runtime_error Si la secuencia de tokens no forma una expresión válida.
+ */
+syntaxTree parse(std::span<const tokenView> tokens, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Igual que parseChecked, pero sobre los tokens empaquetados de tokenizePacked.
+ *
+ * @param tokens Tokens empaquetados por columnas.
+ * @param memory Memoria para los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o el primer error con su ubicación.
+ */
+parseResult parseChecked(const tokenStream& tokens, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Igual que parse, pero sobre los tokens empaquetados de tokenizePacked.
+ *
+ * @param tokens Tokens empaquetados por columnas.
+ * @param memory Memoria para los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ * @throws std::runtime_error Si la secuencia de tokens no forma una expresión válida.
+ */
+syntaxTree parse(const tokenStream& tokens, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Analiza léxica y sintácticamente una expresión sin lanzar excepciones.
+ *
+ * Si el lexer encuentra errores se devuelven todos sus diagnósticos y no se
+ * intenta construir el árbol.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param memory Memoria para los tokens, los nodos y los diagnósticos.
+ * @return parseResult Árbol generado o los errores encontrados.
+ */
+parseResult parseExpressionChecked(std::string_view expression, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Analiza léxica y sintácticamente una expresión.
+ *
+ * @param expression Expresión matemática como cadena.
+ * @param memory Memoria para los tokens (temporales) y los nodos.
+ * @return syntaxTree Árbol plano en postorden.
+ * @throws std::runtime_error Si la expresión tiene errores léxicos o sintácticos.
+ */
+syntaxTree parseExpression(std::string_view expression, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+#endif // PARSER_HPP
@@ -2,6 +2,9 @@
 #define TOKEN_HPP
 
 #include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
 
 /**
  * @file Token.hpp
@@ -12,11 +15,12 @@
  * @enum TokenType
  * @brief Tipos posibles de tokens reconocidos por el analizador léxico.
  */
-enum class tokenType{
+enum class tokenType : std::uint8_t {
     Number,
     Operator,
     LeftParen,
     RightParen,
+    Comma,
     Function,
     Constant,
     Variable,
@@ -30,12 +34,32 @@ enum class tokenType{
 struct token {
     tokenType type; ///< Tipo del token
     std::string value; ///< Valor textual del token
+    int arity; ///< Cantidad de argumentos que espera (solo funciones; 0 en otro caso)
+    double number; ///< Valor ya convertido para Number y Constant; 0 en otro caso
     /**
      * @brief Constructor del token.
      * @param t Tipo del token.
      * @param v Valor textual del token.
+     * @param a Aridad de la función (0 si no es función).
+     * @param n Valor numérico (solo Number y Constant).
      */
-    token(tokenType t, const std::string& v) : type(t), value(v) {}
+    token(tokenType t, const std::string& v, int a = 0, double n = 0.0) : type(t), value(v), arity(a), number(n) {}
+};
+
+/**
+ * @struct tokenView
+ * @brief Token que no posee su texto: apunta directamente a la expresión original.
+ *
+ * Se usa en los caminos donde la misma expresión se vuelve a analizar muchas
+ * veces (por ejemplo, al editar en vivo) y no queremos reservar memoria por cada
+ * token. La vista solo es válida mientras la cadena original siga viva.
+ */
+struct tokenView {
+    tokenType type; ///< Tipo del token
+    int arity; ///< Cantidad de argumentos que espera (solo funciones; 0 en otro caso)
+    std::string_view text; ///< Fragmento de la expresión original que forma el token
+    std::size_t offset; ///< Posición (en bytes) del token dentro de la expresión
+    double number; ///< Valor ya convertido para Number y Constant; 0 en otro caso
 };
 
 #endif
\ No newline at end of file
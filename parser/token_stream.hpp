@@ -0,0 +1,76 @@
+/**
+ * @file token_stream.hpp
+ * @brief Lista de tokens empaquetada por columnas (structure of arrays).
+ *
+ * Un tokenView ocupa 40 bytes, de los que el parser casi siempre mira solo el
+ * tipo. Aquí cada token ocupa 9 bytes repartidos en columnas paralelas (tipo
+ * de 1 byte, posición y longitud de 32 bits) y los valores numéricos van a una
+ * tabla aparte, uno por cada Number o Constant en orden de aparición. Recorrer
+ * los tipos es leer bytes consecutivos, que es lo que mejor anticipa el
+ * prefetcher del procesador.
+ */
+#ifndef TOKEN_STREAM_HPP
+#define TOKEN_STREAM_HPP
+
+#include "token.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct tokenStream
+ * @brief Tokens de una expresión en columnas paralelas, apuntando a la expresión original.
+ *
+ * La expresión debe seguir viva mientras se use la lista.
+ */
+struct tokenStream {
+    std::string_view source; ///< Expresión analizada
+    std::pmr::vector<tokenType> types; ///< Tipo de cada token
+    std::pmr::vector<std::uint32_t> offsets; ///< Posición (en bytes) de cada token en source
+    std::pmr::vector<std::uint32_t> lengths; ///< Longitud (en bytes) de cada token
+    std::pmr::vector<double> numbers; ///< Valor de cada Number o Constant, en orden de aparición
+
+    explicit tokenStream(std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : types(memory), offsets(memory), lengths(memory), numbers(memory) {}
+
+    /**
+     * @brief Cantidad de tokens.
+     */
+    std::size_t size() const { return types.size(); }
+
+    bool empty() const { return types.empty(); }
+
+    /**
+     * @brief Texto del token i.
+     */
+    std::string_view text(std::size_t i) const { return std::string_view(source.data() + offsets[i], lengths[i]); }
+
+    /**
+     * @brief Reserva espacio para count tokens y, como estimación, para la mitad de números.
+     */
+    void reserve(std::size_t count) {
+        types.reserve(count);
+        offsets.reserve(count);
+        lengths.reserve(count);
+        numbers.reserve(count / 2 + 1);
+    }
+
+    /**
+     * @brief Agrega un token; así el lexer puede llenar la lista igual que un vector de tokenView.
+     *
+     * La posición y la longitud deben caber en 32 bits (lo comprueba tokenizePacked).
+     */
+    void push_back(const tokenView& view) {
+        types.push_back(view.type);
+        offsets.push_back(static_cast<std::uint32_t>(view.offset));
+        lengths.push_back(static_cast<std::uint32_t>(view.text.size()));
+        if (view.type == tokenType::Number || view.type == tokenType::Constant)
+        {
+            numbers.push_back(view.number);
+        }
+    }
+};
+
+#endif // TOKEN_STREAM_HPP
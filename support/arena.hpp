@@ -0,0 +1,47 @@
+/**
+ * @file arena.hpp
+ * @brief Arena de memoria con un bloque inicial propio, para datos de vida corta.
+ *
+ * Los tokens, nodos y tablas auxiliares de una compilación mueren todos a la
+ * vez. Con una arena se reservan de un solo bloque (normalmente en la pila) y
+ * liberarlos es volver el puntero al inicio, sin pasar por el asignador
+ * global ni competir con otros hilos por él.
+ */
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @class scratchArena
+ * @brief std::pmr::monotonic_buffer_resource con capacity bytes de almacenamiento interno.
+ *
+ * Si el bloque interno se agota, la arena pide bloques adicionales a upstream.
+ * No es segura para usarse desde varios hilos a la vez.
+ */
+template <std::size_t capacity>
+class scratchArena {
+public:
+    explicit scratchArena(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : resource(storage, capacity, upstream) {}
+
+    scratchArena(const scratchArena&) = delete;
+    scratchArena& operator=(const scratchArena&) = delete;
+
+    /**
+     * @brief Recurso para pasar a las funciones que aceptan std::pmr::memory_resource*.
+     */
+    std::pmr::memory_resource* get() { return &resource; }
+
+    /**
+     * @brief Libera todo lo reservado de una vez; lo reservado deja de ser válido.
+     */
+    void reset() { resource.release(); }
+
+private:
+    alignas(std::max_align_t) std::byte storage[capacity];
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+#endif // ARENA_HPP
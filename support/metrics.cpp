@@ -0,0 +1,211 @@
+/**
+ * @file metrics.cpp
+ * @brief Almacenamiento de los contadores y exportación en formato Prometheus.
+ */
+
+#include "metrics.hpp"
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+#ifdef PLOTSYS_METRICS
+
+/**
+ * @struct stageCounters
+ * @brief Contadores atómicos de una etapa, cada una en su propia línea de caché.
+ */
+struct alignas(64) stageCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> nanoseconds{0};
+    std::array<std::atomic<std::uint64_t>, latencyBucketCount + 1> latency{};
+};
+
+struct metricsStorage {
+    std::array<stageCounters, metricStageCount> stages;
+    alignas(64) std::atomic<std::uint64_t> tokens{0};
+    std::atomic<std::uint64_t> bytesScanned{0};
+    alignas(64) std::atomic<std::uint64_t> evaluations{0};
+    std::atomic<std::uint64_t> nanResults{0};
+    std::atomic<std::uint64_t> infResults{0};
+};
+
+metricsStorage& storage() {
+    static metricsStorage instance;
+    return instance;
+}
+
+/**
+ * @brief Tramo del histograma para una duración: el primero cuyo límite no es menor.
+ */
+std::size_t latencyBucket(std::uint64_t nanoseconds) {
+    if (nanoseconds <= latencyBucketBound(0))
+    {
+        return 0;
+    }
+    const std::size_t bucket = (static_cast<std::size_t>(std::bit_width(nanoseconds - 1)) - 7) / 2;
+    return bucket < latencyBucketCount ? bucket : latencyBucketCount;
+}
+
+#endif // PLOTSYS_METRICS
+
+void appendNumber(std::string& out, std::uint64_t value) {
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof buffer, value).ptr);
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof buffer, value).ptr);
+}
+
+void appendCounter(std::string& out, const char* name, const char* help, std::uint64_t value) {
+    out += "# HELP ";
+    out += name;
+    out += ' ';
+    out += help;
+    out += "\n# TYPE ";
+    out += name;
+    out += " counter\n";
+    out += name;
+    out += ' ';
+    appendNumber(out, value);
+    out += '\n';
+}
+
+} // namespace
+
+#ifdef PLOTSYS_METRICS
+
+void recordStage(metricStage stage, std::uint64_t nanoseconds) {
+    stageCounters& counters = storage().stages[static_cast<std::size_t>(stage)];
+    counters.calls.fetch_add(1, std::memory_order_relaxed);
+    counters.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    counters.latency[latencyBucket(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void recordLexed(std::size_t tokens, std::size_t bytes) {
+    storage().tokens.fetch_add(tokens, std::memory_order_relaxed);
+    storage().bytesScanned.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void recordEvaluated(std::span<const double> results) {
+    std::uint64_t nans = 0;
+    std::uint64_t infinities = 0;
+    for (double value : results)
+    {
+        nans += std::isnan(value);
+        infinities += std::isinf(value);
+    }
+    metricsStorage& counters = storage();
+    counters.evaluations.fetch_add(results.size(), std::memory_order_relaxed);
+    if (nans != 0)
+    {
+        counters.nanResults.fetch_add(nans, std::memory_order_relaxed);
+    }
+    if (infinities != 0)
+    {
+        counters.infResults.fetch_add(infinities, std::memory_order_relaxed);
+    }
+}
+
+#endif // PLOTSYS_METRICS
+
+const char* stageName(metricStage stage) {
+    switch (stage)
+    {
+    case metricStage::Lex: return "lex";
+    case metricStage::Parse: return "parse";
+    case metricStage::Optimize: return "optimize";
+    case metricStage::Compile: return "compile";
+    case metricStage::Evaluate: return "evaluate";
+    }
+    return "unknown";
+}
+
+metricsSnapshot snapshotMetrics() {
+    metricsSnapshot snapshot;
+#ifdef PLOTSYS_METRICS
+    const metricsStorage& counters = storage();
+    for (std::size_t s = 0; s < metricStageCount; s++)
+    {
+        snapshot.stages[s].calls = counters.stages[s].calls.load(std::memory_order_relaxed);
+        snapshot.stages[s].nanoseconds = counters.stages[s].nanoseconds.load(std::memory_order_relaxed);
+        for (std::size_t b = 0; b <= latencyBucketCount; b++)
+        {
+            snapshot.stages[s].latency[b] = counters.stages[s].latency[b].load(std::memory_order_relaxed);
+        }
+    }
+    snapshot.tokens = counters.tokens.load(std::memory_order_relaxed);
+    snapshot.bytesScanned = counters.bytesScanned.load(std::memory_order_relaxed);
+    snapshot.evaluations = counters.evaluations.load(std::memory_order_relaxed);
+    snapshot.nanResults = counters.nanResults.load(std::memory_order_relaxed);
+    snapshot.infResults = counters.infResults.load(std::memory_order_relaxed);
+#endif
+    return snapshot;
+}
+
+void resetMetrics() {
+#ifdef PLOTSYS_METRICS
+    metricsStorage& counters = storage();
+    for (stageCounters& stage : counters.stages)
+    {
+        stage.calls.store(0, std::memory_order_relaxed);
+        stage.nanoseconds.store(0, std::memory_order_relaxed);
+        for (std::atomic<std::uint64_t>& bucket : stage.latency)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    counters.tokens.store(0, std::memory_order_relaxed);
+    counters.bytesScanned.store(0, std::memory_order_relaxed);
+    counters.evaluations.store(0, std::memory_order_relaxed);
+    counters.nanResults.store(0, std::memory_order_relaxed);
+    counters.infResults.store(0, std::memory_order_relaxed);
+#endif
+}
+
+std::string formatPrometheus(const metricsSnapshot& snapshot) {
+    std::string out;
+    out += "# HELP plotsys_stage_duration_seconds Duración de cada llamada por etapa.\n";
+    out += "# TYPE plotsys_stage_duration_seconds histogram\n";
+    for (std::size_t s = 0; s < metricStageCount; s++)
+    {
+        const stageMetrics& stage = snapshot.stages[s];
+        const std::string label = std::string("{stage=\"") + stageName(static_cast<metricStage>(s)) + "\"";
+
+        // Prometheus espera tramos acumulados.
+        std::uint64_t cumulative = 0;
+        for (std::size_t b = 0; b < latencyBucketCount; b++)
+        {
+            cumulative += stage.latency[b];
+            out += "plotsys_stage_duration_seconds_bucket" + label + ",le=\"";
+            appendNumber(out, static_cast<double>(latencyBucketBound(b)) * 1e-9);
+            out += "\"} ";
+            appendNumber(out, cumulative);
+            out += '\n';
+        }
+        out += "plotsys_stage_duration_seconds_bucket" + label + ",le=\"+Inf\"} ";
+        appendNumber(out, stage.calls);
+        out += "\nplotsys_stage_duration_seconds_sum" + label + "} ";
+        appendNumber(out, static_cast<double>(stage.nanoseconds) * 1e-9);
+        out += "\nplotsys_stage_duration_seconds_count" + label + "} ";
+        appendNumber(out, stage.calls);
+        out += '\n';
+    }
+
+    appendCounter(out, "plotsys_tokens_total", "Tokens producidos por el lexer.", snapshot.tokens);
+    appendCounter(out, "plotsys_scanned_bytes_total", "Caracteres analizados por el lexer.", snapshot.bytesScanned);
+    appendCounter(out, "plotsys_evaluations_total", "Muestras evaluadas.", snapshot.evaluations);
+
+    out += "# HELP plotsys_nonfinite_results_total Resultados NaN o infinitos.\n";
+    out += "# TYPE plotsys_nonfinite_results_total counter\n";
+    out += "plotsys_nonfinite_results_total{kind=\"nan\"} ";
+    appendNumber(out, snapshot.nanResults);
+    out += "\nplotsys_nonfinite_results_total{kind=\"inf\"} ";
+    appendNumber(out, snapshot.infResults);
+    out += '\n';
+    return out;
+}
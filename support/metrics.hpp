@@ -0,0 +1,168 @@
+/**
+ * @file metrics.hpp
+ * @brief Contadores y tiempos por etapa (lexer, parser, optimizador, compilador, evaluador).
+ *
+ * La instrumentación solo existe si se compila con PLOTSYS_METRICS (opción
+ * de CMake del mismo nombre). Sin ella, stageTimer y las funciones record*
+ * son vacías y el compilador las elimina, así que pueden quedar en el código
+ * de producción sin costo. snapshotMetrics() y formatPrometheus() existen
+ * siempre; sin instrumentación devuelven todo en cero.
+ *
+ * Los contadores son atómicos globales con orden relajado: una instantánea
+ * tomada mientras otros hilos trabajan es aproximada, pero nunca inválida.
+ */
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#ifdef PLOTSYS_METRICS
+#include <chrono>
+#endif
+
+/**
+ * @enum metricStage
+ * @brief Etapas medidas por separado.
+ */
+enum class metricStage : std::uint8_t {
+    Lex, ///< Análisis léxico (completo o incremental)
+    Parse, ///< Análisis sintáctico
+    Optimize, ///< Simplificación del árbol
+    Compile, ///< Generación de bytecode
+    Evaluate, ///< Evaluación por lotes (intérprete o JIT)
+};
+
+/// Cantidad de etapas.
+constexpr std::size_t metricStageCount = 5;
+
+/// Límites del histograma de duración: 256 ns * 4^b para b en [0, latencyBucketCount).
+constexpr std::size_t latencyBucketCount = 12;
+
+/**
+ * @brief Límite superior en nanosegundos del tramo b del histograma.
+ */
+constexpr std::uint64_t latencyBucketBound(std::size_t bucket) {
+    return std::uint64_t(256) << (2 * bucket);
+}
+
+/**
+ * @struct stageMetrics
+ * @brief Llamadas, tiempo total e histograma de duración de una etapa.
+ */
+struct stageMetrics {
+    std::uint64_t calls = 0; ///< Veces que se ejecutó la etapa
+    std::uint64_t nanoseconds = 0; ///< Tiempo total
+    /// Llamadas por tramo de duración (no acumulado); el último tramo es "mayor que todos los límites".
+    std::array<std::uint64_t, latencyBucketCount + 1> latency{};
+};
+
+/**
+ * @struct metricsSnapshot
+ * @brief Copia de todos los contadores en un momento dado.
+ */
+struct metricsSnapshot {
+    std::array<stageMetrics, metricStageCount> stages{}; ///< Indexado por metricStage
+    std::uint64_t tokens = 0; ///< Tokens producidos por el lexer
+    std::uint64_t bytesScanned = 0; ///< Caracteres analizados por el lexer
+    std::uint64_t evaluations = 0; ///< Muestras evaluadas
+    std::uint64_t nanResults = 0; ///< Resultados NaN
+    std::uint64_t infResults = 0; ///< Resultados infinitos
+
+    const stageMetrics& stage(metricStage which) const { return stages[static_cast<std::size_t>(which)]; }
+};
+
+/**
+ * @brief Indica si esta compilación incluye la instrumentación.
+ */
+constexpr bool metricsEnabled() {
+#ifdef PLOTSYS_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Nombre de la etapa en minúsculas, como aparece en la exportación.
+ */
+const char* stageName(metricStage stage);
+
+/**
+ * @brief Copia los contadores actuales.
+ */
+metricsSnapshot snapshotMetrics();
+
+/**
+ * @brief Pone todos los contadores en cero.
+ */
+void resetMetrics();
+
+/**
+ * @brief Exporta una instantánea en el formato de texto de Prometheus.
+ *
+ * Las duraciones se exportan como el histograma plotsys_stage_duration_seconds
+ * con la etiqueta stage; el resto, como contadores plotsys_*_total.
+ *
+ * @param snapshot Instantánea a exportar.
+ * @return std::string Texto listo para servir en /metrics.
+ */
+std::string formatPrometheus(const metricsSnapshot& snapshot);
+
+#ifdef PLOTSYS_METRICS
+
+/**
+ * @brief Suma una llamada de la duración dada a la etapa.
+ */
+void recordStage(metricStage stage, std::uint64_t nanoseconds);
+
+/**
+ * @brief Suma tokens producidos y caracteres analizados.
+ */
+void recordLexed(std::size_t tokens, std::size_t bytes);
+
+/**
+ * @brief Suma las muestras evaluadas y cuenta cuántas no son finitas.
+ */
+void recordEvaluated(std::span<const double> results);
+
+/**
+ * @class stageTimer
+ * @brief Mide el tiempo desde su creación hasta su destrucción y lo suma a una etapa.
+ */
+class stageTimer {
+public:
+    explicit stageTimer(metricStage stage) : stage(stage), start(std::chrono::steady_clock::now()) {}
+
+    ~stageTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        recordStage(stage, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    stageTimer(const stageTimer&) = delete;
+    stageTimer& operator=(const stageTimer&) = delete;
+
+private:
+    metricStage stage;
+    std::chrono::steady_clock::time_point start;
+};
+
+#else
+
+inline void recordStage(metricStage, std::uint64_t) {}
+inline void recordLexed(std::size_t, std::size_t) {}
+inline void recordEvaluated(std::span<const double>) {}
+
+class stageTimer {
+public:
+    explicit stageTimer(metricStage) {}
+    stageTimer(const stageTimer&) = delete;
+    stageTimer& operator=(const stageTimer&) = delete;
+};
+
+#endif // PLOTSYS_METRICS
+
+#endif // METRICS_HPP
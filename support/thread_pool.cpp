@@ -0,0 +1,197 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Implementación del grupo de hilos con robo de trabajo.
+ */
+
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace {
+
+/**
+ * @struct taskGroup
+ * @brief Contador de tareas pendientes de un parallelFor y primera excepción.
+ */
+struct taskGroup {
+    std::atomic<std::size_t> remaining;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    explicit taskGroup(std::size_t count) : remaining(count) {}
+};
+
+/// Índice de la cola propia del hilo actual (los hilos externos usan la última).
+thread_local std::size_t currentQueue = static_cast<std::size_t>(-1);
+
+} // namespace
+
+threadPool::threadPool(std::size_t threads) {
+    if (threads == 0)
+    {
+        threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (std::size_t i = 0; i <= threads; i++)
+    {
+        queues.push_back(std::make_unique<taskQueue>());
+    }
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++)
+    {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+threadPool::~threadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+threadPool& threadPool::shared() {
+    static threadPool pool;
+    return pool;
+}
+
+/**
+ * @brief Toma una tarea: primero del frente de la cola propia, luego del fondo de otra.
+ */
+bool threadPool::takeTask(std::size_t home, std::function<void()>& task) {
+    {
+        taskQueue& own = *queues[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+    for (std::size_t offset = 1; offset < queues.size(); offset++)
+    {
+        taskQueue& victim = *queues[(home + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.back());
+            victim.tasks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool threadPool::runOne(std::size_t home) {
+    std::function<void()> task;
+    if (!takeTask(home, task))
+    {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending--;
+    }
+    task();
+    return true;
+}
+
+void threadPool::workerLoop(std::size_t index) {
+    currentQueue = index;
+    while (true)
+    {
+        if (runOne(index))
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || pending > 0; });
+        if (stopping && pending == 0)
+        {
+            return;
+        }
+    }
+}
+
+void threadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0)
+    {
+        return;
+    }
+    if (count == 1 || workers.empty())
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    taskGroup group(count);
+    auto runTask = [&group, &body](std::size_t i) {
+        try
+        {
+            body(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(group.mutex);
+            if (!group.error)
+            {
+                group.error = std::current_exception();
+            }
+        }
+        // El descuento se hace con el candado tomado: así quien espera no puede
+        // destruir el grupo mientras esta tarea todavía lo está tocando.
+        std::lock_guard<std::mutex> lock(group.mutex);
+        if (--group.remaining == 0)
+        {
+            group.done.notify_all();
+        }
+    };
+
+    // Cada cola recibe un bloque contiguo de índices, para que cada hilo
+    // recorra la memoria en orden mientras nadie necesite robarle.
+    const std::size_t queueCount = queues.size();
+    for (std::size_t q = 0; q < queueCount; q++)
+    {
+        const std::size_t begin = count * q / queueCount;
+        const std::size_t end = count * (q + 1) / queueCount;
+        if (begin == end)
+        {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (std::size_t i = begin; i < end; i++)
+        {
+            queues[q]->tasks.emplace_back([&runTask, i] { runTask(i); });
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending += count;
+    }
+    wakeUp.notify_all();
+
+    // Quien llama ayuda hasta que no quede nada por tomar y luego espera al resto.
+    const std::size_t home = currentQueue < queueCount ? currentQueue : queueCount - 1;
+    while (group.remaining.load() > 0 && runOne(home))
+    {
+    }
+    {
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.done.wait(lock, [&group] { return group.remaining.load() == 0; });
+    }
+
+    if (group.error)
+    {
+        std::rethrow_exception(group.error);
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file thread_pool.hpp
+ * @brief Grupo de hilos con robo de trabajo (work stealing) para tareas en paralelo.
+ *
+ * Cada hilo tiene su propia cola de tareas. Un hilo toma primero de su cola
+ * y, cuando se vacía, roba del extremo opuesto de la cola de otro hilo. Así,
+ * si unas tareas resultan mucho más caras que otras (ramas costosas, zonas
+ * llenas de NaN), los hilos que terminan antes ayudan a los demás.
+ */
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class threadPool
+ * @brief Hilos de trabajo reutilizables con colas individuales y robo de tareas.
+ */
+class threadPool {
+public:
+    /**
+     * @brief Crea el grupo de hilos.
+     * @param threads Cantidad de hilos de trabajo (0 = uno por núcleo).
+     */
+    explicit threadPool(std::size_t threads = 0);
+
+    /**
+     * @brief Espera a que terminen los hilos. No debe haber parallelFor en curso.
+     */
+    ~threadPool();
+
+    threadPool(const threadPool&) = delete;
+    threadPool& operator=(const threadPool&) = delete;
+
+    /**
+     * @brief Cantidad de hilos de trabajo.
+     */
+    std::size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Ejecuta body(i) para cada i en [0, count) y espera a que terminen todos.
+     *
+     * El hilo que llama también ejecuta tareas mientras espera, por lo que se
+     * puede llamar desde dentro de otra tarea. Si alguna tarea lanza una
+     * excepción, las demás terminan igual y luego se relanza la primera.
+     *
+     * @param count Cantidad de tareas.
+     * @param body Función a ejecutar con el índice de cada tarea.
+     */
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    /**
+     * @brief Grupo de hilos compartido por defecto (uno por núcleo), creado al primer uso.
+     */
+    static threadPool& shared();
+
+private:
+    struct taskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<taskQueue>> queues; ///< Una cola por hilo más una para quien llama
+    std::vector<std::thread> workers;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::size_t pending = 0; ///< Tareas encoladas aún no tomadas (protegido por sleepMutex)
+    bool stopping = false;
+
+    void workerLoop(std::size_t index);
+    bool runOne(std::size_t home);
+    bool takeTask(std::size_t home, std::function<void()>& task);
+};
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,290 @@
+/**
+ * @file adaptive_sampler.cpp
+ * @brief Implementación del muestreo adaptativo por niveles.
+ *
+ * Los segmentos se refinan en anchura (todos los de un nivel a la vez) en
+ * lugar de con recursión, para que cada nivel sea una sola evaluación por
+ * lotes de todos sus puntos medios.
+ */
+
+#include "adaptive_sampler.hpp"
+#include "../evaluator/derivative.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Pasos de bisección con los que se examina un posible salto.
+constexpr int probeSteps = 12;
+
+/// Saltos (en píxeles) a partir de los cuales un segmento mínimo se examina.
+constexpr double suspectJump = 4.0;
+
+/// Fracción del salto original que debe sobrevivir a la bisección para considerarlo discontinuidad.
+constexpr double breakRatio = 0.125;
+
+struct segment {
+    double x0, y0; ///< Extremo izquierdo
+    double x1, y1; ///< Extremo derecho
+    int depth; ///< Subdivisiones desde la malla inicial
+    bool done; ///< Ya no necesita refinarse
+    bool suspect; ///< Llegó a la resolución mínima con un salto grande
+    double d0 = 0.0; ///< Pendiente en el extremo izquierdo (solo con derivadas)
+    double d1 = 0.0; ///< Pendiente en el extremo derecho (solo con derivadas)
+};
+
+/**
+ * @struct probe
+ * @brief Bisección en curso sobre un segmento sospechoso.
+ */
+struct probe {
+    std::size_t index; ///< Segmento examinado
+    double lx, ly; ///< Extremo izquierdo del subintervalo con mayor salto
+    double rx, ry; ///< Extremo derecho
+};
+
+double jump(double a, double b) {
+    if (!std::isfinite(a) || !std::isfinite(b))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::fabs(b - a);
+}
+
+void evaluateColumn(const bytecodeProgram& program, const std::vector<double>& xs, std::vector<double>& ys) {
+    ys.resize(xs.size());
+    variableInputs inputs;
+    inputs.x = xs;
+    evaluateBatch(program, inputs, ys);
+}
+
+/**
+ * @brief Evalúa f y, si se pidieron derivadas, también f' en la misma pasada.
+ */
+void evaluateColumn(const bytecodeProgram& program, const std::vector<double>& xs, std::vector<double>& ys, std::vector<double>& slopes,
+    bool derivatives) {
+    if (!derivatives)
+    {
+        evaluateColumn(program, xs, ys);
+        return;
+    }
+    ys.resize(xs.size());
+    slopes.resize(xs.size());
+    variableInputs inputs;
+    inputs.x = xs;
+    evaluateDerivative(program, inputs, 0, ys, slopes);
+}
+
+/**
+ * @brief Indica si las pendientes de los extremos garantizan que la recta basta.
+ *
+ * La cúbica de Hermite con esas pendientes se aparta de la recta a lo sumo
+ * (x1 - x0) / 4 * max(|d0 - m|, |d1 - m|), con m la pendiente de la recta.
+ */
+bool flatBySlopes(const segment& s, double tolerance) {
+    if (!std::isfinite(s.y0) || !std::isfinite(s.y1) || !std::isfinite(s.d0) || !std::isfinite(s.d1))
+    {
+        return false;
+    }
+    const double width = s.x1 - s.x0;
+    const double chord = (s.y1 - s.y0) / width;
+    return 0.25 * width * std::max(std::fabs(s.d0 - chord), std::fabs(s.d1 - chord)) <= tolerance;
+}
+
+/**
+ * @brief Decide qué hacer con un segmento dado el valor en su punto medio.
+ *
+ * Con derivadas, el punto medio no basta para aceptar: las mitades se
+ * aceptan (o no) por sus pendientes en el nivel siguiente.
+ *
+ * @return bool true si el segmento se dividió en dos mitades pendientes.
+ */
+bool refine(const segment& s, double middle, double value, double slope, bool derivatives, bool canSplit, double tolerance,
+    std::vector<segment>& next) {
+    segment left{s.x0, s.y0, middle, value, s.depth + 1, false, false, s.d0, slope};
+    segment right{middle, value, s.x1, s.y1, s.depth + 1, false, false, slope, s.d1};
+
+    const bool finite0 = std::isfinite(s.y0);
+    const bool finite1 = std::isfinite(s.y1);
+    const bool finiteMiddle = std::isfinite(value);
+
+    bool accepted = false;
+    if (finite0 && finite1 && finiteMiddle)
+    {
+        // Error de la recta respecto a la curva en el punto medio (segunda diferencia).
+        accepted = !derivatives && std::fabs(value - 0.5 * (s.y0 + s.y1)) <= tolerance;
+    }
+    else if (!finite0 && !finite1 && !finiteMiddle)
+    {
+        accepted = true; // Todo fuera del dominio: nada que dibujar
+    }
+
+    if (accepted || !canSplit)
+    {
+        left.done = right.done = true;
+        if (!accepted)
+        {
+            left.suspect = jump(left.y0, left.y1) > suspectJump * tolerance;
+            right.suspect = jump(right.y0, right.y1) > suspectJump * tolerance;
+        }
+    }
+    next.push_back(left);
+    next.push_back(right);
+    return !left.done;
+}
+
+} // namespace
+
+std::vector<plotPoint> sampleAdaptive(const bytecodeProgram& program, double start, double end, const samplingOptions& options) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden muestrear funciones de x.");
+    }
+    if (!(options.pixelWidth > 0.0) || !(options.pixelHeight > 0.0) || !(start < end) || options.initialSamples == 0)
+    {
+        throw std::runtime_error("[Tabulation Error]: El intervalo y las tolerancias deben ser positivos.");
+    }
+
+    // Malla inicial uniforme.
+    std::vector<double> xs(options.initialSamples + 1);
+    for (std::size_t i = 0; i <= options.initialSamples; i++)
+    {
+        xs[i] = i == options.initialSamples ? end : start + (end - start) * static_cast<double>(i) / static_cast<double>(options.initialSamples);
+    }
+    std::vector<double> ys, slopes;
+    evaluateColumn(program, xs, ys, slopes, options.derivatives);
+
+    std::vector<segment> segments;
+    segments.reserve(options.initialSamples);
+    for (std::size_t i = 0; i < options.initialSamples; i++)
+    {
+        segments.push_back({xs[i], ys[i], xs[i + 1], ys[i + 1], 0, false, false});
+        if (options.derivatives)
+        {
+            segments.back().d0 = slopes[i];
+            segments.back().d1 = slopes[i + 1];
+        }
+    }
+
+    // Refinamiento por niveles: cada nivel evalúa en lote los puntos medios pendientes.
+    // points cuenta los puntos evaluados más los puntos medios ya prometidos a
+    // segmentos pendientes, así cada división se concede solo si cabe.
+    std::vector<segment> next;
+    std::size_t points = 2 * segments.size() + 1;
+    while (true)
+    {
+        xs.clear();
+        for (segment& s : segments)
+        {
+            if (!s.done && options.derivatives && flatBySlopes(s, options.pixelHeight))
+            {
+                s.done = true; // Aceptado por las pendientes, sin evaluar el punto medio
+                points--;
+            }
+            if (!s.done)
+            {
+                xs.push_back(0.5 * (s.x0 + s.x1));
+            }
+        }
+        if (xs.empty())
+        {
+            break;
+        }
+        evaluateColumn(program, xs, ys, slopes, options.derivatives);
+
+        next.clear();
+        std::size_t pending = 0;
+        for (const segment& s : segments)
+        {
+            if (s.done)
+            {
+                next.push_back(s);
+                continue;
+            }
+            const double middle = xs[pending];
+            const double value = ys[pending];
+            const double slope = options.derivatives ? slopes[pending] : 0.0;
+            pending++;
+
+            const bool canSplit = 0.5 * (s.x1 - s.x0) >= options.pixelWidth && s.depth + 1 < options.maxDepth && points + 2 <= options.maxPoints;
+            if (refine(s, middle, value, slope, options.derivatives, canSplit, options.pixelHeight, next))
+            {
+                points += 2;
+            }
+        }
+        segments.swap(next);
+    }
+
+    // Los segmentos sospechosos se examinan con bisección, todos a la vez.
+    std::vector<probe> probes;
+    for (std::size_t i = 0; i < segments.size(); i++)
+    {
+        if (segments[i].suspect)
+        {
+            const segment& s = segments[i];
+            probes.push_back({i, s.x0, s.y0, s.x1, s.y1});
+        }
+    }
+    for (int step = 0; step < probeSteps && !probes.empty(); step++)
+    {
+        xs.resize(probes.size());
+        for (std::size_t p = 0; p < probes.size(); p++)
+        {
+            xs[p] = 0.5 * (probes[p].lx + probes[p].rx);
+        }
+        evaluateColumn(program, xs, ys);
+        for (std::size_t p = 0; p < probes.size(); p++)
+        {
+            probe& current = probes[p];
+            if (jump(current.ly, ys[p]) >= jump(ys[p], current.ry))
+            {
+                current.rx = xs[p];
+                current.ry = ys[p];
+            }
+            else
+            {
+                current.lx = xs[p];
+                current.ly = ys[p];
+            }
+        }
+    }
+
+    std::vector<std::size_t> breakOf(segments.size(), probes.size());
+    for (std::size_t p = 0; p < probes.size(); p++)
+    {
+        const segment& s = segments[probes[p].index];
+        if (jump(probes[p].ly, probes[p].ry) > breakRatio * jump(s.y0, s.y1))
+        {
+            breakOf[probes[p].index] = p;
+        }
+    }
+
+    // Poligonal final: extremos de cada segmento y cortes en las discontinuidades.
+    std::vector<plotPoint> result;
+    result.reserve(segments.size() + 1 + 3 * probes.size());
+    auto append = [&result](double x, double y) {
+        // Una racha de puntos no finitos equivale a un solo corte.
+        if (!std::isfinite(y) && !result.empty() && !std::isfinite(result.back().y))
+        {
+            return;
+        }
+        result.push_back({x, y});
+    };
+    for (std::size_t i = 0; i < segments.size(); i++)
+    {
+        const segment& s = segments[i];
+        append(s.x0, s.y0);
+        if (breakOf[i] < probes.size())
+        {
+            const probe& located = probes[breakOf[i]];
+            append(located.lx, located.ly);
+            append(0.5 * (located.lx + located.rx), std::numeric_limits<double>::quiet_NaN());
+            append(located.rx, located.ry);
+        }
+    }
+    append(segments.back().x1, segments.back().y1);
+    return result;
+}
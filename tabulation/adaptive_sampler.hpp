@@ -0,0 +1,68 @@
+/**
+ * @file adaptive_sampler.hpp
+ * @brief Muestreo adaptativo de f(x) para graficar con la resolución de la pantalla.
+ *
+ * En lugar de una malla uniforme, el intervalo se subdivide solo donde la
+ * poligonal se aleja de la curva más de lo que se vería en pantalla (zonas
+ * curvas, pendientes fuertes) o donde hay discontinuidades, como los polos
+ * de tan, sec, csc y cot. Las zonas suaves quedan con pocas muestras.
+ */
+#ifndef ADAPTIVE_SAMPLER_HPP
+#define ADAPTIVE_SAMPLER_HPP
+
+#include "../evaluator/program.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct samplingOptions
+ * @brief Tolerancias del muestreo adaptativo, expresadas en unidades de la gráfica.
+ */
+struct samplingOptions {
+    double pixelWidth; ///< Ancho de un píxel en unidades de x: no se subdivide por debajo
+    double pixelHeight; ///< Alto de un píxel en unidades de y: desviación máxima tolerada
+    std::size_t initialSamples = 64; ///< Segmentos de la malla inicial uniforme
+    int maxDepth = 20; ///< Máximas subdivisiones por segmento de la malla inicial
+    std::size_t maxPoints = 1u << 18; ///< Puntos evaluados al refinar (la malla inicial y sus puntos medios van siempre); la poligonal tiene a lo sumo estos más 3 por discontinuidad
+    bool derivatives = false; ///< Usa f'(x) (diferenciación automática) para aceptar segmentos sin evaluar su punto medio
+};
+
+/**
+ * @struct plotPoint
+ * @brief Un vértice de la poligonal a dibujar.
+ *
+ * Un punto con y no finito (NaN o infinito) indica que la poligonal se corta
+ * ahí: una discontinuidad, un polo o una zona fuera del dominio.
+ */
+struct plotPoint {
+    double x;
+    double y;
+};
+
+/**
+ * @brief Muestrea f(x) en [start, end] refinando solo donde hace falta.
+ *
+ * Cada nivel de refinamiento evalúa los puntos medios de todos los
+ * segmentos pendientes en un solo lote. Un segmento se da por bueno cuando
+ * su punto medio está a menos de pixelHeight de la recta entre sus extremos.
+ * Los segmentos que llegan a pixelWidth con un salto grande se examinan
+ * con bisección: si el salto no se reduce, es una discontinuidad y se
+ * inserta un punto con y = NaN en la posición localizada.
+ *
+ * Con options.derivatives, cada evaluación calcula también f'(x) en la misma
+ * pasada. Un segmento se acepta sin evaluar su punto medio si las pendientes
+ * de sus extremos acotan la desviación de la cúbica de Hermite respecto a la
+ * recta por debajo de pixelHeight, y no se acepta nunca si las pendientes
+ * contradicen la recta aunque el punto medio caiga sobre ella (una
+ * oscilación muestreada justo en su período).
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param start Inicio del intervalo visible.
+ * @param end Fin del intervalo visible.
+ * @param options Resolución de la pantalla y límites de refinamiento.
+ * @return std::vector<plotPoint> Vértices ordenados por x.
+ * @throws std::runtime_error Si el programa usa y o z, el intervalo está vacío o las tolerancias no son positivas.
+ */
+std::vector<plotPoint> sampleAdaptive(const bytecodeProgram& program, double start, double end, const samplingOptions& options);
+
+#endif // ADAPTIVE_SAMPLER_HPP
@@ -0,0 +1,90 @@
+/**
+ * @file column_file.cpp
+ * @brief Codificación y validación de la cabecera del formato por columnas.
+ */
+
+#include "column_file.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+/// Firma al inicio de todo archivo de columnas.
+constexpr char columnFileMagic[8] = {'P', 'L', 'O', 'T', 'C', 'O', 'L', 'S'};
+
+void putLittle(unsigned char* out, std::uint64_t value, std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; i++)
+    {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint64_t getLittle(const unsigned char* in, std::size_t bytes) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < bytes; i++)
+    {
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+columnFileHeader makeColumnHeader(std::span<const std::string_view> names, std::uint64_t rowCount) {
+    if (names.empty() || names.size() > maxColumns)
+    {
+        throw std::runtime_error("[Tabulation Error]: Cantidad de columnas no soportada.");
+    }
+    columnFileHeader header;
+    header.columnCount = static_cast<std::uint32_t>(names.size());
+    header.rowCount = rowCount;
+    for (std::size_t c = 0; c < names.size(); c++)
+    {
+        if (names[c].size() > columnNameLength)
+        {
+            throw std::runtime_error("[Tabulation Error]: Nombre de columna demasiado largo.");
+        }
+        std::memcpy(header.names[c].data(), names[c].data(), names[c].size());
+    }
+    return header;
+}
+
+/**
+ * @brief Codifica la cabecera: firma, versión (4 bytes), columnas (4), filas (8) y nombres.
+ */
+std::array<unsigned char, columnFileHeaderSize> encodeColumnHeader(const columnFileHeader& header) {
+    std::array<unsigned char, columnFileHeaderSize> bytes{};
+    std::memcpy(bytes.data(), columnFileMagic, sizeof columnFileMagic);
+    putLittle(bytes.data() + 8, header.version, 4);
+    putLittle(bytes.data() + 12, header.columnCount, 4);
+    putLittle(bytes.data() + 16, header.rowCount, 8);
+    for (std::size_t c = 0; c < maxColumns; c++)
+    {
+        std::memcpy(bytes.data() + 24 + c * columnNameLength, header.names[c].data(), columnNameLength);
+    }
+    return bytes;
+}
+
+columnFileHeader decodeColumnHeader(std::span<const unsigned char> bytes) {
+    if (bytes.size() < columnFileHeaderSize || std::memcmp(bytes.data(), columnFileMagic, sizeof columnFileMagic) != 0)
+    {
+        throw std::runtime_error("[Tabulation Error]: El archivo no es una tabla por columnas.");
+    }
+    columnFileHeader header;
+    header.version = static_cast<std::uint32_t>(getLittle(bytes.data() + 8, 4));
+    header.columnCount = static_cast<std::uint32_t>(getLittle(bytes.data() + 12, 4));
+    header.rowCount = getLittle(bytes.data() + 16, 8);
+    if (header.version != columnFileVersion)
+    {
+        throw std::runtime_error("[Tabulation Error]: Versión de tabla por columnas no soportada.");
+    }
+    if (header.columnCount == 0 || header.columnCount > maxColumns || header.rowCount > (UINT64_MAX - columnFileHeaderSize) / (sizeof(double) * maxColumns))
+    {
+        throw std::runtime_error("[Tabulation Error]: Cabecera de tabla por columnas inválida.");
+    }
+    for (std::size_t c = 0; c < maxColumns; c++)
+    {
+        std::memcpy(header.names[c].data(), bytes.data() + 24 + c * columnNameLength, columnNameLength);
+    }
+    return header;
+}
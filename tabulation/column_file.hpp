@@ -0,0 +1,108 @@
+/**
+ * @file column_file.hpp
+ * @brief Formato binario por columnas para tablas de muestras.
+ *
+ * Disposición del archivo (todo en little-endian):
+ * - Cabecera de columnFileHeaderSize (64) bytes: firma "PLOTCOLS", versión,
+ *   cantidad de columnas, cantidad de filas y el nombre de cada columna.
+ * - Cada columna completa, una tras otra: rowCount doubles contiguos.
+ *
+ * La columna c empieza en columnFileHeaderSize + c * rowCount * 8, siempre
+ * alineada a 8 bytes, por lo que un archivo mapeado en memoria se puede leer
+ * directamente como arreglos de double.
+ */
+#ifndef COLUMN_FILE_HPP
+#define COLUMN_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/// Tamaño fijo de la cabecera en bytes.
+constexpr std::size_t columnFileHeaderSize = 64;
+
+/// Versión del formato que se escribe y que se sabe leer.
+constexpr std::uint32_t columnFileVersion = 1;
+
+/// Cantidad máxima de columnas (x, y, z y el resultado).
+constexpr std::size_t maxColumns = 4;
+
+/// Longitud máxima del nombre de una columna.
+constexpr std::size_t columnNameLength = 8;
+
+/**
+ * @struct columnFileHeader
+ * @brief Contenido de la cabecera ya decodificado.
+ */
+struct columnFileHeader {
+    std::uint32_t version = columnFileVersion; ///< Versión del formato
+    std::uint32_t columnCount = 0; ///< Columnas guardadas (1 a maxColumns)
+    std::uint64_t rowCount = 0; ///< Filas de cada columna
+    std::array<std::array<char, columnNameLength>, maxColumns> names{}; ///< Nombres, rellenos con '\0'
+
+    /**
+     * @brief Nombre de la columna c sin el relleno.
+     */
+    std::string_view name(std::size_t c) const {
+        const std::array<char, columnNameLength>& raw = names[c];
+        std::size_t length = 0;
+        while (length < columnNameLength && raw[length] != '\0')
+        {
+            length++;
+        }
+        return std::string_view(raw.data(), length);
+    }
+
+    /**
+     * @brief Posición en bytes del primer valor de la columna c.
+     */
+    std::uint64_t columnOffset(std::size_t c) const {
+        return columnFileHeaderSize + c * rowCount * sizeof(double);
+    }
+
+    /**
+     * @brief Tamaño total del archivo en bytes.
+     */
+    std::uint64_t fileSize() const {
+        return columnOffset(columnCount);
+    }
+};
+
+/**
+ * @brief Crea la cabecera de una tabla con las columnas dadas.
+ *
+ * @param names Nombre de cada columna (como mucho columnNameLength caracteres).
+ * @param rowCount Filas de cada columna.
+ * @return columnFileHeader Cabecera lista para codificar.
+ * @throws std::runtime_error Si hay demasiadas columnas o algún nombre es muy largo.
+ */
+columnFileHeader makeColumnHeader(std::span<const std::string_view> names, std::uint64_t rowCount);
+
+/**
+ * @brief Codifica la cabecera tal como se guarda en el archivo.
+ */
+std::array<unsigned char, columnFileHeaderSize> encodeColumnHeader(const columnFileHeader& header);
+
+/**
+ * @brief Decodifica y valida la cabecera al inicio de un archivo.
+ *
+ * @param bytes Primeros bytes del archivo (al menos columnFileHeaderSize).
+ * @return columnFileHeader Cabecera decodificada.
+ * @throws std::runtime_error Si la firma, la versión o la cantidad de columnas no son válidas.
+ */
+columnFileHeader decodeColumnHeader(std::span<const unsigned char> bytes);
+
+/**
+ * @brief Indica si los double en memoria ya tienen el orden de bytes del archivo.
+ */
+constexpr bool nativeLittleEndian() {
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+    return __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__;
+#else
+    return true;
+#endif
+}
+
+#endif // COLUMN_FILE_HPP
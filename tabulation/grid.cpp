@@ -0,0 +1,121 @@
+/**
+ * @file grid.cpp
+ * @brief Implementación de la tabulación por tiles sobre mallas y volúmenes.
+ */
+
+#include "grid.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Cantidad de puntos del volumen, o lanza si no cabe en la salida.
+ */
+std::size_t volumeSize(const sampleRange& x, const sampleRange& y, const sampleRange& z, std::size_t outputSize) {
+    const std::size_t maximum = std::numeric_limits<std::size_t>::max();
+    if (y.count != 0 && x.count > maximum / y.count)
+    {
+        throw std::runtime_error("[Tabulation Error]: La malla es demasiado grande.");
+    }
+    const std::size_t slice = x.count * y.count;
+    if (z.count != 0 && slice > maximum / z.count)
+    {
+        throw std::runtime_error("[Tabulation Error]: La malla es demasiado grande.");
+    }
+    if (slice * z.count != outputSize)
+    {
+        throw std::runtime_error("[Tabulation Error]: La salida no tiene el tamaño de la malla.");
+    }
+    return slice * z.count;
+}
+
+/**
+ * @brief Tabula una banda de filas [firstRow, firstRow + rows) del corte k, tile por tile.
+ *
+ * Cada tile tiene como mucho gridTileWidth columnas: la columna de x se
+ * repite en cada fila y la de y es constante por fila, así que la entrada
+ * del tile se arma sin volver a calcular las muestras.
+ */
+void tabulateBand(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, double zValue, std::size_t firstRow,
+    std::size_t rows, std::span<double> slice) {
+    const std::size_t capacity = std::min(x.count, gridTileWidth) * rows;
+    std::vector<double> xs(capacity), ys(capacity), zs(program.usesVariable(2) ? capacity : 0, zValue), values(capacity);
+
+    for (std::size_t firstColumn = 0; firstColumn < x.count; firstColumn += gridTileWidth)
+    {
+        const std::size_t width = std::min(gridTileWidth, x.count - firstColumn);
+        const std::size_t samples = width * rows;
+        for (std::size_t i = 0; i < width; i++)
+        {
+            xs[i] = x.at(firstColumn + i);
+        }
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            if (r > 0)
+            {
+                std::copy(xs.begin(), xs.begin() + width, xs.begin() + r * width);
+            }
+            std::fill(ys.begin() + r * width, ys.begin() + (r + 1) * width, y.at(firstRow + r));
+        }
+
+        variableInputs inputs;
+        inputs.x = std::span<const double>(xs.data(), samples);
+        inputs.y = std::span<const double>(ys.data(), samples);
+        if (!zs.empty())
+        {
+            inputs.z = std::span<const double>(zs.data(), samples);
+        }
+        evaluateBatch(program, inputs, std::span<double>(values.data(), samples));
+
+        for (std::size_t r = 0; r < rows; r++)
+        {
+            std::memcpy(slice.data() + (firstRow + r) * x.count + firstColumn, values.data() + r * width, width * sizeof(double));
+        }
+    }
+}
+
+} // namespace
+
+void tabulateVolume(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, const sampleRange& z,
+    std::span<double> output, threadPool& pool) {
+    if (volumeSize(x, y, z, output.size()) == 0)
+    {
+        return;
+    }
+
+    // Filas por banda, para que cada tile tenga unas gridTileSamples muestras.
+    const std::size_t bandRows = std::max<std::size_t>(1, gridTileSamples / std::min(x.count, gridTileWidth));
+    const std::size_t bands = (y.count + bandRows - 1) / bandRows;
+    const std::size_t slice = x.count * y.count;
+
+    pool.parallelFor(bands * z.count, [&](std::size_t task) {
+        const std::size_t k = task / bands;
+        const std::size_t firstRow = (task % bands) * bandRows;
+        const std::size_t rows = std::min(bandRows, y.count - firstRow);
+        tabulateBand(program, x, y, z.at(k), firstRow, rows, output.subspan(k * slice, slice));
+    });
+}
+
+void tabulateGrid(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, std::span<double> output, threadPool& pool) {
+    if (program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Una malla solo puede depender de x e y.");
+    }
+    tabulateVolume(program, x, y, {0.0, 0.0, 1}, output, pool);
+}
+
+gridTable tabulateGrid(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, threadPool& pool) {
+    gridTable table{x, y, {}};
+    if (program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Una malla solo puede depender de x e y.");
+    }
+    volumeSize(x, y, {0.0, 0.0, 1}, x.count * y.count);
+    table.values.resize(x.count * y.count);
+    tabulateGrid(program, x, y, table.values, pool);
+    return table;
+}
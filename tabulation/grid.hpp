@@ -0,0 +1,86 @@
+/**
+ * @file grid.hpp
+ * @brief Tabulación de f(x, y) sobre mallas y de f(x, y, z) sobre volúmenes.
+ *
+ * La salida es densa y por filas: el valor del punto (i, j) de una malla está
+ * en output[j * x.count + i], y en un volumen el del punto (i, j, k) está en
+ * output[(k * y.count + j) * x.count + i]. Es el formato que esperan los
+ * mapas de calor y el algoritmo de marching squares.
+ *
+ * La malla se recorre por tiles de gridTileWidth columnas y unas pocas filas:
+ * cada tile se evalúa de una sola vez con columnas de entrada que caben en la
+ * caché, y las bandas de tiles se reparten entre los hilos.
+ */
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "tabulate.hpp"
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/// Columnas de un tile: coincide con el bloque del evaluador.
+constexpr std::size_t gridTileWidth = 256;
+
+/// Muestras aproximadas por tile.
+constexpr std::size_t gridTileSamples = 4096;
+
+/**
+ * @struct gridTable
+ * @brief Valores de f(x, y) sobre una malla, por filas.
+ */
+struct gridTable {
+    sampleRange x; ///< Columnas de la malla
+    sampleRange y; ///< Filas de la malla
+    std::vector<double> values; ///< x.count * y.count valores
+
+    /**
+     * @brief Valor en la columna i y la fila j.
+     */
+    double at(std::size_t i, std::size_t j) const { return values[j * x.count + i]; }
+};
+
+/**
+ * @brief Tabula f(x, y) sobre una malla.
+ *
+ * @param program Programa compilado; puede depender de x e y.
+ * @param x Muestras de x (columnas).
+ * @param y Muestras de y (filas).
+ * @param output Salida por filas con x.count * y.count elementos.
+ * @param pool Grupo de hilos a usar.
+ * @throws std::runtime_error Si el programa usa z o la salida no tiene el tamaño de la malla.
+ */
+void tabulateGrid(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, std::span<double> output,
+    threadPool& pool = threadPool::shared());
+
+/**
+ * @brief Tabula f(x, y) sobre una malla y devuelve la tabla.
+ *
+ * @param program Programa compilado; puede depender de x e y.
+ * @param x Muestras de x (columnas).
+ * @param y Muestras de y (filas).
+ * @param pool Grupo de hilos a usar.
+ * @return gridTable Valores de la malla.
+ * @throws std::runtime_error Si el programa usa z.
+ */
+gridTable tabulateGrid(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, threadPool& pool = threadPool::shared());
+
+/**
+ * @brief Tabula f(x, y, z) sobre un volumen, como z.count mallas consecutivas.
+ *
+ * Para un solo corte con z fijo basta con z = {valor, valor, 1}.
+ *
+ * @param program Programa compilado.
+ * @param x Muestras de x (columnas).
+ * @param y Muestras de y (filas).
+ * @param z Muestras de z (cortes).
+ * @param output Salida con x.count * y.count * z.count elementos.
+ * @param pool Grupo de hilos a usar.
+ * @throws std::runtime_error Si la salida no tiene el tamaño del volumen.
+ */
+void tabulateVolume(const bytecodeProgram& program, const sampleRange& x, const sampleRange& y, const sampleRange& z,
+    std::span<double> output, threadPool& pool = threadPool::shared());
+
+#endif // GRID_HPP
@@ -0,0 +1,132 @@
+/**
+ * @file implicit_curve.cpp
+ * @brief Implementación de la subdivisión por quadtree con cotas de intervalos.
+ */
+
+#include "implicit_curve.hpp"
+#include "../evaluator/interval.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+/// Cajas acotadas por tarea del grupo de hilos.
+constexpr std::size_t boxesPerTask = 256;
+
+/**
+ * @struct cellBox
+ * @brief Rango de celdas [column, columnEnd) x [row, rowEnd) de una caja del quadtree.
+ */
+struct cellBox {
+    std::size_t column;
+    std::size_t columnEnd;
+    std::size_t row;
+    std::size_t rowEnd;
+};
+
+/**
+ * @brief Posición del borde index de count celdas entre start y end.
+ *
+ * Las cajas vecinas calculan el borde compartido con la misma fórmula, así
+ * que no quedan huecos entre ellas por redondeo.
+ */
+double cellEdge(double start, double end, std::size_t index, std::size_t count) {
+    if (index == count)
+    {
+        return end;
+    }
+    return start + (end - start) * (static_cast<double>(index) / static_cast<double>(count));
+}
+
+/**
+ * @brief Intervalo entre dos bordes, en orden creciente.
+ */
+interval edgeInterval(double a, double b) {
+    return {std::min(a, b), std::max(a, b), false};
+}
+
+/**
+ * @brief Divide una caja en hasta cuatro mitades a lo largo de cada dimensión con más de una celda.
+ */
+void splitBox(const cellBox& box, std::vector<cellBox>& next) {
+    const std::size_t columnMiddle = box.column + (box.columnEnd - box.column) / 2;
+    const std::size_t rowMiddle = box.row + (box.rowEnd - box.row) / 2;
+    const std::size_t columnCuts[3] = {box.column, columnMiddle, box.columnEnd};
+    const std::size_t rowCuts[3] = {box.row, rowMiddle, box.rowEnd};
+    for (std::size_t r = 0; r < 2; r++)
+    {
+        for (std::size_t c = 0; c < 2; c++)
+        {
+            if (columnCuts[c] < columnCuts[c + 1] && rowCuts[r] < rowCuts[r + 1])
+            {
+                next.push_back({columnCuts[c], columnCuts[c + 1], rowCuts[r], rowCuts[r + 1]});
+            }
+        }
+    }
+}
+
+} // namespace
+
+curveMask locateImplicitCurve(const bytecodeProgram& program, double xStart, double xEnd, double yStart, double yEnd, std::size_t columns,
+    std::size_t rows, threadPool& pool) {
+    if (program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: La curva implícita solo puede depender de x e y.");
+    }
+
+    curveMask mask;
+    mask.columns = columns;
+    mask.rows = rows;
+    mask.cells.assign(columns * rows, 0);
+    if (columns == 0 || rows == 0)
+    {
+        return mask;
+    }
+
+    std::vector<cellBox> level = {{0, columns, 0, rows}};
+    std::vector<cellBox> next;
+    std::vector<intervalInputs> boxes;
+    std::vector<interval> bounds;
+    while (!level.empty())
+    {
+        boxes.resize(level.size());
+        bounds.resize(level.size());
+        for (std::size_t b = 0; b < level.size(); b++)
+        {
+            const cellBox& box = level[b];
+            boxes[b].x = edgeInterval(cellEdge(xStart, xEnd, box.column, columns), cellEdge(xStart, xEnd, box.columnEnd, columns));
+            boxes[b].y = edgeInterval(cellEdge(yStart, yEnd, box.row, rows), cellEdge(yStart, yEnd, box.rowEnd, rows));
+            boxes[b].z = interval::point(0.0);
+        }
+
+        const std::size_t tasks = (level.size() + boxesPerTask - 1) / boxesPerTask;
+        pool.parallelFor(tasks, [&](std::size_t task) {
+            const std::size_t first = task * boxesPerTask;
+            const std::size_t count = std::min(boxesPerTask, level.size() - first);
+            evaluateIntervals(program, std::span<const intervalInputs>(boxes).subspan(first, count),
+                std::span<interval>(bounds).subspan(first, count));
+        });
+        mask.evaluations += level.size();
+
+        next.clear();
+        for (std::size_t b = 0; b < level.size(); b++)
+        {
+            if (!bounds[b].contains(0.0))
+            {
+                continue; // f no se anula en la caja (o no está definida en ella)
+            }
+            const cellBox& box = level[b];
+            if (box.columnEnd - box.column == 1 && box.rowEnd - box.row == 1)
+            {
+                mask.cells[box.row * columns + box.column] = 1;
+                mask.marked++;
+            }
+            else
+            {
+                splitBox(box, next);
+            }
+        }
+        level.swap(next);
+    }
+    return mask;
+}
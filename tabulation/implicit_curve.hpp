@@ -0,0 +1,62 @@
+/**
+ * @file implicit_curve.hpp
+ * @brief Ubicación de las celdas por donde pasa una curva implícita f(x, y) = 0.
+ *
+ * En lugar de evaluar f en cada punto de la malla, la región se divide como un
+ * quadtree: cada caja se acota con aritmética de intervalos y, si el intervalo
+ * no contiene el 0, la curva no la atraviesa y se descarta entera. Solo se
+ * subdividen las cajas que pueden contener la curva, hasta llegar a las
+ * celdas de la malla. Las celdas marcadas son las únicas que marching squares
+ * (o un muestreo fino) necesita visitar.
+ *
+ * Sin falsos negativos: una celda sin marcar no contiene ningún punto con
+ * f(x, y) = 0. Una celda marcada puede no contenerlo (las cotas no son ajustadas).
+ */
+#ifndef IMPLICIT_CURVE_HPP
+#define IMPLICIT_CURVE_HPP
+
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct curveMask
+ * @brief Celdas de la malla que pueden contener la curva, por filas.
+ */
+struct curveMask {
+    std::size_t columns = 0; ///< Celdas en x
+    std::size_t rows = 0; ///< Celdas en y
+    std::vector<std::uint8_t> cells; ///< 1 si la celda (i, j) puede contener la curva, en cells[j * columns + i]
+    std::size_t marked = 0; ///< Cantidad de celdas marcadas
+    std::size_t evaluations = 0; ///< Cajas acotadas con intervalos durante la búsqueda
+
+    /**
+     * @brief Indica si la celda de la columna i y la fila j puede contener la curva.
+     */
+    bool at(std::size_t i, std::size_t j) const { return cells[j * columns + i] != 0; }
+};
+
+/**
+ * @brief Marca las celdas de [xStart, xEnd] x [yStart, yEnd] por donde puede pasar f(x, y) = 0.
+ *
+ * La celda (i, j) cubre x en [xStart + i * dx, xStart + (i + 1) * dx], con
+ * dx = (xEnd - xStart) / columns, y lo mismo en y. Cada nivel del quadtree se
+ * acota en paralelo.
+ *
+ * @param program Programa compilado; puede depender de x e y.
+ * @param xStart Borde izquierdo de la región.
+ * @param xEnd Borde derecho de la región.
+ * @param yStart Borde inferior de la región.
+ * @param yEnd Borde superior de la región.
+ * @param columns Celdas en x.
+ * @param rows Celdas en y.
+ * @param pool Grupo de hilos a usar.
+ * @return curveMask Celdas marcadas.
+ * @throws std::runtime_error Si el programa usa z.
+ */
+curveMask locateImplicitCurve(const bytecodeProgram& program, double xStart, double xEnd, double yStart, double yEnd, std::size_t columns,
+    std::size_t rows, threadPool& pool = threadPool::shared());
+
+#endif // IMPLICIT_CURVE_HPP
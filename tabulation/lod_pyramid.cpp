@@ -0,0 +1,235 @@
+/**
+ * @file lod_pyramid.cpp
+ * @brief Implementación de la pirámide de mínimos y máximos.
+ */
+
+#include "lod_pyramid.hpp"
+#include "table_writer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr double infinity = std::numeric_limits<double>::infinity();
+
+/// Envolvente de un rango sin muestras definidas; neutra para merge().
+constexpr sampleEnvelope emptyEnvelope{infinity, -infinity};
+
+/**
+ * @brief Junta la envolvente b en a. Los NaN nunca ganan una comparación, así que no cuentan.
+ */
+inline void merge(sampleEnvelope& a, const sampleEnvelope& b) {
+    a.lo = b.lo < a.lo ? b.lo : a.lo;
+    a.hi = b.hi > a.hi ? b.hi : a.hi;
+}
+
+/**
+ * @brief Envolvente de count valores consecutivos.
+ *
+ * Cuatro acumuladores independientes por extremo para que las comparaciones
+ * no dependan unas de otras.
+ */
+sampleEnvelope scan(const double* values, std::size_t count) {
+    double lo[4] = {infinity, infinity, infinity, infinity};
+    double hi[4] = {-infinity, -infinity, -infinity, -infinity};
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        for (std::size_t k = 0; k < 4; k++)
+        {
+            const double v = values[i + k];
+            lo[k] = v < lo[k] ? v : lo[k];
+            hi[k] = v > hi[k] ? v : hi[k];
+        }
+    }
+    for (; i < count; i++)
+    {
+        const double v = values[i];
+        lo[0] = v < lo[0] ? v : lo[0];
+        hi[0] = v > hi[0] ? v : hi[0];
+    }
+    sampleEnvelope result = emptyEnvelope;
+    for (std::size_t k = 0; k < 4; k++)
+    {
+        merge(result, {lo[k], hi[k]});
+    }
+    return result;
+}
+
+/**
+ * @brief Envolvente para entregar: los rangos sin muestras definidas pasan a NaN.
+ */
+inline sampleEnvelope finish(const sampleEnvelope& envelope) {
+    if (envelope.lo > envelope.hi)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        return {nan, nan};
+    }
+    return envelope;
+}
+
+} // namespace
+
+void lodPyramid::append(std::span<const double> values) {
+    if (values.empty())
+    {
+        return;
+    }
+    const std::size_t before = samples;
+    samples += values.size();
+
+    // Nivel 0: se completa el último bloque y se agregan los nuevos.
+    if (buckets.empty())
+    {
+        buckets.emplace_back();
+    }
+    std::vector<sampleEnvelope>& base = buckets[0];
+    std::size_t changed = before / lodBaseBucket;
+    base.resize((samples + lodBaseBucket - 1) / lodBaseBucket, emptyEnvelope);
+    for (std::size_t b = changed; b < base.size(); b++)
+    {
+        const std::size_t begin = std::max(b * lodBaseBucket, before);
+        const std::size_t end = std::min((b + 1) * lodBaseBucket, samples);
+        merge(base[b], scan(values.data() + (begin - before), end - begin));
+    }
+
+    // Niveles superiores: se recalculan los bloques que cubren a los que cambiaron.
+    for (std::size_t level = 0; buckets[level].size() > 1; level++)
+    {
+        if (level + 1 == buckets.size())
+        {
+            buckets.emplace_back();
+            changed = 0;
+        }
+        else
+        {
+            changed /= lodBranching;
+        }
+        const std::vector<sampleEnvelope>& below = buckets[level];
+        std::vector<sampleEnvelope>& above = buckets[level + 1];
+        above.resize((below.size() + lodBranching - 1) / lodBranching);
+        for (std::size_t b = changed; b < above.size(); b++)
+        {
+            sampleEnvelope envelope = emptyEnvelope;
+            for (std::size_t c = b * lodBranching; c < std::min((b + 1) * lodBranching, below.size()); c++)
+            {
+                merge(envelope, below[c]);
+            }
+            above[b] = envelope;
+        }
+    }
+}
+
+/**
+ * @brief Envolvente de [first, last) con los bloques de la pirámide, sin comprobar argumentos.
+ */
+sampleEnvelope lodPyramid::gather(std::size_t first, std::size_t last, std::span<const double> values) const {
+    sampleEnvelope result = emptyEnvelope;
+    if (first >= last)
+    {
+        return result;
+    }
+
+    // Bloques del nivel 0 que se usan: con la columna, solo los que el rango
+    // cubre enteros (los extremos se leen de la columna); sin ella, todos los
+    // que toca.
+    std::size_t lo;
+    std::size_t hi;
+    if (!values.empty())
+    {
+        lo = (first + lodBaseBucket - 1) / lodBaseBucket;
+        hi = last / lodBaseBucket;
+        if (lo >= hi)
+        {
+            return scan(values.data() + first, last - first);
+        }
+        merge(result, scan(values.data() + first, lo * lodBaseBucket - first));
+        merge(result, scan(values.data() + hi * lodBaseBucket, last - hi * lodBaseBucket));
+    }
+    else
+    {
+        lo = first / lodBaseBucket;
+        hi = (last + lodBaseBucket - 1) / lodBaseBucket;
+    }
+
+    // En cada nivel se toman los bloques sueltos de los bordes y el resto sube al siguiente.
+    for (std::size_t level = 0; lo < hi; level++)
+    {
+        const std::vector<sampleEnvelope>& row = buckets[level];
+        if (level + 1 == buckets.size())
+        {
+            for (; lo < hi; lo++)
+            {
+                merge(result, row[lo]);
+            }
+            break;
+        }
+        for (; lo < hi && lo % lodBranching != 0; lo++)
+        {
+            merge(result, row[lo]);
+        }
+        for (; lo < hi && hi % lodBranching != 0; hi--)
+        {
+            merge(result, row[hi - 1]);
+        }
+        lo /= lodBranching;
+        hi /= lodBranching;
+    }
+    return result;
+}
+
+sampleEnvelope lodPyramid::envelope(std::size_t first, std::size_t last, std::span<const double> values) const {
+    if (first > last || last > samples)
+    {
+        throw std::runtime_error("[Tabulation Error]: El rango de muestras se sale de la pirámide.");
+    }
+    if (!values.empty() && values.size() != samples)
+    {
+        throw std::runtime_error("[Tabulation Error]: La columna no tiene tantas muestras como la pirámide.");
+    }
+    return finish(gather(first, last, values));
+}
+
+void lodPyramid::envelopes(std::size_t first, std::size_t last, std::span<sampleEnvelope> pixels, std::span<const double> values) const {
+    if (first >= last || last > samples)
+    {
+        throw std::runtime_error("[Tabulation Error]: El rango de muestras está vacío o se sale de la pirámide.");
+    }
+    if (!values.empty() && values.size() != samples)
+    {
+        throw std::runtime_error("[Tabulation Error]: La columna no tiene tantas muestras como la pirámide.");
+    }
+
+    // El píxel p empieza en first + floor(p * span / count), sin multiplicar span por count.
+    const std::size_t span = last - first;
+    const std::size_t count = pixels.size();
+    auto boundary = [&](std::size_t p) {
+        return first + p * (span / count) + p * (span % count) / count;
+    };
+    std::size_t begin = first;
+    for (std::size_t p = 0; p < count; p++)
+    {
+        const std::size_t end = p + 1 == count ? last : boundary(p + 1);
+        pixels[p] = finish(gather(begin, std::max(end, begin + 1), values));
+        begin = end;
+    }
+}
+
+lodPyramid buildPyramid(const bytecodeProgram& program, const sampleRange& range, threadPool& pool) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden tabular funciones de x.");
+    }
+    lodPyramid pyramid;
+    std::vector<double> xs(std::min(range.count, tableWriterChunk));
+    std::vector<double> ys(xs.size());
+    for (std::size_t first = 0; first < range.count; first += tableWriterChunk)
+    {
+        const std::size_t count = std::min(tableWriterChunk, range.count - first);
+        tabulateSlice(program, range, first, std::span<double>(xs.data(), count), std::span<double>(ys.data(), count), pool);
+        pyramid.append(std::span<const double>(ys.data(), count));
+    }
+    return pyramid;
+}
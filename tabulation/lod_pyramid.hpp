@@ -0,0 +1,118 @@
+/**
+ * @file lod_pyramid.hpp
+ * @brief Pirámide de mínimos y máximos para dibujar tablas enormes a cualquier escala.
+ *
+ * Como un mipmap: el nivel 0 guarda el mínimo y el máximo de cada bloque de
+ * lodBaseBucket muestras consecutivas, y cada nivel siguiente junta
+ * lodBranching bloques del anterior. Se construye mientras la tabla se va
+ * produciendo (append() con cada bloque de salida, en orden), con memoria de
+ * alrededor del 4 % de la tabla, y después da la envolvente de cada píxel sin
+ * recorrer las muestras: un rango cualquiera se cubre con a lo sumo
+ * 2 * (lodBranching - 1) bloques por nivel.
+ *
+ * Los valores NaN no cuentan; los infinitos sí. Un rango sin ningún valor
+ * definido da una envolvente con lo y hi en NaN, que el renderizador dibuja
+ * como un hueco.
+ */
+#ifndef LOD_PYRAMID_HPP
+#define LOD_PYRAMID_HPP
+
+#include "tabulate.hpp"
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/// Muestras por bloque del nivel 0.
+constexpr std::size_t lodBaseBucket = 64;
+
+/// Bloques de un nivel que forman un bloque del nivel siguiente.
+constexpr std::size_t lodBranching = 4;
+
+/**
+ * @struct sampleEnvelope
+ * @brief Menor y mayor valor de un rango de muestras.
+ */
+struct sampleEnvelope {
+    double lo; ///< Mínimo (NaN si ninguna muestra está definida)
+    double hi; ///< Máximo (NaN si ninguna muestra está definida)
+};
+
+/**
+ * @class lodPyramid
+ * @brief Envolventes precalculadas de una columna de valores, por niveles de detalle.
+ *
+ * Se puede consultar en cualquier momento mientras se construye: los bloques
+ * del final, todavía incompletos, cubren las muestras agregadas hasta ahora.
+ * No es segura para agregar y consultar desde varios hilos a la vez.
+ */
+class lodPyramid {
+public:
+    /**
+     * @brief Agrega las siguientes muestras de la columna.
+     */
+    void append(std::span<const double> values);
+
+    /**
+     * @brief Cantidad de muestras agregadas.
+     */
+    std::size_t size() const { return samples; }
+
+    /**
+     * @brief Cantidad de niveles (0 si está vacía).
+     */
+    std::size_t levels() const { return buckets.size(); }
+
+    /**
+     * @brief Envolvente de las muestras [first, last).
+     *
+     * Sin values, los bloques del nivel 0 cortados por los extremos se toman
+     * completos, por lo que la envolvente puede incluir hasta
+     * lodBaseBucket - 1 muestras de más a cada lado. Con la columna completa
+     * en values, esas muestras de los extremos se leen directamente y el
+     * resultado es exacto.
+     *
+     * @param first Primera muestra.
+     * @param last Una más que la última muestra.
+     * @param values Columna completa (size() valores) o vacía.
+     * @return sampleEnvelope Envolvente del rango.
+     * @throws std::runtime_error Si el rango se sale de la columna o values no tiene size() valores.
+     */
+    sampleEnvelope envelope(std::size_t first, std::size_t last, std::span<const double> values = {}) const;
+
+    /**
+     * @brief Envolvente de cada píxel al dibujar las muestras [first, last).
+     *
+     * El rango se reparte en pixels.size() partes iguales (redondeando a
+     * muestras enteras); un píxel más angosto que una muestra recibe la
+     * muestra donde empieza. El costo depende de la cantidad de píxeles y no
+     * de la de muestras.
+     *
+     * @param first Primera muestra de la vista.
+     * @param last Una más que la última muestra de la vista.
+     * @param pixels Salida, una envolvente por píxel.
+     * @param values Columna completa (size() valores) o vacía; ver envelope().
+     * @throws std::runtime_error Si el rango está vacío o se sale de la columna, o values no tiene size() valores.
+     */
+    void envelopes(std::size_t first, std::size_t last, std::span<sampleEnvelope> pixels, std::span<const double> values = {}) const;
+
+private:
+    std::vector<std::vector<sampleEnvelope>> buckets; ///< Bloques de cada nivel; vacíos como {+inf, -inf}
+    std::size_t samples = 0;
+
+    sampleEnvelope gather(std::size_t first, std::size_t last, std::span<const double> values) const;
+};
+
+/**
+ * @brief Tabula f(x) por bloques y construye su pirámide, sin guardar la tabla.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param pool Grupo de hilos para evaluar cada bloque.
+ * @return lodPyramid Pirámide de las range.count muestras.
+ * @throws std::runtime_error Si el programa usa y o z.
+ */
+lodPyramid buildPyramid(const bytecodeProgram& program, const sampleRange& range, threadPool& pool = threadPool::shared());
+
+#endif // LOD_PYRAMID_HPP
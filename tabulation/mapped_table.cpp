@@ -0,0 +1,286 @@
+/**
+ * @file mapped_table.cpp
+ * @brief Implementación de las tablas por columnas mapeadas en memoria.
+ */
+
+#include "mapped_table.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PLOTSYS_MMAP_ENABLED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Filas por tarea al evaluar un archivo.
+constexpr std::size_t rowsPerTask = 1 << 16;
+
+[[noreturn]] void fileError(const char* message, const std::string& path) {
+    throw std::runtime_error(std::string("[Tabulation Error]: ") + message + ": " + path);
+}
+
+void checkPlatform(const std::string& path) {
+#ifndef PLOTSYS_MMAP_ENABLED
+    fileError("El mapeo de archivos no está disponible en esta plataforma", path);
+#endif
+    if (!nativeLittleEndian())
+    {
+        fileError("Las columnas mapeadas requieren un procesador little-endian", path);
+    }
+}
+
+/**
+ * @brief Tamaño en bytes de un archivo con esta cabecera, si cabe en memoria.
+ */
+std::size_t mappedLength(const columnFileHeader& header, const std::string& path) {
+    const std::uint64_t maximum = std::numeric_limits<std::size_t>::max();
+    if (header.rowCount > (maximum - columnFileHeaderSize) / sizeof(double) / std::max<std::uint32_t>(header.columnCount, 1))
+    {
+        fileError("La tabla no cabe en el espacio de direcciones", path);
+    }
+    return static_cast<std::size_t>(header.fileSize());
+}
+
+/**
+ * @brief Crea un archivo vacío con nombre único en el directorio de path.
+ *
+ * Quedar en el mismo directorio garantiza que rename() lo mueva sobre path
+ * sin copiar, y el nombre único evita pisar el temporal de otra ejecución.
+ *
+ * @return std::string Ruta del archivo creado.
+ */
+std::string createTemporaryBeside(const std::string& path) {
+#ifdef PLOTSYS_MMAP_ENABLED
+    const std::size_t slash = path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    const std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    std::string temporary = directory + "." + name + ".XXXXXX";
+    int descriptor = mkstemp(temporary.data());
+    if (descriptor < 0)
+    {
+        fileError("No se pudo crear el archivo temporal", path);
+    }
+    // mkstemp lo crea con permisos 0600; la salida usa los mismos que un archivo nuevo.
+    fchmod(descriptor, 0644);
+    ::close(descriptor);
+    return temporary;
+#else
+    fileError("El mapeo de archivos no está disponible en esta plataforma", path);
+#endif
+}
+
+} // namespace
+
+mappedColumnFile::mappedColumnFile(const std::string& path) {
+    checkPlatform(path);
+#ifdef PLOTSYS_MMAP_ENABLED
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+    {
+        fileError("No se pudo abrir el archivo", path);
+    }
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || static_cast<std::uint64_t>(info.st_size) < columnFileHeaderSize)
+    {
+        ::close(descriptor);
+        fileError("El archivo no es una tabla por columnas", path);
+    }
+
+    unsigned char raw[columnFileHeaderSize];
+    if (pread(descriptor, raw, sizeof raw, 0) != static_cast<ssize_t>(sizeof raw))
+    {
+        ::close(descriptor);
+        fileError("No se pudo leer la cabecera", path);
+    }
+    try
+    {
+        fileHeader = decodeColumnHeader(raw);
+        length = mappedLength(fileHeader, path);
+    }
+    catch (...)
+    {
+        ::close(descriptor);
+        throw;
+    }
+    if (static_cast<std::uint64_t>(info.st_size) < length)
+    {
+        ::close(descriptor);
+        fileError("La tabla por columnas está truncada", path);
+    }
+
+    void* memory = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor); // El mapeo sigue vigente sin el descriptor
+    if (memory == MAP_FAILED)
+    {
+        fileError("No se pudo mapear el archivo", path);
+    }
+    // Los bloques se recorren de principio a fin: conviene leer por adelantado.
+    madvise(memory, length, MADV_SEQUENTIAL);
+    address = memory;
+#endif
+}
+
+mappedColumnFile::mappedColumnFile(const std::string& path, const columnFileHeader& header) : fileHeader(header), writable(true) {
+    checkPlatform(path);
+#ifdef PLOTSYS_MMAP_ENABLED
+    length = mappedLength(fileHeader, path);
+    const std::array<unsigned char, columnFileHeaderSize> raw = encodeColumnHeader(fileHeader);
+
+    int descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0)
+    {
+        fileError("No se pudo crear el archivo", path);
+    }
+    if (ftruncate(descriptor, static_cast<off_t>(length)) != 0)
+    {
+        ::close(descriptor);
+        fileError("No se pudo reservar el archivo", path);
+    }
+    void* memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (memory == MAP_FAILED)
+    {
+        fileError("No se pudo mapear el archivo", path);
+    }
+    std::memcpy(memory, raw.data(), raw.size());
+    address = memory;
+#endif
+}
+
+mappedColumnFile::~mappedColumnFile() {
+    release();
+}
+
+mappedColumnFile::mappedColumnFile(mappedColumnFile&& other) noexcept
+    : fileHeader(other.fileHeader), address(std::exchange(other.address, nullptr)), length(std::exchange(other.length, 0)),
+      writable(other.writable) {}
+
+mappedColumnFile& mappedColumnFile::operator=(mappedColumnFile&& other) noexcept {
+    if (this != &other)
+    {
+        release();
+        fileHeader = other.fileHeader;
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        writable = other.writable;
+    }
+    return *this;
+}
+
+void mappedColumnFile::release() {
+#ifdef PLOTSYS_MMAP_ENABLED
+    if (address != nullptr)
+    {
+        munmap(address, length);
+    }
+#endif
+    address = nullptr;
+    length = 0;
+}
+
+std::optional<std::size_t> mappedColumnFile::find(std::string_view name) const {
+    for (std::size_t c = 0; c < fileHeader.columnCount; c++)
+    {
+        if (fileHeader.name(c) == name)
+        {
+            return c;
+        }
+    }
+    return std::nullopt;
+}
+
+std::span<const double> mappedColumnFile::column(std::size_t c) const {
+    if (c >= fileHeader.columnCount)
+    {
+        throw std::runtime_error("[Tabulation Error]: La columna no existe.");
+    }
+    const auto* base = static_cast<const unsigned char*>(address) + fileHeader.columnOffset(c);
+    return std::span<const double>(reinterpret_cast<const double*>(base), rows());
+}
+
+std::span<double> mappedColumnFile::writableColumn(std::size_t c) {
+    if (!writable)
+    {
+        throw std::runtime_error("[Tabulation Error]: La tabla se abrió solo para lectura.");
+    }
+    std::span<const double> values = column(c);
+    return std::span<double>(const_cast<double*>(values.data()), values.size());
+}
+
+void mappedColumnFile::sync() {
+#ifdef PLOTSYS_MMAP_ENABLED
+    if (writable && address != nullptr && msync(address, length, MS_SYNC) != 0)
+    {
+        throw std::runtime_error("[Tabulation Error]: No se pudo escribir la tabla.");
+    }
+#endif
+}
+
+void evaluateColumnFile(const bytecodeProgram& program, const std::string& inputPath, const std::string& outputPath, threadPool& pool) {
+    const mappedColumnFile input(inputPath);
+
+    // Columnas de x, y, z; las que el programa no usa quedan vacías.
+    std::span<const double> columns[3];
+    const std::string_view names[3] = {"x", "y", "z"};
+    for (std::size_t variable = 0; variable < 3; variable++)
+    {
+        if (!program.usesVariable(variable))
+        {
+            continue;
+        }
+        std::optional<std::size_t> found = input.find(names[variable]);
+        if (!found)
+        {
+            fileError("Falta la columna de una variable del programa", inputPath);
+        }
+        columns[variable] = input.column(*found);
+    }
+
+    // El resultado va a un archivo aparte que al final reemplaza a outputPath:
+    // si outputPath es la entrada (o un enlace a ella), truncarlo ahora borraría
+    // los datos que siguen mapeados y leerlos más allá del nuevo final da SIGBUS.
+    const std::string partialPath = createTemporaryBeside(outputPath);
+    const std::string_view outputNames[] = {resultColumnName};
+    try
+    {
+        mappedColumnFile output(partialPath, makeColumnHeader(outputNames, input.rows()));
+        std::span<double> result = output.writableColumn(0);
+
+        const std::size_t rows = input.rows();
+        const std::size_t tasks = (rows + rowsPerTask - 1) / rowsPerTask;
+        pool.parallelFor(tasks, [&](std::size_t task) {
+            const std::size_t begin = task * rowsPerTask;
+            const std::size_t count = std::min(rows, begin + rowsPerTask) - begin;
+            variableInputs inputs;
+            for (std::size_t variable = 0; variable < 3; variable++)
+            {
+                if (!columns[variable].empty())
+                {
+                    (variable == 0 ? inputs.x : variable == 1 ? inputs.y : inputs.z) = columns[variable].subspan(begin, count);
+                }
+            }
+            evaluateBatch(program, inputs, result.subspan(begin, count), activeKernels()); // Siempre en double
+        });
+        output.sync();
+    }
+    catch (...)
+    {
+        std::remove(partialPath.c_str());
+        throw;
+    }
+    if (std::rename(partialPath.c_str(), outputPath.c_str()) != 0)
+    {
+        std::remove(partialPath.c_str());
+        fileError("No se pudo reemplazar el archivo", outputPath);
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file mapped_table.hpp
+ * @brief Tablas por columnas mapeadas en memoria, para evaluar sobre datos externos.
+ *
+ * Un archivo con el formato de column_file.hpp se mapea completo y sus
+ * columnas se entregan al evaluador por lotes como spans sobre el propio
+ * mapeo, sin leerlas antes a un vector. El resultado se escribe del mismo
+ * modo en otro archivo mapeado. Así se pueden procesar entradas de varios
+ * GB con la memoria que el sistema decida dedicarle a la caché de páginas.
+ *
+ * Requiere POSIX (mmap) y un procesador little-endian; en otro caso los
+ * constructores lanzan una excepción.
+ */
+#ifndef MAPPED_TABLE_HPP
+#define MAPPED_TABLE_HPP
+
+#include "column_file.hpp"
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+/// Nombre de la columna de resultados que escribe evaluateColumnFile().
+constexpr std::string_view resultColumnName = "f";
+
+/**
+ * @class mappedColumnFile
+ * @brief Archivo por columnas mapeado en memoria, de solo lectura o recién creado.
+ */
+class mappedColumnFile {
+public:
+    /**
+     * @brief Mapea un archivo existente para lectura.
+     *
+     * @param path Ruta del archivo.
+     * @throws std::runtime_error Si no se puede abrir, la cabecera no es válida o está truncado.
+     */
+    explicit mappedColumnFile(const std::string& path);
+
+    /**
+     * @brief Crea (o reemplaza) un archivo con la cabecera dada y lo mapea para escritura.
+     *
+     * Las columnas quedan en cero hasta que se escriban con writableColumn().
+     *
+     * @param path Ruta del archivo.
+     * @param header Columnas y filas del archivo.
+     * @throws std::runtime_error Si no se puede crear o reservar el archivo.
+     */
+    mappedColumnFile(const std::string& path, const columnFileHeader& header);
+
+    ~mappedColumnFile();
+
+    mappedColumnFile(const mappedColumnFile&) = delete;
+    mappedColumnFile& operator=(const mappedColumnFile&) = delete;
+    mappedColumnFile(mappedColumnFile&& other) noexcept;
+    mappedColumnFile& operator=(mappedColumnFile&& other) noexcept;
+
+    /**
+     * @brief Cabecera del archivo.
+     */
+    const columnFileHeader& header() const { return fileHeader; }
+
+    /**
+     * @brief Filas de cada columna.
+     */
+    std::size_t rows() const { return static_cast<std::size_t>(fileHeader.rowCount); }
+
+    /**
+     * @brief Índice de la columna con el nombre dado, si existe.
+     */
+    std::optional<std::size_t> find(std::string_view name) const;
+
+    /**
+     * @brief Valores de la columna c, directamente sobre el mapeo.
+     */
+    std::span<const double> column(std::size_t c) const;
+
+    /**
+     * @brief Valores de la columna c para escribir en ellos.
+     * @throws std::runtime_error Si el archivo se abrió solo para lectura.
+     */
+    std::span<double> writableColumn(std::size_t c);
+
+    /**
+     * @brief Espera a que lo escrito llegue al archivo.
+     * @throws std::runtime_error Si falla la sincronización.
+     */
+    void sync();
+
+private:
+    columnFileHeader fileHeader;
+    void* address = nullptr; ///< Inicio del mapeo (la cabecera)
+    std::size_t length = 0; ///< Bytes mapeados
+    bool writable = false; ///< Si se creó para escritura
+
+    void release();
+};
+
+/**
+ * @brief Evalúa f sobre las columnas x, y, z de un archivo y guarda el resultado en otro.
+ *
+ * Solo hace falta que el archivo tenga las columnas de las variables que
+ * usa el programa. Se evalúa siempre en double, sin importar
+ * program.precision. La salida tiene una sola columna (resultColumnName) con
+ * tantas filas como la entrada. Las filas se reparten en bloques entre los
+ * hilos del grupo. El resultado se escribe primero en un temporal de nombre
+ * único (mkstemp) en el directorio de outputPath y se renombra al terminar:
+ * la entrada sigue intacta mientras se lee y, si algo falla, outputPath
+ * conserva su contenido anterior y el temporal se borra.
+ *
+ * @param program Programa compilado.
+ * @param inputPath Archivo por columnas de entrada.
+ * @param outputPath Archivo por columnas de salida (se reemplaza si existe; puede ser la entrada).
+ * @param pool Grupo de hilos a usar.
+ * @throws std::runtime_error Si falta una columna o falla algún acceso a los archivos.
+ */
+void evaluateColumnFile(const bytecodeProgram& program, const std::string& inputPath, const std::string& outputPath,
+    threadPool& pool = threadPool::shared());
+
+#endif // MAPPED_TABLE_HPP
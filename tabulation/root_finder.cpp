@@ -0,0 +1,385 @@
+/**
+ * @file root_finder.cpp
+ * @brief Implementación de la búsqueda por lotes de raíces y extremos.
+ *
+ * Cada encierro es un segmento [lo, hi] donde g cambia de signo, con g = f
+ * para las raíces y g = f' para los extremos. En cada iteración todos los
+ * encierros pendientes proponen un candidato (Newton o falsa posición, o el
+ * punto medio si el candidato se sale o el encierro no se achica lo
+ * suficiente), se evalúan juntos y se quedan con la mitad que conserva el
+ * cambio de signo.
+ */
+
+#include "root_finder.hpp"
+#include "../evaluator/derivative.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Muestras de la malla gruesa por tarea.
+constexpr std::size_t coarseTaskSamples = 1 << 16;
+
+/// Encierros refinados juntos por tarea.
+constexpr std::size_t bracketsPerTask = 1024;
+
+/**
+ * @struct coarseGrid
+ * @brief Malla gruesa: coarseSamples segmentos iguales entre start y end.
+ */
+struct coarseGrid {
+    double start;
+    double end;
+    std::size_t segments;
+
+    double at(std::size_t i) const {
+        if (i == segments)
+        {
+            return end;
+        }
+        return start + (end - start) * (static_cast<double>(i) / static_cast<double>(segments));
+    }
+};
+
+/**
+ * @struct bracket
+ * @brief Segmento donde g cambia de signo, con el estado de su refinamiento.
+ */
+struct bracket {
+    double lo, hi; ///< Extremos
+    double glo, ghi; ///< g en los extremos
+    double flo, fhi; ///< f en los extremos
+    double dlo, dhi; ///< g' en los extremos (solo raíces)
+    double wlo, whi; ///< Pesos de falsa posición (g, reducido a la mitad por Illinois)
+    double limit; ///< Menor |g| inicial: si al final |g| es mayor, era un polo
+    criticalKind kind;
+    int kept; ///< Extremo conservado en el último paso (-1 lo, 1 hi, 0 ninguno)
+    bool slow; ///< El último paso no redujo el encierro a la mitad: el siguiente biseca
+    bool done;
+    bool found;
+    double x; ///< Resultado
+    double value; ///< f en el resultado
+};
+
+bool opposite(double a, double b) {
+    return (a < 0.0 && b > 0.0) || (a > 0.0 && b < 0.0);
+}
+
+/**
+ * @brief Ancho a partir del cual el encierro se da por resuelto.
+ */
+double convergenceWidth(const bracket& b, double tolerance, double scale) {
+    const double magnitude = std::max({std::fabs(b.lo), std::fabs(b.hi), scale});
+    return std::max(tolerance, 4.0 * std::numeric_limits<double>::epsilon() * magnitude);
+}
+
+/**
+ * @brief Termina el encierro en el extremo con menor |g|, o lo descarta si era un polo.
+ */
+void finish(bracket& b) {
+    const bool left = std::fabs(b.glo) <= std::fabs(b.ghi);
+    const double g = left ? b.glo : b.ghi;
+    b.x = left ? b.lo : b.hi;
+    b.value = left ? b.flo : b.fhi;
+    b.found = std::isfinite(b.value) && std::fabs(g) <= b.limit;
+    b.done = true;
+}
+
+/**
+ * @brief Propone el siguiente punto a evaluar dentro del encierro.
+ */
+double candidate(const bracket& b) {
+    const double middle = 0.5 * (b.lo + b.hi);
+    if (b.slow)
+    {
+        return middle;
+    }
+    double next;
+    if (b.kind == criticalKind::Root)
+    {
+        // Newton desde el extremo con menor |f|.
+        const bool left = std::fabs(b.glo) <= std::fabs(b.ghi);
+        next = left ? b.lo - b.glo / b.dlo : b.hi - b.ghi / b.dhi;
+    }
+    else
+    {
+        next = (b.lo * b.whi - b.hi * b.wlo) / (b.whi - b.wlo);
+    }
+    return next > b.lo && next < b.hi ? next : middle;
+}
+
+/**
+ * @brief Actualiza el encierro con g (y f, g') evaluados en el candidato x.
+ */
+void update(bracket& b, double x, double f, double g, double derivative, double tolerance, double scale) {
+    if (std::isnan(g))
+    {
+        b.done = true; // Fuera del dominio dentro del encierro: no se puede decidir
+        return;
+    }
+    const double width = b.hi - b.lo;
+    const double best = std::min(std::fabs(b.glo), std::fabs(b.ghi));
+    if (g == 0.0)
+    {
+        b.lo = b.hi = x;
+        b.glo = b.ghi = 0.0;
+        b.flo = b.fhi = f;
+        finish(b);
+        return;
+    }
+    if (opposite(g, b.ghi))
+    {
+        b.lo = x;
+        b.glo = g;
+        b.flo = f;
+        b.dlo = derivative;
+        b.wlo = g;
+        if (b.kept == 1)
+        {
+            b.whi *= 0.5; // Illinois: hi se conservó dos veces seguidas
+        }
+        b.kept = 1;
+    }
+    else
+    {
+        b.hi = x;
+        b.ghi = g;
+        b.fhi = f;
+        b.dhi = derivative;
+        b.whi = g;
+        if (b.kept == -1)
+        {
+            b.wlo *= 0.5;
+        }
+        b.kept = -1;
+    }
+    // Newton y falsa posición suelen acercarse por un solo lado y el encierro
+    // no se cierra: el avance se juzga por |g| y la convergencia por el tamaño
+    // del próximo paso desde el mejor extremo.
+    b.slow = !(std::fabs(g) <= 0.5 * best) && b.hi - b.lo > 0.5 * width;
+    const bool left = std::fabs(b.glo) <= std::fabs(b.ghi);
+    const double slope = b.kind == criticalKind::Root ? (left ? b.dlo : b.dhi) : (b.ghi - b.glo) / (b.hi - b.lo);
+    const double step = (left ? b.glo : b.ghi) / slope;
+    const double limit = convergenceWidth(b, tolerance, scale);
+    if (std::fabs(step) <= 0.25 * limit || b.hi - b.lo <= limit)
+    {
+        finish(b);
+    }
+}
+
+/**
+ * @brief Refina juntos todos los encierros, evaluando un lote por iteración.
+ */
+void refine(const bytecodeProgram& program, std::span<bracket> brackets, const solverOptions& options, double scale) {
+    std::vector<std::size_t> active;
+    std::vector<double> xs, values, slopes;
+    for (std::size_t i = 0; i < brackets.size(); i++)
+    {
+        if (brackets[i].hi - brackets[i].lo <= convergenceWidth(brackets[i], options.tolerance, scale))
+        {
+            finish(brackets[i]);
+        }
+        else
+        {
+            active.push_back(i);
+        }
+    }
+
+    for (int iteration = 0; iteration < options.maxIterations && !active.empty(); iteration++)
+    {
+        xs.resize(active.size());
+        values.resize(active.size());
+        slopes.resize(active.size());
+        for (std::size_t a = 0; a < active.size(); a++)
+        {
+            xs[a] = candidate(brackets[active[a]]);
+        }
+        variableInputs inputs;
+        inputs.x = xs;
+        evaluateDerivative(program, inputs, 0, values, slopes);
+
+        std::size_t kept = 0;
+        for (std::size_t a = 0; a < active.size(); a++)
+        {
+            bracket& b = brackets[active[a]];
+            const bool root = b.kind == criticalKind::Root;
+            update(b, xs[a], values[a], root ? values[a] : slopes[a], root ? slopes[a] : 0.0, options.tolerance, scale);
+            if (!b.done)
+            {
+                active[kept++] = active[a];
+            }
+        }
+        active.resize(kept);
+    }
+    for (std::size_t index : active)
+    {
+        finish(brackets[index]); // Sin converger en maxIterations: el mejor extremo
+    }
+}
+
+/**
+ * @brief Crea un encierro entre las muestras i e i + 1.
+ */
+bracket makeBracket(criticalKind kind, double x0, double x1, double g0, double g1, double f0, double f1, double d0, double d1) {
+    bracket b{};
+    b.lo = x0;
+    b.hi = x1;
+    b.glo = b.wlo = g0;
+    b.ghi = b.whi = g1;
+    b.flo = f0;
+    b.fhi = f1;
+    b.dlo = d0;
+    b.dhi = d1;
+    b.limit = std::min(std::fabs(g0), std::fabs(g1));
+    b.kind = kind;
+    return b;
+}
+
+/**
+ * @brief Evalúa las muestras [first, last) de la malla gruesa y anota encierros y ceros exactos.
+ *
+ * También evalúa una muestra a cada lado para los encierros y extremos que
+ * cruzan el borde del tramo; cada encierro pertenece al tramo de su muestra izquierda.
+ */
+void scanCoarse(const bytecodeProgram& program, const coarseGrid& grid, std::size_t first, std::size_t last, const solverOptions& options,
+    std::vector<bracket>& brackets, std::vector<criticalPoint>& exact) {
+    const std::size_t low = first == 0 ? 0 : first - 1;
+    const std::size_t high = std::min(last, grid.segments);
+    std::vector<double> xs(high - low + 1), f(xs.size()), d(xs.size());
+    for (std::size_t i = low; i <= high; i++)
+    {
+        xs[i - low] = grid.at(i);
+    }
+    variableInputs inputs;
+    inputs.x = xs;
+    evaluateDerivative(program, inputs, 0, f, d);
+
+    for (std::size_t i = first; i < last; i++)
+    {
+        const std::size_t k = i - low;
+        const bool hasNext = i < grid.segments;
+        const bool hasPrevious = i > 0;
+        if (options.roots)
+        {
+            if (f[k] == 0.0)
+            {
+                exact.push_back({xs[k], 0.0, criticalKind::Root});
+            }
+            else if (hasNext && opposite(f[k], f[k + 1]))
+            {
+                brackets.push_back(makeBracket(criticalKind::Root, xs[k], xs[k + 1], f[k], f[k + 1], f[k], f[k + 1], d[k], d[k + 1]));
+            }
+        }
+        if (options.extrema)
+        {
+            if (d[k] == 0.0)
+            {
+                if (hasNext && hasPrevious && opposite(d[k - 1], d[k + 1]) && std::isfinite(f[k]))
+                {
+                    exact.push_back({xs[k], f[k], d[k - 1] < 0.0 ? criticalKind::Minimum : criticalKind::Maximum});
+                }
+            }
+            else if (hasNext && opposite(d[k], d[k + 1]))
+            {
+                const criticalKind kind = d[k] < 0.0 ? criticalKind::Minimum : criticalKind::Maximum;
+                brackets.push_back(makeBracket(kind, xs[k], xs[k + 1], d[k], d[k + 1], f[k], f[k + 1], 0.0, 0.0));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Junta los puntos exactos y los encierros resueltos, ordenados por x.
+ */
+std::vector<criticalPoint> collect(std::vector<criticalPoint>& exact, std::span<const bracket> brackets) {
+    std::vector<criticalPoint> result = std::move(exact);
+    for (const bracket& b : brackets)
+    {
+        if (b.found)
+        {
+            result.push_back({b.x, b.value, b.kind});
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const criticalPoint& a, const criticalPoint& b) { return a.x < b.x; });
+    return result;
+}
+
+void checkProgram(const bytecodeProgram& program) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden resolver funciones de x.");
+    }
+}
+
+coarseGrid checkedGrid(double start, double end, const solverOptions& options) {
+    if (!(start < end) || options.coarseSamples == 0)
+    {
+        throw std::runtime_error("[Tabulation Error]: El intervalo y la cantidad de muestras deben ser positivos.");
+    }
+    return {start, end, options.coarseSamples};
+}
+
+/**
+ * @brief Escala mínima del ancho de convergencia, para raíces en 0.
+ */
+double convergenceScale(const coarseGrid& grid) {
+    return 1e-9 * (grid.end - grid.start);
+}
+
+} // namespace
+
+std::vector<criticalPoint> findCriticalPoints(const bytecodeProgram& program, double start, double end, const solverOptions& options,
+    threadPool& pool) {
+    checkProgram(program);
+    const coarseGrid grid = checkedGrid(start, end, options);
+    const std::size_t samples = grid.segments + 1;
+
+    // Malla gruesa por tramos en paralelo.
+    const std::size_t tasks = (samples + coarseTaskSamples - 1) / coarseTaskSamples;
+    std::vector<std::vector<bracket>> taskBrackets(tasks);
+    std::vector<std::vector<criticalPoint>> taskExact(tasks);
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        const std::size_t first = task * coarseTaskSamples;
+        const std::size_t last = std::min(samples, first + coarseTaskSamples);
+        scanCoarse(program, grid, first, last, options, taskBrackets[task], taskExact[task]);
+    });
+
+    std::vector<bracket> brackets;
+    std::vector<criticalPoint> exact;
+    for (std::size_t task = 0; task < tasks; task++)
+    {
+        brackets.insert(brackets.end(), taskBrackets[task].begin(), taskBrackets[task].end());
+        exact.insert(exact.end(), taskExact[task].begin(), taskExact[task].end());
+    }
+
+    // Refinamiento por grupos de encierros en paralelo.
+    const double scale = convergenceScale(grid);
+    const std::size_t groups = (brackets.size() + bracketsPerTask - 1) / bracketsPerTask;
+    pool.parallelFor(groups, [&](std::size_t group) {
+        const std::size_t first = group * bracketsPerTask;
+        const std::size_t count = std::min(bracketsPerTask, brackets.size() - first);
+        refine(program, std::span<bracket>(brackets).subspan(first, count), options, scale);
+    });
+    return collect(exact, brackets);
+}
+
+std::vector<std::vector<criticalPoint>> findCriticalPoints(std::span<const bytecodeProgram> programs, double start, double end,
+    const solverOptions& options, threadPool& pool) {
+    const coarseGrid grid = checkedGrid(start, end, options);
+    for (const bytecodeProgram& program : programs)
+    {
+        checkProgram(program);
+    }
+
+    std::vector<std::vector<criticalPoint>> results(programs.size());
+    pool.parallelFor(programs.size(), [&](std::size_t p) {
+        std::vector<bracket> brackets;
+        std::vector<criticalPoint> exact;
+        scanCoarse(programs[p], grid, 0, grid.segments + 1, options, brackets, exact);
+        refine(programs[p], brackets, options, convergenceScale(grid));
+        results[p] = collect(exact, brackets);
+    });
+    return results;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file root_finder.hpp
+ * @brief Raíces, mínimos y máximos de f(x) sobre un intervalo, resueltos por lotes.
+ *
+ * Una evaluación gruesa (con derivada, en una sola pasada de diferenciación
+ * automática) encierra cada cambio de signo de f (raíz) y de f' (extremo)
+ * entre dos muestras. Después se refinan todos los encierros a la vez: cada
+ * iteración evalúa en un solo lote el siguiente candidato de cada encierro
+ * pendiente. Las raíces usan Newton con la derivada exacta, protegido por
+ * bisección; los extremos usan falsa posición (Illinois) sobre f'.
+ *
+ * Los trabajos se reparten entre los hilos: por tramos de la malla gruesa y
+ * de encierros con una sola función, o una función por tarea con muchas.
+ */
+#ifndef ROOT_FINDER_HPP
+#define ROOT_FINDER_HPP
+
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @enum criticalKind
+ * @brief Tipo de punto encontrado.
+ */
+enum class criticalKind : std::uint8_t {
+    Root, ///< f(x) = 0
+    Minimum, ///< f' pasa de negativa a positiva
+    Maximum, ///< f' pasa de positiva a negativa
+};
+
+/**
+ * @struct criticalPoint
+ * @brief Una raíz o un extremo local.
+ */
+struct criticalPoint {
+    double x; ///< Posición
+    double value; ///< f(x)
+    criticalKind kind; ///< Raíz, mínimo o máximo
+};
+
+/**
+ * @struct solverOptions
+ * @brief Resolución de la búsqueda.
+ */
+struct solverOptions {
+    std::size_t coarseSamples = 4096; ///< Segmentos de la malla gruesa: dos raíces en el mismo segmento no se distinguen
+    int maxIterations = 100; ///< Iteraciones máximas por encierro
+    double tolerance = 0.0; ///< Ancho con el que se da por encontrado un punto; 0 = precisión de máquina
+    bool roots = true; ///< Buscar raíces
+    bool extrema = true; ///< Buscar mínimos y máximos
+};
+
+/**
+ * @brief Busca las raíces y extremos locales de f en [start, end].
+ *
+ * Solo se encuentran los puntos donde f (o f') cambia de signo entre dos
+ * muestras gruesas, o se anula justo en una muestra: una raíz doble como la
+ * de x^2 aparece como mínimo con valor 0. Los cambios de signo en un polo
+ * (tan en pi/2) se descartan porque |f| crece al refinarlos.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param start Inicio del intervalo.
+ * @param end Fin del intervalo.
+ * @param options Resolución y tipos de punto a buscar.
+ * @param pool Grupo de hilos a usar.
+ * @return std::vector<criticalPoint> Puntos ordenados por x.
+ * @throws std::runtime_error Si el programa usa y o z, el intervalo está vacío o no hay muestras.
+ */
+std::vector<criticalPoint> findCriticalPoints(const bytecodeProgram& program, double start, double end, const solverOptions& options = {},
+    threadPool& pool = threadPool::shared());
+
+/**
+ * @brief Busca raíces y extremos de muchas funciones sobre el mismo intervalo.
+ *
+ * Cada función se resuelve entera en una tarea; conviene para lotes grandes
+ * de funciones, donde repartir una sola función entre los hilos no compensa.
+ *
+ * @param programs Programas compilados; solo pueden depender de x.
+ * @param start Inicio del intervalo.
+ * @param end Fin del intervalo.
+ * @param options Resolución y tipos de punto a buscar.
+ * @param pool Grupo de hilos a usar.
+ * @return std::vector<std::vector<criticalPoint>> Puntos de cada función, ordenados por x.
+ * @throws std::runtime_error Si algún programa usa y o z, el intervalo está vacío o no hay muestras.
+ */
+std::vector<std::vector<criticalPoint>> findCriticalPoints(std::span<const bytecodeProgram> programs, double start, double end,
+    const solverOptions& options = {}, threadPool& pool = threadPool::shared());
+
+#endif // ROOT_FINDER_HPP
@@ -0,0 +1,291 @@
+/**
+ * @file sweep.cpp
+ * @brief Implementación del barrido de parámetro con elevación de subexpresiones.
+ */
+
+#include "sweep.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/// Muestras de x por tarea del trabajo cuadros x muestras.
+constexpr std::size_t sweepTaskSamples = 1 << 14;
+
+/// Fuente de una ranura que es el propio parámetro (no una instrucción elevada).
+constexpr std::int32_t parameterSource = -1;
+
+/**
+ * @struct sweepPlan
+ * @brief Programa partido en la parte por cuadro y la parte por muestra.
+ *
+ * La parte por muestra es un programa normal cuyas constantes son las del
+ * original seguidas de una ranura por cada valor que llega de la parte por
+ * cuadro; sus intermedios se corren detrás de las ranuras.
+ */
+struct sweepPlan {
+    std::vector<instruction> frameCode; ///< Instrucciones que no dependen de x, con la numeración original
+    std::vector<std::int32_t> slotSources; ///< Instrucción de frameCode que llena cada ranura, o parameterSource
+    bytecodeProgram samples; ///< Parte que depende de x
+};
+
+/**
+ * @brief Parte el programa según qué instrucciones dependen de x.
+ */
+sweepPlan planSweep(const bytecodeProgram& program, std::uint16_t parameter) {
+    const std::uint16_t firstTemporary = program.firstTemporary();
+    constexpr std::int32_t noProducer = std::numeric_limits<std::int32_t>::min();
+
+    // Qué instrucción escribió por última vez cada registro, y si el valor depende de x.
+    std::vector<std::int32_t> producer(program.registerCount, noProducer);
+    std::vector<char> varies(program.registerCount, 0);
+    varies[0] = 1;
+    producer[parameter] = parameterSource;
+
+    sweepPlan plan;
+    std::vector<std::int32_t> slotOf(program.code.size() + 1, -1); // Ranura de cada fuente; la última posición es el parámetro
+    auto slotFor = [&](std::int32_t source) {
+        std::int32_t& slot = slotOf[source == parameterSource ? program.code.size() : static_cast<std::size_t>(source)];
+        if (slot < 0)
+        {
+            slot = static_cast<std::int32_t>(plan.slotSources.size());
+            plan.slotSources.push_back(source);
+        }
+        return static_cast<std::uint16_t>(slot);
+    };
+
+    // Operando en la parte por muestra: x y las constantes quedan igual, los
+    // valores por cuadro pasan a su ranura y los intermedios se corren.
+    struct operandSource {
+        std::uint16_t reg;
+        std::int32_t source;
+        bool fromFrame;
+    };
+    std::vector<operandSource> lefts, rights;
+    std::vector<char> perSample(program.code.size(), 0);
+    auto describe = [&](std::uint16_t reg) {
+        const bool fromFrame = reg == parameter || (reg >= firstTemporary && !varies[reg]);
+        return operandSource{reg, producer[reg], fromFrame};
+    };
+    for (std::size_t i = 0; i < program.code.size(); i++)
+    {
+        const instruction& step = program.code[i];
+        const bool binary = operandCount(step.op) == 2;
+        const bool dependsOnX = varies[step.left] || (binary && varies[step.right]);
+        if (dependsOnX)
+        {
+            lefts.push_back(describe(step.left));
+            rights.push_back(binary ? describe(step.right) : operandSource{0, noProducer, false});
+            perSample[i] = 1;
+        }
+        else
+        {
+            plan.frameCode.push_back(step);
+        }
+        varies[step.target] = dependsOnX;
+        producer[step.target] = dependsOnX ? noProducer : static_cast<std::int32_t>(plan.frameCode.size() - 1);
+    }
+
+    // Ranuras en orden de uso, y después el resultado si no depende de x.
+    for (std::size_t k = 0; k < lefts.size(); k++)
+    {
+        for (const operandSource* operand : {&lefts[k], &rights[k]})
+        {
+            if (operand->fromFrame)
+            {
+                slotFor(operand->source);
+            }
+        }
+    }
+    const operandSource result = describe(program.result);
+    if (result.fromFrame)
+    {
+        slotFor(result.source);
+    }
+
+    const std::size_t slots = plan.slotSources.size();
+    if (program.registerCount + slots > std::numeric_limits<std::uint16_t>::max())
+    {
+        throw std::runtime_error("[Tabulation Error]: El programa es demasiado grande para barrer un parámetro.");
+    }
+    const std::uint16_t shift = static_cast<std::uint16_t>(slots);
+    auto remap = [&](const operandSource& operand) -> std::uint16_t {
+        if (operand.fromFrame)
+        {
+            return static_cast<std::uint16_t>(firstTemporary + slotFor(operand.source));
+        }
+        if (operand.reg >= firstTemporary)
+        {
+            return static_cast<std::uint16_t>(operand.reg + shift);
+        }
+        return operand.reg; // x o una constante del programa
+    };
+
+    bytecodeProgram& samples = plan.samples;
+    samples.constants = program.constants;
+    samples.constants.resize(program.constants.size() + slots, 0.0);
+    samples.registerCount = static_cast<std::uint16_t>(program.registerCount + shift);
+    samples.variableMask = program.variableMask & 1u;
+    samples.precision = program.precision;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < program.code.size(); i++)
+    {
+        if (perSample[i])
+        {
+            const instruction& step = program.code[i];
+            const bool binary = operandCount(step.op) == 2;
+            samples.code.push_back({step.op, static_cast<std::uint16_t>(step.target + shift), remap(lefts[k]), binary ? remap(rights[k]) : std::uint16_t{0}});
+            k++;
+        }
+    }
+    samples.result = remap(result);
+    return plan;
+}
+
+/**
+ * @brief Evalúa la parte por cuadro de todos los cuadros y llena las ranuras.
+ *
+ * Las ranuras quedan por filas: slots[s * frames + k] es la ranura s del cuadro k.
+ */
+void evaluateFrames(const bytecodeProgram& program, const sweepPlan& plan, std::uint16_t parameter, std::span<const double> frames,
+    std::vector<double>& slots) {
+    const std::size_t count = frames.size();
+    const std::size_t slotCount = plan.slotSources.size();
+    slots.assign(slotCount * count, 0.0);
+    if (count == 0 || slotCount == 0)
+    {
+        return;
+    }
+
+    const kernelTable& kernels = activeKernels();
+    const std::size_t chunk = std::min(count, evaluationChunk);
+    std::vector<double> scratch((program.registerCount - variableRegisterCount) * chunk);
+    std::vector<double*> registers(program.registerCount, nullptr);
+    for (std::size_t r = variableRegisterCount; r < program.registerCount; r++)
+    {
+        registers[r] = scratch.data() + (r - variableRegisterCount) * chunk;
+    }
+    for (std::size_t c = 0; c < program.constants.size(); c++)
+    {
+        std::fill(registers[variableRegisterCount + c], registers[variableRegisterCount + c] + chunk, program.constants[c]);
+    }
+
+    for (std::size_t start = 0; start < count; start += chunk)
+    {
+        const std::size_t length = std::min(chunk, count - start);
+        registers[parameter] = const_cast<double*>(frames.data() + start);
+        for (std::size_t s = 0; s < slotCount; s++)
+        {
+            if (plan.slotSources[s] == parameterSource)
+            {
+                std::copy(frames.data() + start, frames.data() + start + length, slots.data() + s * count + start);
+            }
+        }
+        for (std::size_t i = 0; i < plan.frameCode.size(); i++)
+        {
+            const instruction& step = plan.frameCode[i];
+            const std::size_t op = static_cast<std::size_t>(step.op);
+            if (operandCount(step.op) == 2)
+            {
+                kernels.binary[op](registers[step.left], registers[step.right], registers[step.target], length);
+            }
+            else
+            {
+                kernels.unary[op](registers[step.left], registers[step.target], length);
+            }
+            // El registro puede reutilizarse después: se copia ya a las ranuras que lo usan.
+            for (std::size_t s = 0; s < slotCount; s++)
+            {
+                if (plan.slotSources[s] == static_cast<std::int32_t>(i))
+                {
+                    std::copy(registers[step.target], registers[step.target] + length, slots.data() + s * count + start);
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+void sweepParameter(const bytecodeProgram& program, std::size_t parameter, std::span<const double> parameterValues, const sampleRange& x,
+    std::span<double> output, threadPool& pool) {
+    if (parameter != 1 && parameter != 2)
+    {
+        throw std::runtime_error("[Tabulation Error]: El parámetro del barrido debe ser y o z.");
+    }
+    if (program.usesVariable(3 - parameter))
+    {
+        throw std::runtime_error("[Tabulation Error]: El barrido solo puede depender de x y del parámetro.");
+    }
+    const std::size_t frames = parameterValues.size();
+    if (frames != 0 && x.count > std::numeric_limits<std::size_t>::max() / frames)
+    {
+        throw std::runtime_error("[Tabulation Error]: El barrido es demasiado grande.");
+    }
+    if (frames * x.count != output.size())
+    {
+        throw std::runtime_error("[Tabulation Error]: La salida no tiene el tamaño del barrido.");
+    }
+    if (output.empty())
+    {
+        return;
+    }
+
+    const std::uint16_t variable = static_cast<std::uint16_t>(parameter);
+    const sweepPlan plan = planSweep(program, variable);
+    std::vector<double> slots;
+    evaluateFrames(program, plan, variable, parameterValues, slots);
+
+    // La columna de x es la misma en todos los cuadros.
+    std::vector<double> xs(plan.samples.usesVariable(0) ? x.count : 0);
+    for (std::size_t i = 0; i < xs.size(); i++)
+    {
+        xs[i] = x.at(i);
+    }
+
+    // Constantes de la parte por muestra en cada cuadro: las del programa y
+    // detrás las ranuras. Se arman una vez y cada tarea solo toma su cuadro.
+    const bytecodeProgram& samples = plan.samples;
+    const std::size_t constantCount = samples.constants.size();
+    const std::size_t firstSlot = program.constants.size();
+    std::vector<double> frameConstants(frames * constantCount);
+    for (std::size_t frame = 0; frame < frames; frame++)
+    {
+        double* constants = frameConstants.data() + frame * constantCount;
+        std::copy(program.constants.begin(), program.constants.end(), constants);
+        for (std::size_t s = 0; s < plan.slotSources.size(); s++)
+        {
+            constants[firstSlot + s] = slots[s * frames + frame];
+        }
+    }
+
+    const std::size_t parts = (x.count + sweepTaskSamples - 1) / sweepTaskSamples;
+    pool.parallelFor(frames * parts, [&](std::size_t task) {
+        const std::size_t frame = task / parts;
+        const std::size_t first = (task % parts) * sweepTaskSamples;
+        const std::size_t count = std::min(sweepTaskSamples, x.count - first);
+
+        variableInputs inputs;
+        if (!xs.empty())
+        {
+            inputs.x = std::span<const double>(xs).subspan(first, count);
+        }
+        inputs.constants = std::span<const double>(frameConstants).subspan(frame * constantCount, constantCount);
+        evaluateBatch(samples, inputs, output.subspan(frame * x.count + first, count));
+    });
+}
+
+sweepTable sweepParameter(const bytecodeProgram& program, std::size_t parameter, std::span<const double> parameterValues, const sampleRange& x,
+    threadPool& pool) {
+    sweepTable table{x, std::vector<double>(parameterValues.begin(), parameterValues.end()), {}};
+    if (!parameterValues.empty() && x.count > std::numeric_limits<std::size_t>::max() / parameterValues.size())
+    {
+        throw std::runtime_error("[Tabulation Error]: El barrido es demasiado grande.");
+    }
+    table.values.resize(parameterValues.size() * x.count);
+    sweepParameter(program, parameter, parameterValues, x, table.values, pool);
+    return table;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file sweep.hpp
+ * @brief Barrido de parámetro: una familia f(x, p) evaluada en muchos valores de p.
+ *
+ * Para animar familias como sin(x*y), donde y (o z) hace de parámetro que
+ * cambia por cuadro, el programa se compila una sola vez y se parte en dos:
+ * las instrucciones que solo dependen del parámetro (y de constantes) se
+ * evalúan una vez por cuadro, todos los cuadros juntos en un lote, y su
+ * resultado entra como constante en la parte que depende de x. Todos los
+ * cuadros por todas las muestras se reparten entre los hilos como un solo
+ * trabajo bidimensional.
+ *
+ * Los valores coinciden bit a bit con evaluar cada cuadro por separado con
+ * evaluateBatch: las dos partes usan los mismos núcleos. Con precisión
+ * Single o Fast solo la parte que depende de x se evalúa en float; la parte
+ * por cuadro va siempre en double.
+ */
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include "tabulate.hpp"
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * @struct sweepTable
+ * @brief Valores de f(x, p) para cada cuadro, cuadro tras cuadro.
+ */
+struct sweepTable {
+    sampleRange x; ///< Muestras de x de cada cuadro
+    std::vector<double> parameters; ///< Valor del parámetro en cada cuadro
+    std::vector<double> values; ///< parameters.size() * x.count valores
+
+    /**
+     * @brief Valor de la muestra i en el cuadro frame.
+     */
+    double at(std::size_t frame, std::size_t i) const { return values[frame * x.count + i]; }
+};
+
+/**
+ * @brief Evalúa f(x, p) en todas las muestras de x para cada valor de p.
+ *
+ * El valor de la muestra i en el cuadro k queda en output[k * x.count + i].
+ *
+ * @param program Programa compilado; depende de x y del parámetro.
+ * @param parameter Variable que hace de parámetro (1 = y, 2 = z).
+ * @param parameterValues Valor del parámetro en cada cuadro.
+ * @param x Muestras de x.
+ * @param output Salida con parameterValues.size() * x.count elementos.
+ * @param pool Grupo de hilos a usar.
+ * @throws std::runtime_error Si el parámetro no es y o z, el programa usa la otra variable o la salida no tiene el tamaño del barrido.
+ */
+void sweepParameter(const bytecodeProgram& program, std::size_t parameter, std::span<const double> parameterValues, const sampleRange& x,
+    std::span<double> output, threadPool& pool = threadPool::shared());
+
+/**
+ * @brief Evalúa f(x, p) para cada valor de p y devuelve la tabla.
+ *
+ * @param program Programa compilado; depende de x y del parámetro.
+ * @param parameter Variable que hace de parámetro (1 = y, 2 = z).
+ * @param parameterValues Valor del parámetro en cada cuadro.
+ * @param x Muestras de x.
+ * @param pool Grupo de hilos a usar.
+ * @return sweepTable Valores de todos los cuadros.
+ * @throws std::runtime_error Si el parámetro no es y o z o el programa usa la otra variable.
+ */
+sweepTable sweepParameter(const bytecodeProgram& program, std::size_t parameter, std::span<const double> parameterValues, const sampleRange& x,
+    threadPool& pool = threadPool::shared());
+
+#endif // SWEEP_HPP
@@ -0,0 +1,259 @@
+/**
+ * @file table_writer.cpp
+ * @brief Implementación de la escritura de tablas por bloques.
+ */
+
+#include "table_writer.hpp"
+#include "column_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+/// Tamaño del búfer de salida antes de pasarlo al destino.
+constexpr std::size_t bufferBytes = 1 << 20;
+
+/**
+ * @class outputBuffer
+ * @brief Acumula bytes y los entrega al destino en bloques grandes.
+ */
+class outputBuffer {
+public:
+    virtual ~outputBuffer() = default;
+
+    void append(const char* data, std::size_t size) {
+        if (buffer.size() + size > bufferBytes)
+        {
+            flush();
+        }
+        if (size >= bufferBytes)
+        {
+            deliver(data, size);
+            return;
+        }
+        buffer.insert(buffer.end(), data, data + size);
+    }
+
+    /**
+     * @brief Espacio para escribir hasta size bytes directamente en el búfer.
+     */
+    char* reserve(std::size_t size) {
+        if (buffer.size() + size > bufferBytes)
+        {
+            flush();
+        }
+        std::size_t used = buffer.size();
+        buffer.resize(used + size);
+        return buffer.data() + used;
+    }
+
+    /**
+     * @brief Descarta lo reservado y no usado (ver reserve).
+     */
+    void shrink(char* end) {
+        buffer.resize(static_cast<std::size_t>(end - buffer.data()));
+    }
+
+    void flush() {
+        if (!buffer.empty())
+        {
+            deliver(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+
+protected:
+    outputBuffer() { buffer.reserve(bufferBytes); }
+
+    virtual void deliver(const char* data, std::size_t size) = 0;
+
+private:
+    std::vector<char> buffer;
+};
+
+void writeFailed() {
+    throw std::runtime_error("[Tabulation Error]: No se pudo escribir la tabla.");
+}
+
+class streamOutput : public outputBuffer {
+public:
+    explicit streamOutput(std::ostream& out) : out(out) {}
+
+private:
+    std::ostream& out;
+
+    void deliver(const char* data, std::size_t size) override {
+        out.write(data, static_cast<std::streamsize>(size));
+        if (!out)
+        {
+            writeFailed();
+        }
+    }
+};
+
+class descriptorOutput : public outputBuffer {
+public:
+    explicit descriptorOutput(int descriptor) : descriptor(descriptor) {}
+
+private:
+    int descriptor;
+
+    void deliver(const char* data, std::size_t size) override {
+#if defined(__unix__) || defined(__APPLE__)
+        while (size > 0)
+        {
+            ssize_t written = ::write(descriptor, data, size);
+            if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                writeFailed();
+            }
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+#else
+        (void)data;
+        (void)size;
+        writeFailed();
+#endif
+    }
+};
+
+/**
+ * @brief Agrega una columna de doubles en little-endian.
+ */
+void appendColumn(outputBuffer& out, const std::vector<double>& values, std::size_t count) {
+    if constexpr (nativeLittleEndian())
+    {
+        out.append(reinterpret_cast<const char*>(values.data()), count * sizeof(double));
+    }
+    else
+    {
+        char* cursor = out.reserve(count * sizeof(double));
+        for (std::size_t i = 0; i < count; i++)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &values[i], sizeof bits);
+            for (int b = 0; b < 8; b++)
+            {
+                *cursor++ = static_cast<char>(bits >> (8 * b));
+            }
+        }
+    }
+}
+
+void writeBinary(const bytecodeProgram& program, const sampleRange& range, outputBuffer& out, threadPool& pool, lodPyramid* pyramid) {
+    const std::string_view names[] = {"x", "y"};
+    const std::array<unsigned char, columnFileHeaderSize> header = encodeColumnHeader(makeColumnHeader(names, range.count));
+    out.append(reinterpret_cast<const char*>(header.data()), header.size());
+
+    std::vector<double> xs(std::min(range.count, tableWriterChunk));
+    std::vector<double> ys(xs.size());
+
+    // Columna x: no requiere evaluar la expresión.
+    for (std::size_t first = 0; first < range.count; first += tableWriterChunk)
+    {
+        const std::size_t count = std::min(tableWriterChunk, range.count - first);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            xs[i] = range.at(first + i);
+        }
+        appendColumn(out, xs, count);
+    }
+
+    // Columna y: se evalúa bloque por bloque.
+    for (std::size_t first = 0; first < range.count; first += tableWriterChunk)
+    {
+        const std::size_t count = std::min(tableWriterChunk, range.count - first);
+        tabulateSlice(program, range, first, std::span<double>(xs.data(), count), std::span<double>(ys.data(), count), pool);
+        if (pyramid != nullptr)
+        {
+            pyramid->append(std::span<const double>(ys.data(), count));
+        }
+        appendColumn(out, ys, count);
+    }
+}
+
+void writeCSV(const bytecodeProgram& program, const sampleRange& range, outputBuffer& out, threadPool& pool, lodPyramid* pyramid) {
+    // Como mucho 24 caracteres por número con to_chars en su forma más corta.
+    constexpr std::size_t maxRowBytes = 2 * 24 + 2;
+    out.append("x,y\n", 4);
+
+    std::vector<double> xs(std::min(range.count, tableWriterChunk));
+    std::vector<double> ys(xs.size());
+    for (std::size_t first = 0; first < range.count; first += tableWriterChunk)
+    {
+        const std::size_t count = std::min(tableWriterChunk, range.count - first);
+        tabulateSlice(program, range, first, std::span<double>(xs.data(), count), std::span<double>(ys.data(), count), pool);
+        if (pyramid != nullptr)
+        {
+            pyramid->append(std::span<const double>(ys.data(), count));
+        }
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            char* cursor = out.reserve(maxRowBytes);
+            char* end = cursor + maxRowBytes;
+            cursor = std::to_chars(cursor, end, xs[i]).ptr;
+            *cursor++ = ',';
+            cursor = std::to_chars(cursor, end, ys[i]).ptr;
+            *cursor++ = '\n';
+            out.shrink(cursor);
+        }
+    }
+}
+
+void checkProgram(const bytecodeProgram& program) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden tabular funciones de x.");
+    }
+}
+
+void writeTo(const bytecodeProgram& program, const sampleRange& range, tableFormat format, outputBuffer& out, threadPool& pool,
+    lodPyramid* pyramid) {
+    checkProgram(program);
+    // Las tablas exportadas se evalúan siempre en double.
+    bytecodeProgram exact = program;
+    exact.precision = evaluationPrecision::Double;
+    if (format == tableFormat::Binary)
+    {
+        writeBinary(exact, range, out, pool, pyramid);
+    }
+    else
+    {
+        writeCSV(exact, range, out, pool, pyramid);
+    }
+    out.flush();
+}
+
+} // namespace
+
+void writeTable(const bytecodeProgram& program, const sampleRange& range, tableFormat format, std::ostream& out, threadPool& pool,
+    lodPyramid* pyramid) {
+    streamOutput output(out);
+    writeTo(program, range, format, output, pool, pyramid);
+    out.flush();
+    if (!out)
+    {
+        writeFailed();
+    }
+}
+
+void writeTable(const bytecodeProgram& program, const sampleRange& range, tableFormat format, int descriptor, threadPool& pool,
+    lodPyramid* pyramid) {
+    descriptorOutput output(descriptor);
+    writeTo(program, range, format, output, pool, pyramid);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file table_writer.hpp
+ * @brief Escritura de tablas de f(x) por partes, sin guardar la tabla completa en memoria.
+ *
+ * La tabla se evalúa en bloques de tableWriterChunk filas y cada bloque se
+ * escribe en cuanto está listo, así que la memoria usada no depende de la
+ * cantidad de filas. Se evalúa siempre en double, sea cual sea
+ * program.precision. Formatos:
+ * - CSV: cabecera "x,y" y una fila por muestra, con la representación
+ *   decimal más corta que vuelve a leerse como el mismo double.
+ * - Binario: el formato por columnas de column_file.hpp con las columnas
+ *   "x" y "y". La columna x no necesita evaluar nada y se escribe primero,
+ *   de modo que tampoco hace falta volver atrás en la salida (sirve para tuberías).
+ */
+#ifndef TABLE_WRITER_HPP
+#define TABLE_WRITER_HPP
+
+#include "lod_pyramid.hpp"
+#include "tabulate.hpp"
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <ostream>
+
+/// Filas que se evalúan y escriben de una vez.
+constexpr std::size_t tableWriterChunk = 1 << 16;
+
+/**
+ * @enum tableFormat
+ * @brief Formato de salida de la tabla.
+ */
+enum class tableFormat {
+    CSV, ///< Texto separado por comas, para personas y hojas de cálculo
+    Binary, ///< Columnas de doubles little-endian con cabecera (column_file.hpp)
+};
+
+/**
+ * @brief Tabula f(x) y escribe la tabla en un flujo.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param format Formato de salida.
+ * @param out Flujo de salida (en modo binario si format es Binary).
+ * @param pool Grupo de hilos para evaluar cada bloque.
+ * @param pyramid Si no es nulo, recibe con append() cada bloque de f(x) a medida que se escribe.
+ * @throws std::runtime_error Si el programa usa y o z, o si falla la escritura.
+ */
+void writeTable(const bytecodeProgram& program, const sampleRange& range, tableFormat format, std::ostream& out,
+    threadPool& pool = threadPool::shared(), lodPyramid* pyramid = nullptr);
+
+/**
+ * @brief Tabula f(x) y escribe la tabla en un descriptor de archivo (POSIX).
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param format Formato de salida.
+ * @param descriptor Descriptor abierto para escritura (archivo, tubería o socket).
+ * @param pool Grupo de hilos para evaluar cada bloque.
+ * @param pyramid Si no es nulo, recibe con append() cada bloque de f(x) a medida que se escribe.
+ * @throws std::runtime_error Si el programa usa y o z, o si falla la escritura.
+ */
+void writeTable(const bytecodeProgram& program, const sampleRange& range, tableFormat format, int descriptor,
+    threadPool& pool = threadPool::shared(), lodPyramid* pyramid = nullptr);
+
+#endif // TABLE_WRITER_HPP
@@ -0,0 +1,84 @@
+/**
+ * @file tabulate.cpp
+ * @brief Implementación de la tabulación secuencial y en paralelo.
+ */
+
+#include "tabulate.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+/// Muestras mínimas por tarea: por debajo, repartir cuesta más de lo que ahorra.
+constexpr std::size_t minimumChunk = 4096;
+
+void checkTabulation(const bytecodeProgram& program, const sampleRange& range, std::size_t first, std::span<double> xs, std::span<double> ys) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden tabular funciones de x.");
+    }
+    if (xs.size() != ys.size() || first > range.count || xs.size() > range.count - first)
+    {
+        throw std::runtime_error("[Tabulation Error]: Las columnas de salida no tienen el tamaño del intervalo.");
+    }
+}
+
+/**
+ * @brief Tabula las posiciones [begin, end) de una porción que empieza en la muestra first.
+ */
+void tabulateBlock(const bytecodeProgram& program, const sampleRange& range, std::size_t first, std::span<double> xs, std::span<double> ys, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i++)
+    {
+        xs[i] = range.at(first + i);
+    }
+    variableInputs inputs;
+    inputs.x = xs.subspan(begin, end - begin);
+    evaluateBatch(program, inputs, ys.subspan(begin, end - begin));
+}
+
+} // namespace
+
+void tabulate(const bytecodeProgram& program, const sampleRange& range, std::span<double> xs, std::span<double> ys) {
+    checkTabulation(program, range, 0, xs, ys);
+    if (xs.size() != range.count)
+    {
+        throw std::runtime_error("[Tabulation Error]: Las columnas de salida no tienen el tamaño del intervalo.");
+    }
+    tabulateBlock(program, range, 0, xs, ys, 0, range.count);
+}
+
+void tabulateParallel(const bytecodeProgram& program, const sampleRange& range, std::span<double> xs, std::span<double> ys,
+    threadPool& pool, std::size_t chunk) {
+    if (xs.size() != range.count)
+    {
+        throw std::runtime_error("[Tabulation Error]: Las columnas de salida no tienen el tamaño del intervalo.");
+    }
+    tabulateSlice(program, range, 0, xs, ys, pool, chunk);
+}
+
+void tabulateSlice(const bytecodeProgram& program, const sampleRange& range, std::size_t first, std::span<double> xs, std::span<double> ys,
+    threadPool& pool, std::size_t chunk) {
+    checkTabulation(program, range, first, xs, ys);
+    const std::size_t count = xs.size();
+    if (chunk == 0)
+    {
+        // Varias tareas por hilo para que el robo de trabajo pueda equilibrar la carga.
+        chunk = std::max(minimumChunk, count / (8 * (pool.size() + 1)) + 1);
+    }
+
+    const std::size_t tasks = (count + chunk - 1) / chunk;
+    pool.parallelFor(tasks, [&](std::size_t task) {
+        const std::size_t begin = task * chunk;
+        const std::size_t end = std::min(count, begin + chunk);
+        tabulateBlock(program, range, first, xs, ys, begin, end);
+    });
+}
+
+functionTable tabulate(const bytecodeProgram& program, const sampleRange& range, threadPool& pool) {
+    functionTable table;
+    table.x.resize(range.count);
+    table.y.resize(range.count);
+    tabulateParallel(program, range, table.x, table.y, pool);
+    return table;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file tabulate.hpp
+ * @brief Tabulación de f(x) sobre un intervalo con muestras equiespaciadas.
+ */
+#ifndef TABULATE_HPP
+#define TABULATE_HPP
+
+#include "../evaluator/program.hpp"
+#include "../support/thread_pool.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * @struct sampleRange
+ * @brief Intervalo [start, end] dividido en count muestras equiespaciadas.
+ *
+ * La muestra i vale start + i * (end - start) / (count - 1), y la última es
+ * exactamente end. El valor de cada muestra no depende de cómo se reparta
+ * el trabajo, por lo que la tabla es idéntica con uno o con muchos hilos.
+ */
+struct sampleRange {
+    double start; ///< Primer valor de x
+    double end; ///< Último valor de x
+    std::size_t count; ///< Cantidad de muestras
+
+    /**
+     * @brief Valor de x de la muestra i.
+     */
+    double at(std::size_t i) const {
+        if (count <= 1)
+        {
+            return start;
+        }
+        if (i + 1 == count)
+        {
+            return end;
+        }
+        return start + static_cast<double>(i) * ((end - start) / static_cast<double>(count - 1));
+    }
+};
+
+/**
+ * @struct functionTable
+ * @brief Tabla de valores (x, f(x)).
+ */
+struct functionTable {
+    std::vector<double> x; ///< Valores de x
+    std::vector<double> y; ///< Valores de f(x)
+};
+
+/**
+ * @brief Tabula f(x) en el hilo actual.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param xs Columna de salida para x (range.count elementos).
+ * @param ys Columna de salida para f(x) (range.count elementos).
+ * @throws std::runtime_error Si el programa usa y o z, o si las columnas no tienen el tamaño correcto.
+ */
+void tabulate(const bytecodeProgram& program, const sampleRange& range, std::span<double> xs, std::span<double> ys);
+
+/**
+ * @brief Tabula f(x) repartiendo bloques de muestras entre los hilos del grupo.
+ *
+ * El resultado es idéntico al de tabulate(): cada bloque escribe siempre en
+ * su propia porción de la salida.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param xs Columna de salida para x (range.count elementos).
+ * @param ys Columna de salida para f(x) (range.count elementos).
+ * @param pool Grupo de hilos a usar.
+ * @param chunk Muestras por tarea (0 = elegir automáticamente).
+ */
+void tabulateParallel(const bytecodeProgram& program, const sampleRange& range, std::span<double> xs, std::span<double> ys,
+    threadPool& pool = threadPool::shared(), std::size_t chunk = 0);
+
+/**
+ * @brief Tabula en paralelo solo las muestras [first, first + xs.size()) del intervalo.
+ *
+ * Permite recorrer tablas enormes por partes con memoria constante; cada
+ * muestra vale exactamente lo mismo que en la tabla completa.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras de la tabla completa.
+ * @param first Índice de la primera muestra de la porción.
+ * @param xs Columna de salida para x (tantos elementos como la porción).
+ * @param ys Columna de salida para f(x) (mismo tamaño que xs).
+ * @param pool Grupo de hilos a usar.
+ * @param chunk Muestras por tarea (0 = elegir automáticamente).
+ * @throws std::runtime_error Si el programa usa y o z, o la porción se sale del intervalo.
+ */
+void tabulateSlice(const bytecodeProgram& program, const sampleRange& range, std::size_t first, std::span<double> xs, std::span<double> ys,
+    threadPool& pool = threadPool::shared(), std::size_t chunk = 0);
+
+/**
+ * @brief Tabula f(x) en paralelo y devuelve la tabla completa.
+ *
+ * @param program Programa compilado; solo puede depender de x.
+ * @param range Intervalo y cantidad de muestras.
+ * @param pool Grupo de hilos a usar.
+ * @return functionTable Tabla con range.count filas.
+ */
+functionTable tabulate(const bytecodeProgram& program, const sampleRange& range, threadPool& pool = threadPool::shared());
+
+#endif // TABULATE_HPP
@@ -0,0 +1,198 @@
+/**
+ * @file tile_cache.cpp
+ * @brief Implementación de la caché de muestras por tiles.
+ */
+
+#include "tile_cache.hpp"
+#include "../evaluator/evaluator.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief x de la muestra global j con separación 2^level: el producto es exacto.
+ */
+double sampleX(std::int64_t sample, double spacing) {
+    return static_cast<double>(sample) * spacing;
+}
+
+/**
+ * @brief Piso de la división entera (el índice del tile que contiene una muestra).
+ */
+std::int64_t floorDivide(std::int64_t a, std::int64_t b) {
+    std::int64_t quotient = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? quotient - 1 : quotient;
+}
+
+} // namespace
+
+tileCache::tileCache(const bytecodeProgram& program, std::size_t maxTiles)
+    : program(program), maxTiles(maxTiles == 0 ? 1 : maxTiles) {
+    if (program.usesVariable(1) || program.usesVariable(2))
+    {
+        throw std::runtime_error("[Tabulation Error]: Solo se pueden tabular funciones de x.");
+    }
+}
+
+/**
+ * @brief Muestras para dibujar [start, end] con al menos pixels puntos.
+ *
+ * @param start Inicio de la vista.
+ * @param end Fin de la vista.
+ * @param pixels Ancho de la vista en píxeles.
+ * @return functionTable Muestras ordenadas por x.
+ */
+functionTable tileCache::view(double start, double end, std::size_t pixels) {
+    if (!(start < end) || !std::isfinite(start) || !std::isfinite(end) || pixels == 0)
+    {
+        throw std::runtime_error("[Tabulation Error]: La vista debe ser un intervalo finito y no vacío.");
+    }
+
+    const double spacing = (end - start) / static_cast<double>(pixels);
+    const int level = std::ilogb(spacing); // 2^level <= spacing < 2^(level + 1)
+
+    // Índices de muestra que cubren la vista, con una de más a cada lado.
+    const double first = std::floor(std::ldexp(start, -level)) - 1.0;
+    const double last = std::ceil(std::ldexp(end, -level)) + 1.0;
+    if (!(std::fabs(first) < 0x1p52) || !(std::fabs(last) < 0x1p52))
+    {
+        throw std::runtime_error("[Tabulation Error]: La vista está demasiado lejos del origen para su resolución.");
+    }
+    const std::int64_t firstSample = static_cast<std::int64_t>(first);
+    const std::int64_t lastSample = static_cast<std::int64_t>(last);
+    const std::int64_t samplesPerTile = static_cast<std::int64_t>(tileSamples);
+    const double step = std::ldexp(1.0, level);
+
+    functionTable table;
+    table.x.reserve(static_cast<std::size_t>(lastSample - firstSample + 1));
+    table.y.reserve(table.x.capacity());
+
+    for (std::int64_t t = floorDivide(firstSample, samplesPerTile); t <= floorDivide(lastSample, samplesPerTile); t++)
+    {
+        const std::vector<double>& values = fetch({level, t});
+        const std::int64_t base = t * samplesPerTile;
+        const std::int64_t begin = std::max(firstSample, base);
+        const std::int64_t stop = std::min(lastSample, base + samplesPerTile - 1);
+        for (std::int64_t j = begin; j <= stop; j++)
+        {
+            table.x.push_back(sampleX(j, step));
+        }
+        table.y.insert(table.y.end(), values.begin() + (begin - base), values.begin() + (stop - base + 1));
+    }
+    return table;
+}
+
+const tileCache::tile* tileCache::find(const tileKey& key) const {
+    auto found = index.find(key);
+    return found == index.end() ? nullptr : &*found->second;
+}
+
+/**
+ * @brief Devuelve los valores del tile, construyéndolo si no está guardado.
+ */
+const std::vector<double>& tileCache::fetch(const tileKey& key) {
+    auto found = index.find(key);
+    if (found != index.end())
+    {
+        counters.tilesReused++;
+        recent.splice(recent.begin(), recent, found->second);
+        return found->second->y;
+    }
+
+    std::vector<double> values = build(key);
+    counters.tilesBuilt++;
+    if (recent.size() >= maxTiles)
+    {
+        index.erase(recent.back().key);
+        recent.pop_back();
+    }
+    recent.push_front({key, std::move(values)});
+    index.emplace(key, recent.begin());
+    return recent.front().y;
+}
+
+/**
+ * @brief Calcula un tile aprovechando las muestras que comparte con los niveles vecinos.
+ *
+ * La muestra j del nivel L es la muestra j/2 del nivel L + 1 (si j es par) y
+ * la muestra 2j del nivel L - 1.
+ */
+std::vector<double> tileCache::build(const tileKey& key) {
+    const auto [level, t] = key;
+    const std::int64_t samplesPerTile = static_cast<std::int64_t>(tileSamples);
+    const std::int64_t base = t * samplesPerTile;
+
+    std::vector<double> values(tileSamples, std::numeric_limits<double>::quiet_NaN());
+    std::vector<bool> known(tileSamples, false);
+
+    // Nivel más grueso: aporta las muestras pares.
+    const std::int64_t coarseBase = floorDivide(base, 2);
+    if (const tile* coarse = find({level + 1, floorDivide(coarseBase, samplesPerTile)}))
+    {
+        const std::int64_t coarseTileBase = floorDivide(coarseBase, samplesPerTile) * samplesPerTile;
+        for (std::int64_t i = 0; i < samplesPerTile; i++)
+        {
+            const std::int64_t j = base + i;
+            if (j % 2 == 0)
+            {
+                values[static_cast<std::size_t>(i)] = coarse->y[static_cast<std::size_t>(j / 2 - coarseTileBase)];
+                known[static_cast<std::size_t>(i)] = true;
+            }
+        }
+    }
+
+    // Nivel más fino: cada tile hijo aporta la mitad de las muestras.
+    for (std::int64_t child = 2 * t; child <= 2 * t + 1; child++)
+    {
+        if (const tile* fine = find({level - 1, child}))
+        {
+            const std::int64_t fineBase = child * samplesPerTile;
+            for (std::int64_t m = 0; m < samplesPerTile; m += 2)
+            {
+                const std::size_t i = static_cast<std::size_t>((fineBase + m) / 2 - base);
+                values[i] = fine->y[static_cast<std::size_t>(m)];
+                known[i] = true;
+            }
+        }
+    }
+
+    // Las que faltan se evalúan juntas en un solo lote.
+    const double step = std::ldexp(1.0, level);
+    std::vector<std::size_t> missing;
+    std::vector<double> xs;
+    for (std::size_t i = 0; i < tileSamples; i++)
+    {
+        if (!known[i])
+        {
+            missing.push_back(i);
+            xs.push_back(sampleX(base + static_cast<std::int64_t>(i), step));
+        }
+    }
+    if (!missing.empty())
+    {
+        std::vector<double> ys(xs.size());
+        variableInputs inputs;
+        inputs.x = xs;
+        evaluateBatch(program, inputs, ys);
+        for (std::size_t k = 0; k < missing.size(); k++)
+        {
+            values[missing[k]] = ys[k];
+        }
+        counters.samplesEvaluated += missing.size();
+    }
+    return values;
+}
+
+tileCacheStats tileCache::stats() const {
+    tileCacheStats result = counters;
+    result.size = recent.size();
+    return result;
+}
+
+void tileCache::clear() {
+    index.clear();
+    recent.clear();
+    counters = tileCacheStats{};
+}
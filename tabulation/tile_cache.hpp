@@ -0,0 +1,107 @@
+/**
+ * @file tile_cache.hpp
+ * @brief Caché de muestras por bloques (tiles) para desplazar y ampliar la gráfica.
+ *
+ * Las muestras viven en una malla diádica: en el nivel L la separación es
+ * exactamente 2^L y la muestra j vale x = j * 2^L, sin errores de redondeo.
+ * Cada tile guarda tileSamples muestras consecutivas de un nivel. Al
+ * desplazar la vista se reutilizan los tiles ya calculados y solo se evalúan
+ * los que aparecen; al ampliar o reducir, un tile nuevo toma las muestras que
+ * comparte con los niveles vecinos (la mitad de ellas, o todas) y evalúa solo
+ * las que faltan.
+ */
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+#include "tabulate.hpp"
+#include "../evaluator/program.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// Muestras por tile.
+constexpr std::size_t tileSamples = 256;
+
+/**
+ * @struct tileCacheStats
+ * @brief Contadores de trabajo ahorrado por la caché.
+ */
+struct tileCacheStats {
+    std::uint64_t tilesReused = 0; ///< Tiles servidos sin evaluar nada
+    std::uint64_t tilesBuilt = 0; ///< Tiles nuevos (completos o a partir de niveles vecinos)
+    std::uint64_t samplesEvaluated = 0; ///< Muestras que hubo que evaluar
+    std::size_t size = 0; ///< Tiles guardados actualmente
+};
+
+/**
+ * @class tileCache
+ * @brief Muestras (x, f(x)) ya calculadas de una expresión, organizadas por tiles.
+ *
+ * No es segura para usarse desde varios hilos a la vez: se espera una por
+ * vista o por expresión graficada.
+ */
+class tileCache {
+public:
+    /**
+     * @brief Crea una caché vacía para el programa.
+     *
+     * @param program Programa compilado; solo puede depender de x. Se guarda una copia.
+     * @param maxTiles Cantidad máxima de tiles guardados (se descartan los menos usados).
+     * @throws std::runtime_error Si el programa usa y o z.
+     */
+    explicit tileCache(const bytecodeProgram& program, std::size_t maxTiles = 1024);
+
+    /**
+     * @brief Muestras para dibujar [start, end] con al menos pixels puntos.
+     *
+     * La separación es la mayor potencia de dos que no supera
+     * (end - start) / pixels. Se incluye una muestra más allá de cada extremo
+     * para que la línea llegue hasta el borde de la vista.
+     *
+     * @param start Inicio de la vista.
+     * @param end Fin de la vista.
+     * @param pixels Ancho de la vista en píxeles.
+     * @return functionTable Muestras ordenadas por x.
+     * @throws std::runtime_error Si la vista está vacía o no es finita, o pixels es 0.
+     */
+    functionTable view(double start, double end, std::size_t pixels);
+
+    /**
+     * @brief Contadores acumulados desde la creación o el último clear().
+     */
+    tileCacheStats stats() const;
+
+    /**
+     * @brief Descarta todos los tiles y reinicia los contadores.
+     */
+    void clear();
+
+private:
+    using tileKey = std::pair<int, std::int64_t>; ///< Nivel e índice del tile
+
+    struct tileKeyHash {
+        std::size_t operator()(const tileKey& key) const {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(key.second) * 0x9E3779B97F4A7C15ull) ^ static_cast<std::uint64_t>(key.first + 2048));
+        }
+    };
+
+    struct tile {
+        tileKey key;
+        std::vector<double> y; ///< f en las tileSamples muestras del tile
+    };
+
+    bytecodeProgram program;
+    std::size_t maxTiles;
+    std::list<tile> recent; ///< Tiles del más al menos usado
+    std::unordered_map<tileKey, std::list<tile>::iterator, tileKeyHash> index;
+    tileCacheStats counters;
+
+    const tile* find(const tileKey& key) const;
+    const std::vector<double>& fetch(const tileKey& key);
+    std::vector<double> build(const tileKey& key);
+};
+
+#endif // TILE_CACHE_HPP